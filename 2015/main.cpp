@@ -34,7 +34,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2015 {
     &day_2015_21, &day_2015_22, &day_2015_23, &day_2015_24, &day_2015_25
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2015() {
+    return to_day_entries(days_2015);
+}
+#else
 int main(int argc, const char * argv[]) {
     run_aoc(days_2015, argc, argv);
     return 0;
 }
+#endif
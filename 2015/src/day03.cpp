@@ -1,7 +1,6 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
-
-#include <set>
+#include "../../util/grid.hpp"
 
 // https://adventofcode.com/2015/day/3
 
@@ -31,17 +30,17 @@ namespace {
 
     template <typename VisitStrategy>
     struct Santa {
-        std::set<bj::Position> m_visited_houses;
+        bj::InfiniteGrid<char> m_visited_houses;
         VisitStrategy m_strategy;
         
-        Santa() { m_visited_houses.insert(*m_strategy); }
+        Santa() { m_visited_houses[*m_strategy] = true; }
 
         void move(const bj::Direction dir) {
             m_strategy.move(dir);
-            m_visited_houses.insert(*m_strategy);
+            m_visited_houses[*m_strategy] = true;
         }
 
-        [[nodiscard]] size_t visited_houses() const noexcept { return m_visited_houses.size(); }
+        [[nodiscard]] size_t visited_houses() const { return m_visited_houses.count(true); }
     };
 }
 
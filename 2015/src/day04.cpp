@@ -1,34 +1,24 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
-#include "../../util/md5.h"
+#include "../../util/nonce_search.hpp"
 
 // https://adventofcode.com/2015/day/4
 
-static long long int find_answer(size_t number_of_zeros, const std::string & input) {
-  const auto is_answer = [&](const std::string & candidate) {
-    for (size_t i = 0; i != number_of_zeros; ++i) {
-      if (candidate[i] != '0') return false;
-    }
-    return true;
-  };
+Output day_2015_04(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
+  // A hash that starts with 6 zeros also starts with 5 zeros, so both parts
+  // are found by the same search
+  long long int part_a = -1;
+  long long int part_b = -1;
 
-  MD5 md5;
-  long long int x = 0;
-
-  while (true) {
-    const auto res = md5(input + std::to_string(x));
-
-    if (is_answer(res)) {
-      return x;
-    }
-
-    ++x;
-  }
-}
-
-Output day_2015_04(const std::vector<std::string> & lines, const DayExtraInfo &) {
-  return Output(
-    find_answer(5, lines[0]),
-    find_answer(6, lines[0])
+  bj::search_nonces(lines[0],
+    [](const bj::md5::Digest & digest) { return bj::md5::has_leading_zero_nibbles(digest, 5); },
+    [&](std::uint64_t nonce, const bj::md5::Digest & digest) {
+      if (part_a == -1) part_a = nonce;
+      if (bj::md5::has_leading_zero_nibbles(digest, 6)) part_b = nonce;
+      return part_b == -1;
+    },
+    bj::NonceSearchOptions{ .threads = dei.threads, .stop_token = dei.stop_token }
   );
+
+  return Output(part_a, part_b);
 }
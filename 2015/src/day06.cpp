@@ -1,10 +1,10 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
+#include "../../util/pattern.hpp"
 
 #include <algorithm>
 #include <array>
 #include <numeric>
-#include <regex>
 
 // https://adventofcode.com/2015/day/6
 
@@ -57,53 +57,39 @@ namespace {
     };
 
     struct InstructionMaker {
-        std::regex pattern { R"(^(turn off|turn on|toggle) ([0-9]+),([0-9]+) through ([0-9]+),([0-9]+)$)" } ;
-        std::smatch matches;
-
-        [[nodiscard]] Instruction operator()(const std::string & line) {
-            std::regex_search(line, matches, pattern);
-
-            InstructionType type;
-            if (matches[1].str() == "turn on") {
-                type = InstructionType::TurnOn;
-            } else if (matches[1].str() == "turn off") {
-                type = InstructionType::TurnOff;
-            } else /* if (matches[1].str() == "toggle") */ {
-                type = InstructionType::Toggle;
-            }
-
-            const int left   = std::stoi(matches[2].str());
-            const int top    = std::stoi(matches[3].str());
-            const int right  = std::stoi(matches[4].str());
-            const int bottom = std::stoi(matches[5].str());
+        // The alternatives are in the order of InstructionType
+        using Pattern = bj::Pattern<"{turn on|turn off|toggle} {digits},{digits} through {digits},{digits}">;
+
+        [[nodiscard]] Instruction operator()(const std::string & line) const {
+            const auto [type, left, top, right, bottom] = Pattern::match(line).value();
 
             return Instruction {
-                type,
+                InstructionType(type),
                 bj::Rectangle(left, top, right, bottom)
             };
         }
     };
 }
 
-Output day_2015_06(const std::vector<std::string> & lines, const DayExtraInfo &) {
+Output day_2015_06(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
     const std::vector<Instruction> instructions =
         lines_transform::map<Instruction>(lines, InstructionMaker{});
 
-    std::vector<int /* bool */> lights;
-    std::vector<Brightness>     bright_lights;
+    dei.start_phase(test::Phase::PartA);
+    std::vector<int /* bool */> lights(1000 * 1000, 0);
 
-    for (size_t i = 0 ; i != 1000 * 1000 ; ++i) {
-        lights.push_back(0);
-        bright_lights.push_back(0);
-    }
-   
     for (const auto & instruction : instructions) {
         instruction.apply(lights);
+    }
+
+    const auto lit = std::reduce(lights.begin(), lights.end());
+
+    dei.start_phase(test::Phase::PartB);
+    std::vector<Brightness> bright_lights(1000 * 1000, 0);
+
+    for (const auto & instruction : instructions) {
         instruction.apply_brightness(bright_lights);
     }
 
-    return Output(
-        std::reduce(lights.begin(), lights.end()),
-        std::reduce(bright_lights.begin(), bright_lights.end())
-    );
+    return Output(lit, std::reduce(bright_lights.begin(), bright_lights.end()));
 }
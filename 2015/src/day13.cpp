@@ -146,11 +146,13 @@ namespace {
     }
 }
 
-Output day_2015_13(const std::vector<std::string> & lines, const DayExtraInfo &) {
+Output day_2015_13(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
     const Relationship relations { lines };
     const GlobalHappinness global { relations };
 
+    dei.start_phase(test::Phase::PartA);
     const auto maximized_happiness = maximize_happiness(global);
+    dei.start_phase(test::Phase::PartB);
     const auto maximized_happiness_with_me = maximize_happiness(global, "A swiss citizen");
 
     return Output(maximized_happiness, maximized_happiness_with_me);
@@ -1,5 +1,5 @@
 #include "../../common/advent_of_code.hpp"
-#include "../../util/regex_helper.hpp"
+#include "../../util/pattern.hpp"
 
 #include <vector>
 
@@ -7,16 +7,16 @@
 
 namespace {
     struct Reindeer {
-        static constexpr const char * Regex_Pattern = R"(^([A-Za-z]*) can fly ([0-9]+) km\/s for ([0-9]+) seconds?, but then must rest for ([0-9]+) seconds?\.$)";
+        static constexpr bj::FixedString Line_Pattern = "{word} can fly {digits} km/s for {digits} {seconds|second}, but then must rest for {digits} {seconds|second}.";
 
         std::string name;
         unsigned long long int flight_speed;
         unsigned long long int flight_time;
         unsigned long long int rest_time;
 
-        Reindeer(const std::vector<std::string> & values)
-        : name(values[0]), flight_speed(std::stoul(values[1])),
-        flight_time(std::stoul(values[2])), rest_time(std::stoul(values[3])) {}
+        Reindeer(std::string_view name, int flight_speed, int flight_time, int /* seconds */, int rest_time, int /* seconds */)
+        : name(name), flight_speed(flight_speed),
+        flight_time(flight_time), rest_time(rest_time) {}
     };
 
     struct Competitor {
@@ -77,7 +77,7 @@ namespace {
 }
 
 Output day_2015_14(const std::vector<std::string> & lines, const DayExtraInfo &) {
-    const std::vector<Reindeer> reindeers = bj::lines_to_class_by_regex<Reindeer>(lines);
+    const std::vector<Reindeer> reindeers = bj::lines_to_class<Reindeer>(lines);
     std::vector<Competitor> competitors;
     for (const auto & reindeer : reindeers) {
         competitors.emplace_back(reindeer);
@@ -1,5 +1,5 @@
 #include "../../common/advent_of_code.hpp"
-#include "../../util/regex_helper.hpp"
+#include "../../util/pattern.hpp"
 
 #include <vector>
 
@@ -15,13 +15,8 @@ namespace {
 
         Property() = default;
 
-        explicit Property(const std::vector<std::string> & values) {
-            capacity   = std::stoi(values[1]);
-            durability = std::stoi(values[2]);
-            flavor     = std::stoi(values[3]);
-            texture    = std::stoi(values[4]);
-            calories   = std::stoi(values[5]);
-        }
+        Property(int capacity, int durability, int flavor, int texture, int calories)
+        : capacity(capacity), durability(durability), flavor(flavor), texture(texture), calories(calories) {}
 
         Property & operator+=(const Property & rhs) {
             capacity   += rhs.capacity;
@@ -78,13 +73,13 @@ namespace {
     };
 
     struct Ingredient {
-        static constexpr const char * Regex_Pattern = R"(^([a-zA-Z]*): capacity (-?[0-9]+), durability (-?[0-9]+), flavor (-?[0-9]+), texture (-?[0-9]+), calories (-?[0-9]+)$)";
+        static constexpr bj::FixedString Line_Pattern = "{word}: capacity {int}, durability {int}, flavor {int}, texture {int}, calories {int}";
 
         std::string name;
         Property properties;
 
-        Ingredient(const std::vector<std::string> & values)
-        : name(values[0]), properties(values) {}
+        Ingredient(std::string_view name, int capacity, int durability, int flavor, int texture, int calories)
+        : name(name), properties(capacity, durability, flavor, texture, calories) {}
     };
 
     template <typename Validation>
@@ -112,7 +107,7 @@ namespace {
 }
 
 Output day_2015_15(const std::vector<std::string> & lines, const DayExtraInfo &) {
-    const std::vector<Ingredient> ingredients = bj::lines_to_class_by_regex<Ingredient>(lines);
+    const std::vector<Ingredient> ingredients = bj::lines_to_class<Ingredient>(lines);
 
     // If we would like to get the exact recipee, we should add another return value which is the (reverse) picked ingredients
     // to the naive_picking function.
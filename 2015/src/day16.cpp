@@ -1,5 +1,5 @@
 #include "../../common/advent_of_code.hpp"
-#include "../../util/regex_helper.hpp"
+#include "../../util/pattern.hpp"
 
 #include <map>
 
@@ -7,16 +7,19 @@
 
 namespace {
     struct Sue {
-        static constexpr const char * Regex_Pattern = R"(^Sue ([0-9]+): ([a-z]*): ([0-9]+), ([a-z]*): ([0-9]+), ([a-z]*): ([0-9]+)$)";
+        static constexpr bj::FixedString Line_Pattern = "Sue {digits}: {word}: {digits}, {word}: {digits}, {word}: {digits}";
 
         int number;
         std::map<std::string, int> properties;
 
-        explicit Sue(const std::vector<std::string> & values) {
-            number = std::stoi(values[0]);
-            properties[values[1]] = std::stoi(values[2]);
-            properties[values[3]] = std::stoi(values[4]);
-            properties[values[5]] = std::stoi(values[6]);
+        Sue(int number,
+            std::string_view name_1, int value_1,
+            std::string_view name_2, int value_2,
+            std::string_view name_3, int value_3
+        ) : number(number) {
+            properties[std::string(name_1)] = value_1;
+            properties[std::string(name_2)] = value_2;
+            properties[std::string(name_3)] = value_3;
         }
     };
 
@@ -80,7 +83,7 @@ namespace {
 }
 
 Output day_2015_16(const std::vector<std::string> & lines, const DayExtraInfo &) {
-    const std::vector<Sue> sues = bj::lines_to_class_by_regex<Sue>(lines);
+    const std::vector<Sue> sues = bj::lines_to_class<Sue>(lines);
     const Required req;
 
     return Output(req.search(sues)->number, req.search(sues, Required::SearchKind::WithOperator)->number);
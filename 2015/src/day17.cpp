@@ -1,5 +1,4 @@
 #include "../../common/advent_of_code.hpp"
-#include "../../util/regex_helper.hpp"
 
 #include <map>
 
@@ -1,7 +1,7 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
 #include "../../util/game_of_life.hpp"
-#include <map>
+#include <set>
 
 // https://adventofcode.com/2015/day/18
 
@@ -10,6 +10,10 @@ namespace {
         using Element = bj::Position;
         int grid_size;
 
+        static constexpr std::uint64_t birth = bj::neighbour_counts({ 3 });
+        static constexpr std::uint64_t survival = bj::neighbour_counts({ 2, 3 });
+        static constexpr auto neighbourhood = bj::moore_neighbourhood<2>();
+
         [[nodiscard]] static auto get_neighbours(const Element & element) {
             return element.get_8_neighbours();
         }
@@ -32,6 +36,10 @@ namespace {
         using Element = bj::Position;
         int grid_size;
 
+        static constexpr std::uint64_t birth = bj::neighbour_counts({ 3 });
+        static constexpr std::uint64_t survival = bj::neighbour_counts({ 2, 3 });
+        static constexpr auto neighbourhood = bj::moore_neighbourhood<2>();
+
         [[nodiscard]] static auto get_neighbours(const Element & element) {
             return element.get_8_neighbours();
         }
@@ -42,7 +50,7 @@ namespace {
         }
 
         [[nodiscard]] bool is_on(const bj::Position & position, const bool was_on, const size_t c) const noexcept {
-            if (is_coin(position)) return true;
+            if (is_always_on(position)) return true;
 
             if (was_on) {
                 return c == 2 || c == 3;
@@ -51,7 +59,8 @@ namespace {
             }
         }
 
-        [[nodiscard]] bool is_coin(const bj::Position & position) const noexcept {
+        /** The corners are stuck on */
+        [[nodiscard]] bool is_always_on(const bj::Position & position) const noexcept {
             const bool coin_x = position.x == 0 || position.x == grid_size - 1;
             const bool coin_y = position.y == 0 || position.y == grid_size - 1;
             return coin_x && coin_y;
@@ -3,7 +3,7 @@
 #include <optional>
 #include <cstring>
 #include <array>
-#include "../../util/regex_helper.hpp"
+#include "../../util/instruction_reader.hpp"
 
 // https://adventofcode.com/2015/day/23
 
@@ -47,37 +47,40 @@ namespace {
         jio
     };
 
-    /** Instructions. Regex black magic ensures register name and offset go at the right place */
+    /** Instructions */
     struct Instruction {
-        // Regex
-        static constexpr const char * Regex_Pattern = R"(^([a-z]*) (a|b)?,? *((\+|-)[0-9]*)?$)";
-
         // Fields (3-address style assembly)
         Type type_;
         int32_t register_;
         int32_t offset_;
 
         // Constructing an instruction
-        explicit Instruction(const std::vector<std::string> & values);
+        Instruction(Type type_, int32_t register_, int32_t offset_)
+        : type_(type_), register_(register_), offset_(offset_) {}
+
+        static std::vector<Instruction> read(std::span<const std::string> lines);
 
         // Running an instruction
         void apply(Computer & computer) const;
     };
     
-    Instruction::Instruction(const std::vector<std::string> & values) {
-        if (values[0] == "hlf") type_ = Type::hlf;
-        else if (values[0] == "tpl") type_ = Type::tpl;
-        else if (values[0] == "inc") type_ = Type::inc;
-        else if (values[0] == "jmp") type_ = Type::jmp;
-        else if (values[0] == "jie") type_ = Type::jie;
-        else if (values[0] == "jio") type_ = Type::jio;
-        else std::cerr << "D2015-23: unknown type " << values[0] << "\n";
-
-        if (values[1] == "") register_ = 0;
-        else register_ = values[1][0] - 'a';
-        
-        if (values[2] == "") offset_ = 0;
-        else offset_ = std::stoi(values[2]);
+    std::vector<Instruction> Instruction::read(std::span<const std::string> lines) {
+        // The alternatives are in the order of Type
+        bj::InstructionReader<Instruction> reader;
+
+        reader.add_handler<"{hlf|tpl|inc} {a|b}">(
+            [](int type, int register_) { return Instruction(Type(type), register_, 0); }
+        );
+
+        reader.add_handler<"jmp {int}">(
+            [](int offset) { return Instruction(Type::jmp, 0, offset); }
+        );
+
+        reader.add_handler<"{jie|jio} {a|b}, {int}">(
+            [](int type, int register_, int offset) { return Instruction(Type(int(Type::jie) + type), register_, offset); }
+        );
+
+        return reader(lines).value();
     }
 
     void Instruction::apply(Computer & computer) const {
@@ -125,7 +128,7 @@ namespace {
 }
 
 Output day_2015_23(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
-    const std::vector<Instruction> instructions = bj::lines_to_class_by_regex<Instruction>(lines);
+    const std::vector<Instruction> instructions = Instruction::read(lines);
 
     // Part A : just run the code
     Computer part_a;
@@ -4,7 +4,6 @@
 #include <optional>
 #include <cstring>
 #include <array>
-#include "../../util/regex_helper.hpp"
 
 // https://adventofcode.com/2015/day/25
 
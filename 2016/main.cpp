@@ -7,7 +7,7 @@ Output day_2016_03(const std::vector<std::string> & lines, const DayExtraInfo &)
 Output day_2016_04(const std::vector<std::string> & lines, const DayExtraInfo &);
 Output day_2016_05(const std::vector<std::string> & lines, const DayExtraInfo &);
 Output day_2016_06(const std::vector<std::string> & lines, const DayExtraInfo &);
-Output day_2016_07(const std::vector<std::string> & lines, const DayExtraInfo &);
+Output day_2016_07(std::span<const std::string_view> lines, const DayExtraInfo &);
 Output day_2016_08(const std::vector<std::string> & lines, const DayExtraInfo &);
 Output day_2016_09(const std::vector<std::string> & lines, const DayExtraInfo &);
 Output day_2016_10(const std::vector<std::string> & lines, const DayExtraInfo &);
@@ -27,7 +27,7 @@ Output day_2016_23(const std::vector<std::string> & lines, const DayExtraInfo &)
 Output day_2016_24(const std::vector<std::string> & lines, const DayExtraInfo &);
 Output day_2016_25(const std::vector<std::string> & lines, const DayExtraInfo &);
 
-static constexpr std::array<DayEntryPoint *, 25> days_2016 {
+static constexpr std::array<DayEntry, 25> days_2016 {
     &day_2016_01, &day_2016_02, &day_2016_03, &day_2016_04, &day_2016_05,
     &day_2016_06, &day_2016_07, &day_2016_08, &day_2016_09, &day_2016_10,
     &day_2016_11, &day_2016_12, &day_2016_13, &day_2016_14, &day_2016_15,
@@ -35,7 +35,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2016 {
     &day_2016_21, &day_2016_22, &day_2016_23, &day_2016_24, &day_2016_25
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2016() {
+    return to_day_entries(days_2016);
+}
+#else
 int main(int argc, const char * argv[]) {
     run_aoc(days_2016, argc, argv);
     return 0;
 }
+#endif
@@ -1,5 +1,5 @@
 #include "../../common/advent_of_code.hpp"
-#include "../../util/regex_helper.hpp"
+#include "../../util/pattern.hpp"
 
 // https://adventofcode.com/2016/day/4
 
@@ -12,13 +12,11 @@
 
 namespace {
     struct Room {
-        static constexpr const char * Regex_Pattern = R"(^([a-z\-]*)-([0-9]*)\[([a-z]*)\]$)";
+        // The name is made of words separated by -, so it is not a {word}
+        static constexpr bj::FixedString Line_Pattern = "{str}-{digits}[{word}]";
         
-        explicit Room(const std::vector<std::string> & values) {
-            name = values[0];
-            sector_id = std::stoi(values[1]);
-            checksum = values[2];
-        }
+        Room(std::string_view name, int sector_id, std::string_view checksum)
+        : name(name), sector_id(sector_id), checksum(checksum) {}
 
         std::string name;
         int32_t sector_id;
@@ -65,7 +63,7 @@ namespace {
 }
 
 Output day_2016_04(const std::vector<std::string> & lines, const DayExtraInfo &) {
-    const std::vector<Room> rooms = bj::lines_to_class_by_regex<Room>(lines);
+    const std::vector<Room> rooms = bj::lines_to_class<Room>(lines);
 
     int32_t sum_of_sectors = 0;
     int32_t sector_of_polaris = 0;
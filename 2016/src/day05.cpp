@@ -1,43 +1,30 @@
 #include "../../common/advent_of_code.hpp"
-#include "../../util/md5.h"
+#include "../../util/nonce_search.hpp"
 
 // https://adventofcode.com/2016/day/5
 
-static bool leads_with_zeros(const std::string & s) {
-  for (size_t i = 0; i != 5; ++i) {
-    if (s[i] != '0') return false;
-  }
+Output day_2016_05(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
+  static constexpr const char * hex = "0123456789abcdef";
 
-  return true;
-}
-
-Output day_2016_05(const std::vector<std::string> & lines, const DayExtraInfo &) {
-  MD5 md5;
   std::string part_a = "";
   std::string part_b = "$$$$$$$$";
 
-  for (long long int i = 0; true; ++i) {
-    const std::string content = lines[0] + std::to_string(i);
-    const auto hash = md5(content);
-
-    if (!leads_with_zeros(hash)) {
-      continue;
-    }
+  // The hits are given in the order of the nonces, as the password depends on it
+  bj::search_nonces(lines[0],
+    [](const bj::md5::Digest & hash) { return bj::md5::has_leading_zero_nibbles(hash, 5); },
+    [&](std::uint64_t, const bj::md5::Digest & hash) {
+      const auto sixth = bj::md5::nibble(hash, 5);
 
-    const auto sixth = hash[5];
+      if (part_a.size() < 8) part_a += hex[sixth];
 
-    if (part_a.size() < 8) part_a += sixth;
-
-    if (sixth >= '0' && sixth <= '7') {
-      const auto pos = sixth - '0';
+      if (sixth <= 7 && part_b[sixth] == '$') {
+        part_b[sixth] = hex[bj::md5::nibble(hash, 6)];
+      }
 
-      if (part_b[pos] == '$') {
-        part_b[pos] = hash[6];
+      return std::find(part_b.begin(), part_b.end(), '$') != part_b.end();
+    },
+    bj::NonceSearchOptions{ .threads = dei.threads, .stop_token = dei.stop_token }
+  );
 
-        if (std::find(part_b.begin(), part_b.end(), '$') == part_b.end()) {
-          return Output(part_a, part_b);
-        }
-      }
-    }
-  }
+  return Output(part_a, part_b);
 }
@@ -24,7 +24,7 @@ namespace {
 
     using IPv7 = std::vector<std::pair<std::string, Position>>;
 
-    IPv7 into_sequences(const std::string & ip) {
+    IPv7 into_sequences(std::string_view ip) {
         std::vector<std::pair<std::string, Position>> r;
 
         Position p = Position::Outside;
@@ -128,7 +128,7 @@ namespace {
     }
 }
 
-Output day_2016_07(const std::vector<std::string> & lines, const DayExtraInfo &) {
+Output day_2016_07(std::span<const std::string_view> lines, const DayExtraInfo &) {
     std::vector<IPv7> ipv7s;
 
     std::transform(
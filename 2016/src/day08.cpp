@@ -1,7 +1,6 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/instruction_reader.hpp"
 #include <algorithm>
-#include <regex>
 #include <array>
 #include <variant>
 
@@ -109,19 +108,16 @@ Output day_2016_08(const std::vector<std::string> & lines, const DayExtraInfo &)
     // Convert input
     bj::InstructionReader<Instruction> converter;
 
-    converter.add_handler(
-        R"(^rect ([0-9]*)x([0-9]*)$)",
-        [](const std::vector<std::string> & values) -> Instruction { return DrawRect(std::stoi(values[0]), std::stoi(values[1])); }
+    converter.add_handler<"rect {digits}x{digits}">(
+        [](int width, int height) -> Instruction { return DrawRect(width, height); }
     );
 
-    converter.add_handler(
-        R"(^rotate row y=([0-9]*) by ([0-9]*)$)",
-        [](const std::vector<std::string> & values) -> Instruction { return RotateRow(std::stoi(values[0]), std::stoi(values[1])); }
+    converter.add_handler<"rotate row y={digits} by {digits}">(
+        [](int row, int shift) -> Instruction { return RotateRow(row, shift); }
     );
 
-    converter.add_handler(
-        R"(^rotate column x=([0-9]*) by ([0-9]*)$)",
-        [](const std::vector<std::string> & values) -> Instruction { return RotateColumn(std::stoi(values[0]), std::stoi(values[1])); }
+    converter.add_handler<"rotate column x={digits} by {digits}">(
+        [](int column, int shift) -> Instruction { return RotateColumn(column, shift); }
     );
 
     const auto result = converter(lines);
@@ -270,8 +270,6 @@ namespace {
         }
     };
 
-}
-
 [[maybe_unused]] std::ostream & operator<<(std::ostream & stream, const std::vector<std::vector<Element>> & elementss) {
     for (const auto & elements : elementss) {
         for (const auto & element : elements) {
@@ -284,6 +282,8 @@ namespace {
     return stream;
 }
 
+}
+
 static std::vector<std::vector<Element>> read_input(const std::vector<std::string> & lines, Factory & factory) {
     std::vector<std::vector<Element>> floors;
 
@@ -343,7 +343,7 @@ static std::vector<std::vector<Element>> read_input(const std::vector<std::strin
     return floors;
 }
 
-static size_t solve(std::vector<std::vector<Element>> floors) {
+static size_t solve(std::vector<std::vector<Element>> floors, const DayExtraInfo & dei) {
     State state = State(floors);
 
     std::map<uint64_t, std::pair<State, size_t>> exploredStates;
@@ -367,6 +367,8 @@ static size_t solve(std::vector<std::vector<Element>> floors) {
     size_t max_seen_rank = 0;
 
     while (!todo.empty()) {
+        if (dei.stop_requested()) return 0;
+
         const auto [state_, rank] = todo.front();
         todo.pop();
 
@@ -401,18 +403,18 @@ static size_t solve(std::vector<std::vector<Element>> floors) {
     return none;
 }
 
-Output day_2016_11(const std::vector<std::string> & lines, const DayExtraInfo &) {
+Output day_2016_11(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
     Factory factory;
     std::vector<std::vector<Element>> floors = read_input(lines, factory);
 
-    const size_t result_a = solve(floors);
+    const size_t result_a = solve(floors, dei);
 
     floors[0].push_back(factory.build("elerium"  , Kind::Generator ));
     floors[0].push_back(factory.build("elerium"  , Kind::Microchip ));
     floors[0].push_back(factory.build("dilithium", Kind::Generator ));
     floors[0].push_back(factory.build("dilithium", Kind::Microchip ));
     
-    const size_t result_b = solve(floors);
+    const size_t result_b = solve(floors, dei);
 
     return Output(
         result_a, result_b
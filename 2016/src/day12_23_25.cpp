@@ -9,6 +9,8 @@
 
 // https://adventofcode.com/2016/day/12
 
+namespace {
+
 enum class InstructionType {
   cpy, inc, jnz, dec, tgl, out
 };
@@ -152,6 +154,8 @@ std::vector<Instruction> read_instructions(const std::vector<std::string> & line
   return instructions;
 }
 
+}
+
 Output day_2016_12(const std::vector<std::string> & lines, const DayExtraInfo &) {
   const auto instructions = read_instructions(lines);
 
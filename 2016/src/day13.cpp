@@ -1,18 +1,13 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/instruction_reader.hpp"
 #include "../../util/position.hpp"
+#include "../../util/graph_search.hpp"
 #include <cstring>
 #include <algorithm>
 #include <optional>
 #include <array>
-#include <set>
-#include <map>
-#include <queue>
 
-struct Pos {
-  bj::Position point;
-  int length;
-};
+namespace {
 
 static bool can_walk_on(bj::Position point, int designer_number) {
   if (point.x < 0) return false;
@@ -36,33 +31,61 @@ static bool can_walk_on(bj::Position point, int designer_number) {
   return (number_of_1 % 2) == 0;
 }
 
-enum class PointValidity { IsAnswer, DoNotExploreNeighbour, Normal };
-
-template <typename Predicate>
-static inline size_t goToPosition(int designer_number, Predicate predicate) {
-  std::set<bj::Position> already_visited;
-  std::queue<Pos> positions;
-
-  positions.push(Pos{ bj::Position{1, 1}, 0 });
-
-  while (!positions.empty()) {
-    const auto pos = positions.front();
-    positions.pop();
+template <typename IsTarget>
+static bj::graph::SearchResult<bj::graph::GridSpace> go_to_position(
+  int designer_number, const bj::graph::GridSpace & space, IsTarget is_target, bj::graph::SearchOptions<int> options = {}
+) {
+  return bj::graph::bfs(
+    space, bj::Position{ 1, 1 },
+    [&](const bj::Position & position, auto emit) {
+      position.for_each_neighbour([&](const bj::Position & p) {
+        if (space.contains(p) && can_walk_on(p, designer_number)) emit(p);
+      });
+    },
+    is_target, options
+  );
+}
 
-    const auto x = predicate(pos);
-    if (x == PointValidity::IsAnswer) return pos.length;
-    if (x == PointValidity::DoNotExploreNeighbour) continue;    
+}
 
-    pos.point.for_each_neighbour([&](const bj::Position & p) {
-      if (!can_walk_on(p, designer_number)) return;
-      if (already_visited.find(p) != already_visited.end()) return;
+// A path of length d from (1, 1) stays in the square of the points whose
+// coordinates are at most 1 + d
+static bj::graph::GridSpace square_of_paths_of_length(int d) {
+  return bj::graph::GridSpace{ d + 2, d + 2 };
+}
 
-      positions.emplace(Pos{ p, pos.length + 1 });
-      already_visited.emplace(p);
-    });
+static bool touches_far_sides(const bj::graph::Distances<bj::graph::GridSpace, int> & distances) {
+  const bj::graph::GridSpace & space = distances.space();
+  for (int x = 0; x != space.width; ++x) {
+    if (distances.reached(bj::Position{ x, space.height - 1 })) return true;
+  }
+  for (int y = 0; y != space.height; ++y) {
+    if (distances.reached(bj::Position{ space.width - 1, y })) return true;
   }
+  return false;
+}
 
-  return already_visited.size();
+// The maze is infinite: the search is done in a square that is enlarged
+// until it contains every path shorter than the one found
+static int shortest_distance(int designer_number, bj::Position target) {
+  bj::graph::GridSpace space = square_of_paths_of_length(std::max(target.x, target.y));
+
+  while (true) {
+    const auto result = go_to_position(
+      designer_number, space,
+      [&](const bj::Position & position) { return position == target; }
+    );
+
+    if (const std::optional<int> distance = result.target_distance()) {
+      const bj::graph::GridSpace exact_space = square_of_paths_of_length(*distance);
+      if (exact_space.width <= space.width) return *distance;
+      space = exact_space;
+    } else if (touches_far_sides(result.distances)) {
+      space = bj::graph::GridSpace{ space.width * 2, space.height * 2 };
+    } else {
+      throw std::invalid_argument("The target can not be reached");
+    }
+  }
 }
 
 Output day_2016_13(const std::vector<std::string> & lines, const DayExtraInfo & extra) {
@@ -72,16 +95,13 @@ Output day_2016_13(const std::vector<std::string> & lines, const DayExtraInfo &
 
   bj::Position target { target_x, target_y };
 
-  const auto length = goToPosition(
-    designer_number,
-    [&](const Pos & pos) { return pos.point == target ? PointValidity::IsAnswer : PointValidity::Normal; }
-  );
+  const int length = shortest_distance(designer_number, target);
 
-  const auto reachable = extra.can_skip_part_B ? 0 :
-    goToPosition(
-      designer_number,
-      [&](const Pos & pos) { return pos.length > 49 ? PointValidity::DoNotExploreNeighbour : PointValidity::Normal; }
-    )
+  const size_t reachable = extra.can_skip_part_B ? 0 :
+    go_to_position(
+      designer_number, square_of_paths_of_length(50),
+      bj::graph::NoTarget{}, bj::graph::SearchOptions<int>{ .max_distance = 50 }
+    ).distances.count_reached()
   ;
 
   return Output(length, reachable);
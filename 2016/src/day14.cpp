@@ -1,136 +1,195 @@
 #include "../../common/advent_of_code.hpp"
-#include "../../util/instruction_reader.hpp"
-#include "../../util/position.hpp"
-#include <cstring>
+#include "../../util/md5_batch.hpp"
 #include <algorithm>
-#include <optional>
 #include <array>
-#include <set>
-#include <map>
-#include <queue>
-#include "../../util/md5.h"
-
-struct HashDescription {
-  size_t key;
-  char three_letters;
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+// https://adventofcode.com/2016/day/14
+
+namespace {
+
+/** The part of a hash that matters: the character of its first triple and the characters of its quintuples */
+struct Runs {
+  int triple = -1;
+  std::uint16_t quintuples = 0;
 };
 
-struct KeyFinder {
-  std::string salt;
-  size_t number_of_hashes = 1;
-  size_t next_index_to_explore = 0;
-  std::vector<size_t> validated;
-  MD5 md5;
+Runs find_runs(const bj::md5::Digest & hash) {
+  Runs runs;
+  std::uint8_t last = 0xFF;
+  int length = 0;
 
-  KeyFinder(std::string salt, size_t number_of_hashes)
-    : salt(salt), number_of_hashes(number_of_hashes) {
+  for (size_t i = 0; i != 32; ++i) {
+    const std::uint8_t c = bj::md5::nibble(hash, i);
 
+    if (c == last) {
+      ++length;
+    } else {
+      last = c;
+      length = 1;
     }
 
-  std::map<char, std::set<size_t>> candidates;
+    if (length == 3 && runs.triple == -1) runs.triple = c;
+    if (length == 5) runs.quintuples |= 1 << c;
+  }
 
-  void next();
-  bool has_all_until(size_t size);
-  void remove_candidates(size_t size);
-  void validate_candidates(char c);
-};
+  return runs;
+}
 
-bool KeyFinder::has_all_until(size_t size) {
-  if (validated.size() < size) return false;
-  if (size == 0) return true;
+/**
+ * Threads that stay alive from one block of hashes to the next. Each block
+ * is split in one part per thread, the calling thread doing the first one.
+ */
+class BlockWorkers {
+  std::function<void(size_t)> task;
+  std::mutex mutex;
+  std::condition_variable_any changed;
+  size_t generation = 0;
+  size_t remaining = 0;
+  // Last, so they are stopped and joined before the rest is destroyed
+  std::vector<std::jthread> workers;
+
+public:
+  explicit BlockWorkers(unsigned int threads) {
+    for (size_t part = 1; part < threads; ++part) {
+      workers.emplace_back([this, part](std::stop_token stop) { work(stop, part); });
+    }
+  }
 
-  std::sort(validated.begin(), validated.end());
-  const size_t s = validated[size - 1];
+  [[nodiscard]] size_t parts() const noexcept { return workers.size() + 1; }
 
-  for (const auto & [_, candidatess] : candidates) {
-    for (const auto candidate : candidatess) {
-      if (candidate < s + 1000) {
-        return false;
-      }
+  /** Calls task(part) for every part, and returns when they are all done */
+  void run(std::function<void(size_t)> new_task) {
+    {
+      std::lock_guard lock(mutex);
+      task = std::move(new_task);
+      remaining = workers.size();
+      ++generation;
     }
-  }
+    changed.notify_all();
 
-  return true;
-}
+    task(0);
 
-void KeyFinder::validate_candidates(char c) {
-  auto it = candidates.find(c);
-  if (it == candidates.end()) return;
+    std::unique_lock lock(mutex);
+    changed.wait(lock, [&]() { return remaining == 0; });
+  }
 
-  validated.insert(validated.begin(), it->second.begin(), it->second.end());
+private:
+  void work(std::stop_token stop, size_t part) {
+    size_t done_generation = 0;
 
-  candidates.erase(it);
-}
+    std::unique_lock lock(mutex);
+    while (changed.wait(lock, stop, [&]() { return generation != done_generation; })) {
+      done_generation = generation;
 
-void KeyFinder::remove_candidates(size_t size) {
-  auto it = candidates.begin();
-  while (it != candidates.end()) {
-    it->second.erase(size);
+      lock.unlock();
+      task(part);
+      lock.lock();
 
-    if (it->second.empty()) {
-      it = candidates.erase(it);
-    } else {
-      ++it;
+      if (--remaining == 0) changed.notify_all();
     }
   }
-}
-
+};
 
-void KeyFinder::next() {
-  const std::string base = salt + std::to_string(next_index_to_explore);
-  std::string hash = base;
+/**
+ * The runs of the (stretched) hashes of salt + index, in a ring buffer.
+ * The hashes are computed by blocks, spread over the threads, ahead of the
+ * indexes that are read.
+ */
+class HashWindow {
+  static constexpr size_t block_size = 1024;
+  static constexpr size_t capacity = 4096;
 
-  for (size_t i = 0; i != number_of_hashes; ++i) {
-    std::string s = std::move(hash);
-    hash = md5(s);
+  std::string salt;
+  size_t stretches;
+  std::vector<Runs> ring = std::vector<Runs>(capacity);
+  size_t computed = 0;
+  BlockWorkers workers;
+
+public:
+  HashWindow(std::string salt, size_t stretches, unsigned int threads)
+  : salt(std::move(salt)), stretches(stretches), workers(threads) {}
+
+  /** The runs of the hash of `index`, that must not be 3000 below the greatest read index */
+  [[nodiscard]] Runs operator[](size_t index) {
+    while (index >= computed) compute_block();
+    return ring[index % capacity];
   }
 
-  size_t c = 0;
-  char last = hash[0] == 'a' ? 'b' : 'a';
-  bool ok_3 = false;
-  char to_validate;
+private:
+  void compute_block() {
+    const size_t first = computed;
+    const size_t lanes = bj::md5::lanes();
+    const size_t per_part = (block_size / workers.parts() + lanes - 1) / lanes * lanes;
 
-  for (const char chr : hash) {
-    if (last == chr) {
-      ++c;
+    workers.run([&](size_t part) {
+      const size_t from = first + part * per_part;
+      const size_t to = std::min(from + per_part, first + block_size);
+      if (from >= to) return;
 
-      if (c == 3 && !ok_3) {
-        ok_3 = true;
-        to_validate = last;
-      } else if (c == 5) {
-        validate_candidates(last);
+      std::vector<std::string> messages;
+      for (size_t index = from; index < to; ++index) {
+        messages.emplace_back(salt + std::to_string(index));
       }
-    } else {
-      c = 1;
-      last = chr;
-    }
-  }
-  if (ok_3) {
-    
-    candidates[to_validate].emplace(next_index_to_explore);
-  }
+      const std::vector<std::string_view> views(messages.begin(), messages.end());
 
-  if (next_index_to_explore >= 1000) {
-    remove_candidates(next_index_to_explore - 1000);
-  }
+      std::vector<bj::md5::Digest> digests(views.size());
+      bj::md5::stretched_digest_batch(views, stretches, digests.data());
 
-  ++next_index_to_explore;
-}
+      for (size_t index = from; index < to; ++index) {
+        ring[index % capacity] = find_runs(digests[index - from]);
+      }
+    });
 
+    computed += block_size;
+  }
+};
 
-Output day_2016_14(const std::vector<std::string> & lines, const DayExtraInfo &) {
-  KeyFinder kf(lines[0], 1);
+/**
+ * The index that produces the 64th key: an index whose hash has a triple is
+ * a key if one of the 1000 next hashes has a quintuple of the same character.
+ */
+long long int find_64th_key(const std::string & salt, size_t stretches, const DayExtraInfo & dei) {
+  HashWindow hashes(salt, stretches, dei.threads);
+
+  // Number of quintuples of each character in the hashes index + 1 .. index + 1000
+  std::array<int, 16> quintuples {};
+  const auto add = [&](Runs runs, int delta) {
+    for (size_t c = 0; c != 16; ++c) {
+      if (runs.quintuples & (1 << c)) quintuples[c] += delta;
+    }
+  };
 
-  while (!kf.has_all_until(64)) {
-    kf.next();
+  for (size_t index = 1; index <= 1000; ++index) {
+    add(hashes[index], 1);
   }
 
-  
-  KeyFinder kf2(lines[0], 2016 + 1);
+  size_t keys = 0;
+  for (size_t index = 0; true; ++index) {
+    const Runs runs = hashes[index];
+    if (runs.triple != -1 && quintuples[runs.triple] != 0) {
+      ++keys;
+      if (keys == 64) return index;
+    }
+
+    add(hashes[index + 1], -1);
+    add(hashes[index + 1001], 1);
 
-  while (!kf2.has_all_until(64)) {
-    kf2.next();
+    if (index % 1024 == 0 && dei.stop_requested()) return -1;
   }
+}
+
+}
 
-  return Output(kf.validated[64-1], kf2.validated[64-1]);
+Output day_2016_14(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
+  dei.start_phase(test::Phase::PartA);
+  const long long int part_a = find_64th_key(lines[0], 0, dei);
+  dei.start_phase(test::Phase::PartB);
+  const long long int part_b = find_64th_key(lines[0], 2016, dei);
+  return Output(part_a, part_b);
 }
@@ -9,6 +9,8 @@
 #include <map>
 #include <queue>
 
+namespace {
+
 struct Dragon {
   std::vector<bool> m_data;
 
@@ -69,6 +71,8 @@ struct Dragon {
   }
 };
 
+}
+
 Output day_2016_16(const std::vector<std::string> & lines, const DayExtraInfo &) {
   const auto space = lines[0].find(' ');
   Dragon dragon(lines[0].substr(0, space));
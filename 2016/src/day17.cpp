@@ -1,12 +1,15 @@
 #include "../../common/advent_of_code.hpp"
-#include "../../util/md5.h"
+#include "../../util/md5_batch.hpp"
 #include <optional>
 #include <array>
 #include <queue>
 
 
-static bool is_open(char c) {
-  return (c >= 'b' && c <= 'f') || (c >= 'B' && c <= 'F');
+namespace {
+
+/** A door is open if its hex character is between b and f */
+static bool is_open(const bj::md5::Digest & hash, size_t door) {
+  return bj::md5::nibble(hash, door) >= 0xB;
 }
 
 struct GridPosition {
@@ -25,17 +28,17 @@ struct GridPosition {
     if (direction == 'R') ++x;
   }
 
-  std::array<std::optional<GridPosition>, 4> get_next(const std::string & hash) const {
+  std::array<std::optional<GridPosition>, 4> get_next(const bj::md5::Digest & hash) const {
     // Not vector to an allocation (even though we use std::string)
     // std::vector               -> 95ms on examples / 46 ms on real input
     // std::array<std::optional> -> 99ms on examples / 32 ms on real input
     std::array<std::optional<GridPosition>, 4> result;
     result.fill(std::nullopt);
 
-    if (y != 0 && is_open(hash[0])) result[0] = GridPosition(*this, 'U');
-    if (y != 3 && is_open(hash[1])) result[1] = GridPosition(*this, 'D');
-    if (x != 0 && is_open(hash[2])) result[2] = GridPosition(*this, 'L');
-    if (x != 3 && is_open(hash[3])) result[3] = GridPosition(*this, 'R');
+    if (y != 0 && is_open(hash, 0)) result[0] = GridPosition(*this, 'U');
+    if (y != 3 && is_open(hash, 1)) result[1] = GridPosition(*this, 'D');
+    if (x != 0 && is_open(hash, 2)) result[2] = GridPosition(*this, 'L');
+    if (x != 3 && is_open(hash, 3)) result[3] = GridPosition(*this, 'R');
 
     return result;
   }
@@ -45,9 +48,9 @@ struct GridPosition {
   }
 };
 
-static std::pair<std::string, long long int> find_part_a(const std::string & input) {
-  MD5 md5;
+}
 
+static std::pair<std::string, long long int> find_part_a(const std::string & input) {
   std::queue<GridPosition> next_paths;
   next_paths.push(GridPosition());
 
@@ -58,7 +61,7 @@ static std::pair<std::string, long long int> find_part_a(const std::string & inp
     const auto current = next_paths.front();
     next_paths.pop();
 
-    for (const auto & next : current.get_next(md5(input + current.path))) {
+    for (const auto & next : current.get_next(bj::md5::digest(input + current.path))) {
       if (!next) continue;
 
       if (next->is_end()) {
@@ -1,6 +1,8 @@
 #include "../../common/advent_of_code.hpp"
 #include <algorithm>
 
+namespace {
+
 static char get_symbol(bool left_trap, bool mid_trap, bool right_trap) {
   if ((left_trap && mid_trap && !right_trap)
     || (!left_trap && mid_trap && right_trap)
@@ -46,6 +48,8 @@ void transform(std::string & dest, const std::string & src) {
   }
 }
 
+}
+
 
 Output day_2016_18(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   std::vector<std::string> grid;
@@ -1,6 +1,6 @@
 #include "../../common/advent_of_code.hpp"
-#include <map>
-#include <exception>
+#include "../../util/interval_set.hpp"
+#include <vector>
 
 // https://adventofcode.com/2016/day/20#part2
 // List of blocked values
@@ -8,60 +8,31 @@
 // (B) Count the number of allowed
 
 Output day_2016_20(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
-  std::map<std::uint32_t, std::uint32_t> intervals;
+  // 64 bits integers, as the end of the last interval is 2^32
+  using Interval = bj::Interval<std::uint64_t>;
+
+  std::vector<Interval> intervals;
 
   for (const std::string & line : lines) {
     const auto separator = line.find('-');
 
-    const std::uint32_t left  = std::stoul(line.substr(0, separator));
-    const std::uint32_t right = std::stoul(line.substr(separator + 1));
-
-    const bool b = intervals.try_emplace(left, right).second;
-    if (!b) {
-      throw std::runtime_error("multiple intervals start with a value");
-    }
-  }
+    const std::uint64_t left  = std::stoul(line.substr(0, separator));
+    const std::uint64_t right = std::stoul(line.substr(separator + 1));
 
-  // Part A
-  std::uint32_t lowest_value = 0;
-  for (const auto & [min, max] : intervals) {
-    if (min > lowest_value) break;
-    lowest_value = std::max(max + 1, lowest_value);
+    intervals.emplace_back(Interval::closed(left, right));
   }
 
-  // Part B
-  std::uint32_t amount_of_allowed = 0;
-  
-  {
-    std::uint32_t exit_at = dei.part_b_extra_param != 0 ? dei.part_b_extra_param : 0xFFFFFFFF;
-    std::uint32_t maybe_next = 0;
-
-    bool finished = false;
+  const std::uint64_t exit_at = dei.part_b_extra_param != 0 ? dei.part_b_extra_param : 0xFFFFFFFF;
 
-    for (const auto & [min, max] : intervals) {
-      if (maybe_next < min) {
-        amount_of_allowed += (min - maybe_next);
-        maybe_next = min;
-      }
+  const bj::IntervalSet<std::uint64_t> allowed
+    = bj::IntervalSet<std::uint64_t>{ Interval::closed(0, exit_at) }
+    - bj::IntervalSet<std::uint64_t>(std::move(intervals));
 
-      if (max == exit_at) {
-        finished = true;
-        break;
-      }
-
-      maybe_next = std::max(max + 1, maybe_next);
-    }
-
-    if (!finished) {
-      // Julian 🦆 — Aujourd’hui à 11:03
-      // réalisation du jour :
-      // on ne peut pas compter le nombre de uint32 que l'on peut stocker dans un uint32 dans un uint32
-      // vu qu'il y a 2^32 valeurs différentes, mais seules les valeurs entre 0 et 2^32 - 1 sont autorisées
+  // Part A
+  const std::uint64_t lowest_value = allowed.min().value_or(exit_at + 1);
 
-      amount_of_allowed += (exit_at - maybe_next + 1);
-    }
-  }
+  // Part B
+  const std::uint64_t amount_of_allowed = allowed.size();
 
   return Output(lowest_value, amount_of_allowed);
 }
-
@@ -4,7 +4,6 @@
 #include <ranges>
 #include "../../util/instruction_reader.hpp"
 #include <variant>
-#include <regex>
 #include <span>
 
 // https://adventofcode.com/2016/day/21
@@ -12,15 +11,17 @@
 // (A) run the instructions
 // (B) unrun the instructions
 
+namespace {
+
 struct SwapPosition {
-  static constexpr const char * Regex_Pattern = R"(swap position ([0-9]) with position ([0-9]))";
+  static constexpr bj::FixedString Line_Pattern = "swap position {digits} with position {digits}";
 
   size_t pos_a;
   size_t pos_b;
 
-  explicit SwapPosition(const std::vector<std::string> & values)
-    : pos_a(std::stoul(values[0]))
-    , pos_b(std::stoul(values[1])) {
+  SwapPosition(int pos_a, int pos_b)
+    : pos_a(pos_a)
+    , pos_b(pos_b) {
     }
 
   void apply(std::string & word) const { std::swap(word[pos_a], word[pos_b]); }
@@ -28,14 +29,14 @@ struct SwapPosition {
 };
 
 struct SwapLetter {
-  static constexpr const char * Regex_Pattern = R"(swap letter ([a-z]) with letter ([a-z]))";
+  static constexpr bj::FixedString Line_Pattern = "swap letter {char} with letter {char}";
 
   char letter_a;
   char letter_b;
 
-  explicit SwapLetter(const std::vector<std::string> & values)
-    : letter_a(values[0][0])
-    , letter_b(values[1][0]) {
+  SwapLetter(char letter_a, char letter_b)
+    : letter_a(letter_a)
+    , letter_b(letter_b) {
     }
 
   void apply(std::string & word) const {
@@ -48,12 +49,12 @@ struct SwapLetter {
 };
 
 struct RotateLeft {
-  static constexpr const char * Regex_Pattern = R"(rotate left ([0-9]) steps?)";
+  static constexpr bj::FixedString Line_Pattern = "rotate left {digits} {steps|step}";
 
   size_t steps;
 
-  explicit RotateLeft(const std::vector<std::string> & values)
-    : steps(std::stoul(values[0])) {
+  RotateLeft(int steps, int /* steps or step */)
+    : steps(steps) {
     }
 
   explicit RotateLeft(size_t steps) : steps(steps) {}
@@ -68,24 +69,24 @@ struct RotateLeft {
 };
 
 struct RotateRight {
-  static constexpr const char * Regex_Pattern = R"(rotate right ([0-9]) steps?)";
+  static constexpr bj::FixedString Line_Pattern = "rotate right {digits} {steps|step}";
 
   RotateLeft base;
 
-  explicit RotateRight(const std::vector<std::string> & values)
-    : base(std::stoul(values[0])) {}
+  RotateRight(int steps, int /* steps or step */)
+    : base(steps) {}
 
   void apply(std::string & word) const { base.unapply(word); }
   void unapply(std::string & word) const { base.apply(word); }
 };
 
 struct RotateLetter {
-  static constexpr const char * Regex_Pattern = R"(rotate based on position of letter ([a-z]))";
+  static constexpr bj::FixedString Line_Pattern = "rotate based on position of letter {char}";
 
   char letter;
 
-  explicit RotateLetter(const std::vector<std::string> & values)
-    : letter(values[0][0]) {}
+  explicit RotateLetter(char letter)
+    : letter(letter) {}
 
   void apply(std::string & word) const {
     int pos = word.find(letter);
@@ -122,14 +123,14 @@ struct RotateLetter {
 };
 
 struct ReversePositions {
-  static constexpr const char * Regex_Pattern = R"(reverse positions ([0-9]) through ([0-9]))";
+  static constexpr bj::FixedString Line_Pattern = "reverse positions {digits} through {digits}";
 
   size_t pos_a;
   size_t pos_b;
 
-  explicit ReversePositions(const std::vector<std::string> & values)
-    : pos_a(std::stoul(values[0]))
-    , pos_b(std::stoul(values[1])) {
+  ReversePositions(int pos_a, int pos_b)
+    : pos_a(pos_a)
+    , pos_b(pos_b) {
     }
 
   void apply(std::string & word) const {
@@ -147,14 +148,14 @@ struct ReversePositions {
 };
 
 struct MovePosition {
-  static constexpr const char * Regex_Pattern = R"(move position ([0-9]) to position ([0-9]))";
+  static constexpr bj::FixedString Line_Pattern = "move position {digits} to position {digits}";
 
   size_t from;
   size_t to;
 
-  explicit MovePosition(const std::vector<std::string> & values)
-    : from(std::stoul(values[0]))
-    , to(std::stoul(values[1])) {
+  MovePosition(int from, int to)
+    : from(from)
+    , to(to) {
     }
 
   void apply(std::string & word) const {
@@ -174,6 +175,8 @@ using Instruction = std::variant<
   SwapPosition, SwapLetter, RotateLeft, RotateRight, RotateLetter, ReversePositions, MovePosition
 >;
 
+}
+
 Output day_2016_21(const std::vector<std::string> & lines, const DayExtraInfo &) {
   std::string to_scramble = lines[0];
   std::string to_unscramble = lines[1];
@@ -1,9 +1,9 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
+#include "../../util/graph_search.hpp"
 #include <map>
 #include <exception>
 #include <bitset>
-#include <set>
 
 // https://adventofcode.com/2016/day/24
 
@@ -15,7 +15,7 @@ struct Grid {
   explicit Grid(const std::vector<std::string> & lines) : m_grid(lines) {}
 
   [[nodiscard]] std::map<int, bj::Position> get_positions() const;
-  [[nodiscard]] size_t get_distance(bj::Position from, bj::Position to) const;
+  [[nodiscard]] bj::graph::Distances<bj::graph::GridSpace> get_distances(bj::Position from) const;
 };
 
 
@@ -35,39 +35,17 @@ std::map<int, bj::Position> Grid::get_positions() const {
   return positions;
 }
 
-size_t Grid::get_distance(bj::Position from, bj::Position to) const {
-  if (from == to) return 0;
-
-  std::set<bj::Position> visited;
-  std::vector<bj::Position> current_positions;
-
-  visited.emplace(from);
-  current_positions.emplace_back(from);
-
-  size_t steps = 0;
-
-  std::vector<bj::Position> next;
-  while (true) {
-    next.clear();
-
-    for (const bj::Position pos : current_positions) {
+bj::graph::Distances<bj::graph::GridSpace> Grid::get_distances(bj::Position from) const {
+  // The borders of the grid are walls, so the neighbours of the open cells
+  // are always in the grid
+  return bj::graph::bfs(
+    bj::graph::GridSpace::of(m_grid), from,
+    [&](bj::Position pos, auto emit) {
       pos.for_each_neighbour([&](bj::Position neighbour) {
-        if (m_grid[neighbour.y][neighbour.x] == '#') return;
-        if (visited.contains(neighbour)) return;
-        visited.emplace(neighbour);
-        next.emplace_back(neighbour);
+        if (m_grid[neighbour.y][neighbour.x] != '#') emit(neighbour);
       });
     }
-
-    for (const auto & next_ : next) {
-      if (next_ == to) {
-        return steps + 1;
-      }
-    }
-
-    ++steps;
-    std::swap(next, current_positions);
-  }
+  ).distances;
 }
 
 
@@ -125,8 +103,10 @@ Output day_2016_24(const std::vector<std::string> & lines, const DayExtraInfo &)
   std::map<std::pair<int, int>, size_t> distances;
 
   for (int i = min; i != max; ++i) {
+    const auto from_i = grid.get_distances(points_of_interest[i]);
+
     for (int j = i + 1; j <= max; ++j) {
-      const size_t distance = grid.get_distance(points_of_interest[i], points_of_interest[j]);
+      const size_t distance = static_cast<size_t>(from_i[points_of_interest[j]]);
       distances[std::pair<int, int>(i, j)] = distance;
       distances[std::pair<int, int>(j, i)] = distance;
     }
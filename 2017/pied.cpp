@@ -35,7 +35,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2017 {
     &day_2017_21, &day_2017_22, &day_2017_23, &day_2017_24, &day_2017_25
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2017() {
+    return to_day_entries(days_2017);
+}
+#else
 int main(int argc, const char * argv[]) {
     run_aoc(days_2017, argc, argv);
     return 0;
 }
+#endif
@@ -3,6 +3,8 @@
 
 // https://adventofcode.com/2017/day/07
 
+namespace {
+
 struct Info {
   std::string name;
   int weight;
@@ -51,6 +53,8 @@ Info * Info::is_unbalanced() const {
   return nullptr;
 }
 
+}
+
 Output day_2017_07(const std::vector<std::string> & lines, const DayExtraInfo &) {
   std::vector<Info> infos;
 
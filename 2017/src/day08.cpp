@@ -4,6 +4,8 @@
 
 // https://adventofcode.com/2017/day/08
 
+namespace {
+
 bool is_true(
   std::map<std::string, int> & registers,
   std::string checked_register,
@@ -21,6 +23,8 @@ bool is_true(
   return false;
 }
 
+}
+
 
 Output day_2017_08(const std::vector<std::string> & lines, const DayExtraInfo &) {
   int max_ever_held = 0;
@@ -11,6 +11,8 @@
 
 // == DAY 10
 
+namespace {
+
 struct Knothash {
   std::array<std::uint8_t, 16> raw_bytes;
 
@@ -18,8 +20,6 @@ struct Knothash {
   [[nodiscard]] std::string to_string() const;
 };
 
-namespace {
-
 std::array<std::uint8_t, 256> get_initial_rope() {
   std::array<std::uint8_t, 256> values;
   for (size_t i = 0; i != 256; ++i) {
@@ -75,8 +75,6 @@ char to_hex_char(int number) {
   else return 'a' + number - 10;
 }
 
-}
-
 
 Knothash::Knothash(const std::string & str) {
   std::vector<size_t> lengths;
@@ -114,6 +112,8 @@ std::string Knothash::to_string() const {
   return s;
 }
 
+}
+
 Output day_2017_10(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   const std::string line = lines[0];
   return Output(dei.can_skip_part_A ? 0 : part_a(line), Knothash(line).to_string());
@@ -121,6 +121,8 @@ Output day_2017_10(const std::vector<std::string> & lines, const DayExtraInfo &
 
 // == DAY 14
 
+namespace {
+
 void visit_group(const std::vector<std::bitset<128>> & map, bj::Position position, std::set<bj::Position> & grouped) {
   std::stack<bj::Position> to_visit;
 
@@ -164,6 +166,8 @@ size_t count_number_of_areas(const std::vector<std::bitset<128>> & map) {
   return number_of_groups;
 }
 
+}
+
 Output day_2017_14(const std::vector<std::string> & lines, const DayExtraInfo &) {
   const std::string key = lines[0];
 
@@ -5,6 +5,8 @@
 // https://adventofcode.com/2017/day/11
 
 
+namespace {
+
 int distance_to_origin(bj::Position position) {
   const int horizontal_movement = std::abs(position.x);
 
@@ -18,6 +20,8 @@ int distance_to_origin(bj::Position position) {
   return total_movement;
 }
 
+}
+
 Output day_2017_11(const std::vector<std::string> & lines, const DayExtraInfo &) {
   const std::string line = lines[0];
 
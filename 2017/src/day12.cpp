@@ -7,6 +7,8 @@
 // https://adventofcode.com/2017/day/11
 
 
+namespace {
+
 std::set<int> discover_group_of(const std::map<int, std::vector<int>> & programs, int leader) {
   std::set<int> known_connected;
   std::stack<int> to_visit;
@@ -31,6 +33,8 @@ std::set<int> discover_group_of(const std::map<int, std::vector<int>> & programs
   return known_connected;
 }
 
+}
+
 
 
 Output day_2017_12(const std::vector<std::string> & lines, const DayExtraInfo &) {
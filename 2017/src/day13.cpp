@@ -3,6 +3,8 @@
 
 // https://adventofcode.com/2017/day/13
 
+namespace {
+
 struct Firewall {
   std::vector<int> layers;
 
@@ -38,6 +40,8 @@ struct Firewall {
   }
 };
 
+}
+
 
 Output day_2017_13(const std::vector<std::string> & lines, const DayExtraInfo &) {
   Firewall firewall;
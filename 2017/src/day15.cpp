@@ -4,6 +4,8 @@
 // https://adventofcode.com/2017/day/15
 
 
+namespace {
+
 struct Generator {
   std::uint64_t current_value;
   std::uint64_t factor;
@@ -34,6 +36,8 @@ size_t match(Generator gen_a, Generator gen_b, int bound) {
   return total;
 }
 
+}
+
 
 Output day_2017_15(const std::vector<std::string> & lines, const DayExtraInfo &) {
   Generator generator_a ( bj::extract_ints_from_line(lines[0])[0], 16807 );
@@ -6,6 +6,8 @@
 
 
 
+namespace {
+
 void dance(const std::string & instructions, std::string & sequence) {
   size_t i_ins = 0;
   
@@ -51,6 +53,8 @@ void dance(const std::string & instructions, std::string & sequence) {
   }
 }
 
+}
+
 
 
 Output day_2017_16(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
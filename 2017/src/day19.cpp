@@ -10,6 +10,8 @@
 // https://adventofcode.com/2017/day/19
 
 
+namespace {
+
 void turn_left(bj::Direction & direction) {
   switch (direction) {
     case bj::Direction::Left: direction = bj::Direction::Down; return;
@@ -19,6 +21,8 @@ void turn_left(bj::Direction & direction) {
   }
 }
 
+}
+
 
 
 
@@ -10,6 +10,8 @@
 
 // https://adventofcode.com/2017/day/20
 
+namespace {
+
 struct XYZ {
   std::array<std::int64_t, 3> raw;
 
@@ -152,6 +154,8 @@ std::optional<std::int64_t> Particle::get_time_of_collision(const Particle & oth
   return to_check[0];
 }
 
+}
+
 Output day_2017_20(const std::vector<std::string> & lines, const DayExtraInfo &) {
   std::regex regex { R"(p=<\s*(-?\d+),\s*(-?\d+),\s*(-?\d+)>, v=<\s*(-?\d+),\s*(-?\d+),\s*(-?\d+)>, a=<\s*(-?\d+),\s*(-?\d+),\s*(-?\d+)>)" };
   std::smatch smatch;
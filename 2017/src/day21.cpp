@@ -6,6 +6,8 @@
 
 // https://adventofcode.com/2017/day/21
 
+namespace {
+
 std::vector<bj::Position> to_positions(const std::string & token) {
   int x = 0;
   int y = 0;
@@ -171,6 +173,8 @@ void Grid::expand(const std::map<int, std::vector<bj::Position>> & patterns, siz
   std::swap(new_grid, lit);
 }
 
+}
+
 Output day_2017_21(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   AllWrittenInTheManual manual;
 
@@ -1,14 +1,13 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
+#include "../../util/flat_hash.hpp"
 #include <vector>
-#include <set>
-#include <map>
 
 // https://adventofcode.com/2017/day/22
 
 namespace {
 
-size_t part_a(std::set<bj::Position> infested, int mid_x, int mid_y) {
+size_t part_a(bj::FlatSet<bj::Position> infested, int mid_x, int mid_y) {
   bj::Kitten virus_carrier(bj::Position{ mid_x, mid_y }, bj::Direction::Top);
 
   size_t added_virus = 0;
@@ -28,9 +27,9 @@ size_t part_a(std::set<bj::Position> infested, int mid_x, int mid_y) {
   return added_virus;
 }
 
-size_t part_b(std::set<bj::Position> infested_set, int mid_x, int mid_y) {
+size_t part_b(bj::FlatSet<bj::Position> infested_set, int mid_x, int mid_y) {
   enum class State { Clean, Weakened, Infected, Flagged };
-  std::map<bj::Position, State> infested;
+  bj::FlatMap<bj::Position, State> infested;
   for (const auto infested_element : infested_set) {
     infested.emplace(infested_element, State::Infected);
   }
@@ -67,7 +66,7 @@ size_t part_b(std::set<bj::Position> infested_set, int mid_x, int mid_y) {
 }
 
 Output day_2017_22(const std::vector<std::string> & lines, const DayExtraInfo &) {
-  std::set<bj::Position> infested;
+  bj::FlatSet<bj::Position> infested;
 
   for (size_t y = 0; y != lines.size(); ++y) {
     for (size_t x = 0; x != lines[y].size(); ++x) {
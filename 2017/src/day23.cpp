@@ -36,8 +36,6 @@ struct ProgramState {
   }
 };
 
-}
-
 std::vector<int> get_primes_until(int max) {
   std::vector<int> primes;
   primes.emplace_back(2);
@@ -55,6 +53,8 @@ std::vector<int> get_primes_until(int max) {
   return primes;
 }
 
+}
+
 Output day_2017_23(const std::vector<std::string> & lines, const DayExtraInfo &) {
   // Part A
   ProgramState state;
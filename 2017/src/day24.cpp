@@ -9,6 +9,8 @@
 // It's probably possible to refactor this using the pattern strategy
 // and templates
 
+namespace {
+
 int build_strong_bridge(
   int exposed_pins,
   std::vector<std::pair<int, int>> & available_components,
@@ -90,6 +92,8 @@ LongBridge build_long_bridge(
   return best;
 }
 
+}
+
 
 Output day_2017_24(const std::vector<std::string> & lines, const DayExtraInfo &) {
 
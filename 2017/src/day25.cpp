@@ -7,6 +7,8 @@
 // https://adventofcode.com/2017/day/25
 // This input format ;-;
 
+namespace {
+
 struct Action {
   int write;
   int dx;
@@ -18,6 +20,8 @@ struct StateDescription {
   Action on_1;
 };
 
+}
+
 Output day_2017_25(const std::vector<std::string> & lines, const DayExtraInfo &) {
   std::regex prelude_regex { R"(Begin in state ([A-Z])\.\nPerform a diagnostic checksum after (\d+) steps?\.)" };
   std::regex kill_me_regex { R"(In state ([A-Z]):\n  If the current value is 0:\n    - Write the value (0|1)\.\n    - Move one slot to the (left|right)\.\n    - Continue with state ([A-Z])\.\n  If the current value is 1:\n    - Write the value (0|1)\.\n    - Move one slot to the (left|right)\.\n    - Continue with state ([A-Z])\.)" };
@@ -25,7 +25,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2018 {
   nullptr
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2018() {
+  return to_day_entries(days_2018);
+}
+#else
 int main(int argc, const char * argv[]) {
   run_aoc(days_2018, argc, argv);
   return 0;
 }
+#endif
@@ -11,6 +11,8 @@
 // https://adventofcode.com/2018/day/06
 
 
+namespace {
+
 bj::Rectangle get_boundaries(std::span<const bj::Position> positions) {
   if (positions.empty()) return bj::Rectangle(0, 0, 0, 0);
 
@@ -72,6 +74,8 @@ size_t range_count(Range && range) {
   return answer;
 }
 
+}
+
 
 Output day_2018_06(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   std::vector<bj::Position> points;
@@ -41,8 +41,6 @@ Input::Input(const std::vector<std::string> & lines) {
 }
 
 
-}
-
 struct WorkInProgress {
   std::string order;
   int time = 0;
@@ -166,6 +164,8 @@ public:
   }
 };
 
+}
+
 
 Output day_2018_07(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   Input input(lines);
@@ -4,6 +4,8 @@
 
 // https://adventofcode.com/2018/day/09
 
+namespace {
+
 template<typename T>
 struct focused_ring {
   struct node {
@@ -64,6 +66,8 @@ struct focused_ring {
   const T & operator*() const { return focus->element; }
 };
 
+}
+
 
 static std::int64_t play_the_marble_game(const size_t nb_players, const int last_marble) {
   std::vector<std::int64_t> points_per_players(nb_players, 0);
@@ -6,6 +6,8 @@
 
 // https://adventofcode.com/2018/day/10
 
+namespace {
+
 struct Point {
   int x;
   int y;
@@ -122,6 +124,8 @@ void Galaxy::draw(std::ostream & stream) const {
   std::cout << '*' << '\n';
 }
 
+}
+
 
 Output day_2018_10(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   Galaxy galaxy = Galaxy::from_input(lines);
@@ -8,6 +8,8 @@
 // https://adventofcode.com/2018/day/11
 
 
+namespace {
+
 struct Cache {
   std::int64_t sum = 0;
   int first_line = -1;
@@ -149,6 +151,8 @@ std::string array_to_string(std::array<int, N> values) {
   return s;
 }
 
+}
+
 
 Output day_2018_11(const std::vector<std::string> &, const DayExtraInfo & dei) {
   const std::int64_t grid_serial_number = dei.part_a_extra_param;
@@ -8,6 +8,8 @@
 
 // https://adventofcode.com/2018/day/12
 
+namespace {
+
 static std::vector<std::int64_t> to_state(const std::string & line) {
   std::vector<std::int64_t> retval;
   for (size_t i = 0; i != line.size(); ++i) {
@@ -146,6 +148,8 @@ std::int64_t compute(
   return std::reduce(state.begin(), state.end());
 }
 
+}
+
 
 Output day_2018_12(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   auto state = to_state(lines[0].substr(std::strlen("initial state: ")));
@@ -4,6 +4,8 @@
 
 // https://adventofcode.com/2018/day/13
 
+namespace {
+
 enum class Tile {
   Continue,
   ToNE,
@@ -81,6 +83,8 @@ void Cart::move(const Rails & rails) {
   }
 }
 
+}
+
 static std::pair<Rails, std::vector<Cart>> read_input(std::vector<std::string> lines) {
   std::vector<Cart> carts;
 
@@ -3,6 +3,8 @@
 
 // https://adventofcode.com/2018/day/14
 
+namespace {
+
 struct RecipeeGame {
   size_t elve_1 = 0;
   size_t elve_2 = 1;
@@ -68,6 +70,8 @@ std::int64_t run_part_b(std::span<const int> target) {
   }
 }
 
+}
+
 Output day_2018_14(const std::vector<std::string> &, const DayExtraInfo & dei) {
   const std::string part_a = run_part_a(dei.part_a_extra_param);
   
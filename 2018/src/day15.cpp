@@ -3,11 +3,14 @@
 #include "../../util/position.hpp"
 #include <algorithm>
 #include <variant>
+#include <set>
 
 // https://adventofcode.com/2018/day/15
 
 // Does not work
 
+namespace {
+
 struct Empty {};
 
 struct Wall {};
@@ -66,8 +69,6 @@ bool Game::finished() const {
   return !(hasElve && hasGoblin);
 }
 
-#include <set>
-
 bj::Direction goTo(const Game & game, bj::Position pos, Entity::Race race) {
   struct Path {
     int steps;
@@ -121,6 +122,8 @@ void Game::round() {
 
 }
 
+}
+
 
 Output day_2018_15(const std::vector<std::string> & lines, const DayExtraInfo &) {
   Game game(lines);
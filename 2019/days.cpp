@@ -16,7 +16,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2019 {
   nullptr
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2019() {
+  return to_day_entries(days_2019);
+}
+#else
 int main(int argc, const char * argv[]) {
   run_aoc(days_2019, argc, argv);
   return 0;
 }
+#endif
@@ -6,6 +6,8 @@
 // https://adventofcode.com/2019/day/07
 // https://adventofcode.com/2019/day/09
 
+namespace {
+
 using Int = std::int64_t;
 
 enum class OpInstruction {
@@ -140,8 +142,6 @@ void OpCodeMachine::run_until_halt() {
 }
 
 
-namespace {
-
 namespace aoc2019_02 {
 
 static int run(std::vector<Int> opcodes, int noun, int verb) {
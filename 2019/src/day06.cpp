@@ -5,6 +5,8 @@
 // https://adventofcode.com/2019/day/06
 
 
+namespace {
+
 struct Planet {
   std::string name;
   Planet * orbits_around = nullptr;
@@ -55,6 +57,8 @@ struct System {
   }
 };
 
+}
+
 Output day_2019_06(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   System planets(lines.size() * 2);
 
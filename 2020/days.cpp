@@ -35,7 +35,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2020 {
     &day_2020_21, &day_2020_22, &day_2020_23, &day_2020_24, &day_2020_25
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2020() {
+    return to_day_entries(days_2020);
+}
+#else
 int main(int argc, const char * argv[]) {
     run_aoc(days_2020, argc, argv);
     return 0;
 }
+#endif
@@ -3,6 +3,8 @@
 
 // https://adventofcode.com/2020/day/2
 
+namespace {
+
 struct PolicyPassword {
     size_t first;
     size_t second;
@@ -32,6 +34,8 @@ PolicyPassword PolicyPassword::from_string(const std::string & str) {
     };
 }
 
+}
+
 static bool match_ruleset1(const PolicyPassword & pp) {
     const size_t count = std::count(
         pp.password.begin(), pp.password.end(), pp.key
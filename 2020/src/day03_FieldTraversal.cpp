@@ -1,34 +1,37 @@
 #include "../../common/advent_of_code.hpp"
-#include <regex>
+#include "../../util/grid.hpp"
 
 // https://adventofcode.com/2020/day/3
 
+namespace {
+
 constexpr char TREE = '#';
 
-static auto count_trees_on_slope(Board board, size_t x, size_t y, int dX, int dY) {
-    long long int count = 0;
+}
 
-    BoardPosition pos = BoardPosition(board, x, y, true, false);
+// The field repeats itself to the right
+static auto count_trees_on_slope(const bj::Grid<char> & field, int dX, int dY) {
+    long long int count = 0;
 
-    while (auto something = *pos) {
-        if (*something == TREE) {
+    for (bj::Position position { 0, 0 }; position.y < field.height(); position.y += dY) {
+        if (field[position] == TREE) {
             ++count;
         }
 
-        pos.offset(dX, dY);
+        position.x = (position.x + dX) % field.width();
     }
 
     return count;
 }
 
 Output day_2020_03(const std::vector<std::string> & lines, const DayExtraInfo &) {
-    Board board = Board(lines);
+    const bj::Grid<char> field = bj::Grid<char>::from_lines(lines);
 
-    const auto slope_1_1 = count_trees_on_slope(board, 0, 0, 1, 1);
-    const auto slope_3_1 = count_trees_on_slope(board, 0, 0, 3, 1);
-    const auto slope_5_1 = count_trees_on_slope(board, 0, 0, 5, 1);
-    const auto slope_7_1 = count_trees_on_slope(board, 0, 0, 7, 1);
-    const auto slope_1_2 = count_trees_on_slope(board, 0, 0, 1, 2);
+    const auto slope_1_1 = count_trees_on_slope(field, 1, 1);
+    const auto slope_3_1 = count_trees_on_slope(field, 3, 1);
+    const auto slope_5_1 = count_trees_on_slope(field, 5, 1);
+    const auto slope_7_1 = count_trees_on_slope(field, 7, 1);
+    const auto slope_1_2 = count_trees_on_slope(field, 1, 2);
 
     const auto times = slope_1_1 * slope_3_1 * slope_5_1 * slope_7_1 * slope_1_2;
 
@@ -1,56 +1,55 @@
 #include "../../common/advent_of_code.hpp"
-#include <regex>
+#include "../../util/pattern.hpp"
+#include <functional>
+#include <map>
 
 // https://adventofcode.com/2020/day/4
 
+namespace {
+
 class ValidationRules {
     using Validator = std::function<bool (std::string)>;
 
     std::map<std::string, Validator> m_validators;
 
 public:
+    [[nodiscard]] static bool is_digits(const std::string & s, size_t size) {
+        return s.size() == size && std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; });
+    }
+
     static std::function<bool (std::string)> four_digits(int min, int max) {
         return [min, max](std::string s) {
-            std::regex pattern { R"(^([0-9]{4})$)" };
-            std::smatch matches;
-
-            const auto rs = std::regex_search(s, matches, pattern);
-            if (!rs) return false;
-            const int value = std::stoi(matches[1].str());
+            if (!is_digits(s, 4)) return false;
+            const int value = std::stoi(s);
             return min <= value && max >= value;
         };
     }
 
-    static std::function<bool (std::string)> match_pattern(std::string pattern) {
-        return [pattern](std::string s) {
-            std::regex r { pattern };
-            std::smatch matches;
-            return std::regex_search(s, matches, r);
-        };
-    }
-
     ValidationRules() {
         m_validators["byr"] = four_digits(1920, 2002);
         m_validators["iyr"] = four_digits(2010, 2020);
         m_validators["eyr"] = four_digits(2020, 2030);
         m_validators["hgt"] = [](const std::string & s) {
-            std::regex r { "^([0-9]*)(cm|in)$"};
-            std::smatch matches;
-            const auto rs = std::regex_search(s, matches, r);
-            if (!rs) return false;
-            // TODO : I need a function "direct_regex" that does the three operations
+            const auto height = bj::Pattern<"{digits}{cm|in}">::match(s);
+            if (!height) return false;
 
-            const int raw_value = std::stoi(matches[1].str());
+            const auto [raw_value, unit] = *height;
 
-            if (matches[2].str() == "cm") {
+            if (unit == 0 /* cm */) {
                 return 150 <= raw_value && raw_value <= 193;
             } else {
                 return 59 <= raw_value && raw_value <= 76;
             }
         };
-        m_validators["hcl"] = match_pattern("^#[0-9a-f]{6}$");
-        m_validators["ecl"] = match_pattern("^(amb|blu|brn|gry|grn|hzl|oth)$");
-        m_validators["pid"] = match_pattern("^[0-9]{9}$");
+        m_validators["hcl"] = [](const std::string & s) {
+            return s.size() == 7 && s[0] == '#' && std::all_of(s.begin() + 1, s.end(),
+                [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); }
+            );
+        };
+        m_validators["ecl"] = [](const std::string & s) {
+            return bj::Pattern<"{amb|blu|brn|gry|grn|hzl|oth}">::match(s).has_value();
+        };
+        m_validators["pid"] = [](const std::string & s) { return is_digits(s, 9); };
     }
 
     [[nodiscard]] bool operator()(std::string key, std::string value) const {
@@ -62,19 +61,15 @@ public:
 };
 
 class Passport {
-    static constexpr const char * PATTERN = "^ ?([a-z]*):([#|0-9a-zA-Z]*)";
-
     std::map<std::string, std::string> m_content;
 public:
-    explicit Passport(std::string passport) {
-        std::regex pattern { PATTERN };
+    explicit Passport(const std::string & passport) {
+        for (const std::string & field : bj::string_split(passport, " ")) {
+            const auto key_value = bj::Pattern<"{word}:{str}">::match(field);
+            if (!key_value) continue;
 
-        std::smatch matches;
-
-        while (std::regex_search(passport, matches, pattern)) {
-            m_content.insert_or_assign(matches[1].str(), matches[2].str());
-            
-            passport = matches.suffix();
+            const auto [key, value] = *key_value;
+            m_content.insert_or_assign(std::string(key), std::string(value));
         }
     }
 
@@ -109,6 +104,8 @@ public:
     }
 };
 
+}
+
 Output day_2020_04(const std::vector<std::string> & lines, const DayExtraInfo &) {
     const std::vector<Passport> passports = lines_transform::group<Passport, std::string>(
         lines,
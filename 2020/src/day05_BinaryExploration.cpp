@@ -2,6 +2,8 @@
 
 // https://adventofcode.com/2020/day/5
 
+namespace {
+
 struct Interval {
     int left;
     int right;
@@ -36,6 +38,8 @@ struct Seat {
     [[nodiscard]] int to_id() const noexcept { return row * 8 + column; }
 };
 
+}
+
 Output day_2020_05(const std::vector<std::string> & lines, const DayExtraInfo &) {
     std::vector<int> seats;
     for (const auto & line : lines) {
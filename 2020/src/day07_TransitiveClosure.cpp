@@ -11,6 +11,8 @@
 // on the surrounding non-capturing group), only the last value that matches
 // it gets stored."
 
+namespace {
+
 static constexpr const char * const BAGS_CONTAIN = R"(^([a-z ]*) bags contain ([a-z0-9, ]*)\.$)";
 static constexpr const char * const CONTAINED_BAG = R"(([0-9]+) ([a-z ]*) bags?)" ;
 
@@ -113,6 +115,8 @@ void Bag::ensure_is_transitively_closed(Bag::All & all_bags) {
     is_transitively_closed = true;
 }
 
+}
+
 Output day_2020_07(const std::vector<std::string> & lines, const DayExtraInfo &) {
     std::regex regex_bag_contains { BAGS_CONTAIN };
     std::regex regex_contained   { CONTAINED_BAG };
@@ -2,6 +2,8 @@
 
 // https://adventofcode.com/2020/day/8
 
+namespace {
+
 enum class InstructionType {
     Nop, Acc, Jmp
 };
@@ -83,6 +85,8 @@ public:
     }
 };
 
+}
+
 Output day_2020_08(const std::vector<std::string> & lines, const DayExtraInfo &) {
     std::vector<Instruction> instructions = lines_transform::map<Instruction>(lines, Instruction::from_string);
 
@@ -1,37 +1,27 @@
 #include "../../common/advent_of_code.hpp"
+#include "../../util/grid.hpp"
 
 // https://adventofcode.com/2020/day/11
 
+namespace {
 
-static unsigned int count_empty_seats(Board board) {
-    unsigned int counter = 0;
+// The seats are surrounded by a border of 'X', neither a seat nor the floor,
+// so the neighbours of every seat can be read without checking the bounds
+using Seats = bj::Grid<char>;
 
-    for (size_t x = 0 ; x != board.width() ; ++x) {
-        for (size_t y = 0 ; y != board.height() ; ++y) {
-            const auto c = board.get_at(x, y);
-            if (*c == '#') {
-                ++counter;
-            }
-        }
-    }
-
-    return counter;
-}
+static constexpr std::array<bj::Position, 8> directions {
+    bj::Position{ -1, -1 }, bj::Position{ 0, -1 }, bj::Position{ 1, -1 },
+    bj::Position{ -1,  0 },                        bj::Position{ 1,  0 },
+    bj::Position{ -1,  1 }, bj::Position{ 0,  1 }, bj::Position{ 1,  1 }
+};
 
-static char around(char current_char, const Board & board, size_t x, size_t y) {
+static char around(char current_char, const Seats & board, bj::Position position) {
     // count occupied
     unsigned int occupied = 0;
 
-    for (size_t xprime : { x - 1, x, x + 1 }) {
-        for (size_t yprime : { y - 1, y, y + 1 }) {
-            if (xprime == x && yprime == y) continue;
-
-            if (const auto opt_char = board.get_at(xprime, yprime)) {
-                // opt_char == std::nullopt if out of bound
-                if (*opt_char == '#') {
-                    ++occupied;
-                }
-            }
+    for (const bj::Position direction : directions) {
+        if (board[position + direction] == '#') {
+            ++occupied;
         }
     }
 
@@ -43,30 +33,18 @@ static char around(char current_char, const Board & board, size_t x, size_t y) {
     }
 }
 
-static char line_vision(char current_char, const Board & board, const size_t x, const size_t y) {
+static char line_vision(char current_char, const Seats & board, const bj::Position position) {
     unsigned int occupied = 0;
 
-    for (    int x_delta : { -1, 0, 1 }) {
-        for (int y_delta : { -1, 0, 1 }) {
-            if (x_delta == 0 && y_delta == 0) continue;
-
-            size_t xp = x;
-            size_t yp = y;
+    for (const bj::Position direction : directions) {
+        bj::Position seen = position + direction;
 
-            while (true) {
-                xp += x_delta;
-                yp += y_delta;
-
-                const auto opt_char = board.get_at(xp, yp);
-
-                if (!opt_char) break;
-
-                if (*opt_char != '.') {
-                    if (*opt_char == '#') ++occupied;
-                    break;
-                }
-            }
+        // The border stops the vision
+        while (board[seen] == '.') {
+            seen += direction;
         }
+
+        if (board[seen] == '#') ++occupied;
     }
 
     if (current_char == 'L') {
@@ -77,29 +55,29 @@ static char line_vision(char current_char, const Board & board, const size_t x,
 }
 
 template <typename Function>
-unsigned int figure_empty_seats(Board board, Function slot_changer) {
+unsigned int figure_empty_seats(Seats board, Function slot_changer) {
+    Seats new_board = board;
+
     while (true) {
-        Board new_board = board;
-
-        for (size_t x = 0 ; x != board.width() ; ++x) {
-            for (size_t y = 0 ; y != board.height() ; ++y) {
-                const char current_symbol = *board.get_at(x, y);
-                if (current_symbol != '.') {
-                    new_board.set_at(x, y, slot_changer(current_symbol, board, x, y));
-                }
+        for (const bj::Position position : board.positions()) {
+            const char current_symbol = board[position];
+            if (current_symbol != '.') {
+                new_board[position] = slot_changer(current_symbol, board, position);
             }
         }
 
         if (new_board == board) {
-            return count_empty_seats(board);
+            return static_cast<unsigned int>(board.count('#'));
         }
 
-        board = new_board;
+        std::swap(board, new_board);
     }
 }
 
+}
+
 Output day_2020_11(const std::vector<std::string> & lines, const DayExtraInfo &) {
-    Board board = Board(lines);
+    const Seats board = Seats::from_lines(lines, 1, 'X');
 
     const unsigned int empty_seats_A = figure_empty_seats(board, around);
     const unsigned int empty_seats_B = figure_empty_seats(board, line_vision);
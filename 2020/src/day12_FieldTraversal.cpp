@@ -4,6 +4,8 @@
 
 // Position
 
+namespace {
+
 struct Position {
     int x;
     int y;
@@ -108,6 +110,8 @@ public:
     }
 };
 
+}
+
 
 // Main
 
@@ -7,6 +7,8 @@
 // I figured out myself that it was related to congruences...
 // Found it was CRT on the internet.
 
+namespace {
+
 using Int = long long int;
 
 struct Bus {
@@ -21,6 +23,8 @@ struct Bus {
     }
 };
 
+}
+
 static std::vector<Bus> read_buses(std::string_view line) {
     std::vector<Bus> buses;
 
@@ -73,11 +77,11 @@ static bool is_contiguous_start(Int now, const std::vector<Bus> & buses) {
 
 [[maybe_unused]] static Int wolframalpha(const std::vector<Bus> & buses) {
     for (const auto & bus : buses) {
-        std::printf("(n+%lld)%%%lld = 0,", bus.id, bus.period);
+        std::cout << "(n+" << bus.id << ")%" << bus.period << " = 0,";
     }
     
-    std::printf("\n");
-    std::printf("https://www.wolframalpha.com\n");
+    std::cout << "\n";
+    std::cout << "https://www.wolframalpha.com\n";
 
     return 0;
 }
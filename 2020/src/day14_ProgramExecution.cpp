@@ -6,6 +6,8 @@
 
 // https://adventofcode.com/2020/day/14
 
+namespace {
+
 using Word = std::int64_t;  // We only require 35 bits thought
 
 struct MaskChanger {
@@ -160,6 +162,8 @@ void address_masker(ProgramExecutor::Ram & ram, Word address, Word value, const
     }
 }
 
+}
+
 Output day_2020_14(const std::vector<std::string> & lines, const DayExtraInfo & extra) {
     std::regex mask_regex        { R"(mask = ([X10]*))" };
     std::regex affectation_regex { R"(mem\[([0-9]*)\] = ([0-9]*))" };
@@ -4,6 +4,8 @@
 
 // https://adventofcode.com/2020/day/15
 
+namespace {
+
 struct Occurrences {
     int lastTurn;
     int beforeTurn;
@@ -48,6 +50,8 @@ public:
     [[nodiscard]] int last_number() const noexcept { return m_last_number; }
 };
 
+}
+
 Output day_2020_15(const std::vector<std::string> & lines, const DayExtraInfo & extra) {
     StringSplitter splitter = StringSplitter(lines[0], ',');
 
@@ -64,7 +68,9 @@ Output day_2020_15(const std::vector<std::string> & lines, const DayExtraInfo &
     const int number_at_2020 = instance.last_number();
     
     if (!extra.can_skip_part_B) {
-        while (!instance.is_turn(30000000)) {
+        for (int turn = 0; !instance.is_turn(30000000); ++turn) {
+            // Checking once in a while is enough, the loop is tight
+            if (turn % 0x10000 == 0 && extra.stop_requested()) break;
             instance.next();
         }
     }
@@ -5,12 +5,14 @@
 #include <vector>
 #include <set>
 #include <map>
-#include <regex>
+#include "../../util/pattern.hpp"
 #include <algorithm>
 
 // https://adventofcode.com/2020/day/16
 
 
+namespace {
+
 struct Restriction {
     int min;
     int max;
@@ -78,7 +80,7 @@ public:
 
         State current_state = State::Fields;
 
-        std::regex field_regex { R"(([a-z ]*): ([0-9]*)-([0-9]*) or ([0-9]*)-([0-9]*))" };
+        using FieldPattern = bj::Pattern<"{str}: {digits}-{digits} or {digits}-{digits}">;
 
         for (const std::string & line : lines) {
             if (line == "your ticket:") {
@@ -87,14 +89,13 @@ public:
                 current_state = State::OtherTickets;
             } else if (line == "") {
             } else if (current_state == State::Fields) {
-                std::smatch matches;
-                std::regex_search(line, matches, field_regex);
+                const auto [name, min_1, max_1, min_2, max_2] = FieldPattern::match(line).value();
 
-                m_field_names.push_back(matches[1].str());
+                m_field_names.emplace_back(name);
 
                 std::array<Restriction, 2> restrictions;
-                restrictions[0] = Restriction { std::stoi(matches[2].str()), std::stoi(matches[3].str()) };
-                restrictions[1] = Restriction { std::stoi(matches[4].str()), std::stoi(matches[5].str()) };
+                restrictions[0] = Restriction { min_1, max_1 };
+                restrictions[1] = Restriction { min_2, max_2 };
                 m_restrictions.push_back(restrictions);
             } else if (current_state == State::MyTicket) {
                 my_ticket = Ticket(line);
@@ -164,7 +165,7 @@ public:
             const size_t field_id = (*m_position_in_ticket_to_field)[pos];
             const std::string & field_name = m_field_names[field_id];
 
-            if (field_name.substr(0, std::strlen("departure")) == "departure") {
+            if (field_name.starts_with("departure")) {
                 sum *= my_ticket[pos];
             }
         }
@@ -203,16 +204,20 @@ public:
     }
 };
 
+}
+
 
 Output day_2020_16(const std::vector<std::string> & lines, const DayExtraInfo & extra) {
     TicketTranslation ticket_list = TicketTranslation(lines);
 
+    extra.start_phase(test::Phase::PartA);
     const auto error_rate = ticket_list.remove_invalid_tickets();
     
     if (extra.can_skip_part_B) {
         return Output(error_rate, 0);
     }
 
+    extra.start_phase(test::Phase::PartB);
     ticket_list.deduce_fields();
 
     const auto my_ticket_departure = ticket_list.my_departure();
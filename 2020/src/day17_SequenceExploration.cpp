@@ -1,4 +1,5 @@
 #include "../../common/advent_of_code.hpp"
+#include "../../util/game_of_life.hpp"
 
 #include <algorithm>
 #include <unordered_map>
@@ -11,6 +12,8 @@
 
 // https://adventofcode.com/2020/day/17
 
+namespace {
+
 /// A position in the NB_DIM D space
 template <size_t NB_DIM>
 struct Position {
@@ -102,6 +105,8 @@ struct Position {
     }
 };
 
+}
+
 namespace std {
     template <size_t NB_DIM> struct hash<Position<NB_DIM>> {
         std::size_t operator()(const Position<NB_DIM> & pos) const noexcept {
@@ -114,6 +119,8 @@ namespace std {
     };
 }
 
+namespace {
+
 namespace vector_implementation {
     // Hard coding 3D / 4D is too mainstream.
     // So here it is : generalization of game of life to any dimensional space.
@@ -316,6 +323,46 @@ namespace map_implementation {
     };
 }
 
+namespace bitboard_implementation {
+    template <size_t NB_DIM>
+    struct Rules {
+        using Element = std::array<int, NB_DIM>;
+
+        static constexpr std::uint64_t birth = bj::neighbour_counts({ 3 });
+        static constexpr std::uint64_t survival = bj::neighbour_counts({ 2, 3 });
+        static constexpr auto neighbourhood = bj::moore_neighbourhood<NB_DIM>();
+
+        [[nodiscard]] static bool is_valid(const Element &) noexcept { return true; }
+    };
+
+    template <size_t NB_DIM>
+    class Field {
+        bj::DenseGameOfLife<Rules<NB_DIM>> m_life;
+
+        static std::vector<std::array<int, NB_DIM>> to_cubes(const std::vector<std::string> & lines) {
+            std::vector<std::array<int, NB_DIM>> cubes;
+            for (size_t y = 0 ; y != lines.size() ; ++y) {
+                for (size_t x = 0 ; x != lines[y].size() ; ++x) {
+                    if (lines[y][x] == '#') {
+                        std::array<int, NB_DIM> cube {};
+                        cube[0] = static_cast<int>(x);
+                        cube[1] = static_cast<int>(y);
+                        cubes.emplace_back(cube);
+                    }
+                }
+            }
+            return cubes;
+        }
+
+    public:
+        explicit Field(const std::vector<std::string> & lines) : m_life(to_cubes(lines), Rules<NB_DIM>{}) {}
+
+        [[nodiscard]] auto count_occupied() const noexcept { return m_life.count(); }
+
+        void next() { m_life.step(); }
+    };
+}
+
 template<typename FieldClass>
 static auto occupied_after_six_iterations(const std::vector<std::string> & lines) {
     FieldClass field { lines };
@@ -325,10 +372,12 @@ static auto occupied_after_six_iterations(const std::vector<std::string> & lines
     return field.count_occupied();
 }
 
+}
+
 /// 3D / 4D game of life
 Output day_2020_17(const std::vector<std::string> & lines, const DayExtraInfo &) {
     return Output(
-        occupied_after_six_iterations<map_implementation::Field<3>>(lines),
-        occupied_after_six_iterations<map_implementation::Field<4>>(lines)
+        occupied_after_six_iterations<bitboard_implementation::Field<3>>(lines),
+        occupied_after_six_iterations<bitboard_implementation::Field<4>>(lines)
     );
 }
@@ -6,6 +6,8 @@
 
 // https://adventofcode.com/2020/day/18
 
+namespace {
+
 using Value = long long int;
 
 enum class Operator { Plus, Times };
@@ -177,6 +179,8 @@ Value compute_sum_of_results(const std::vector<std::string> & lines) {
     return sum;
 }
 
+}
+
 Output day_2020_18(const std::vector<std::string> & lines, const DayExtraInfo &) {
     return Output(
         compute_sum_of_results<NoOperatorPriority>(lines),
@@ -9,6 +9,8 @@
 
 // https://adventofcode.com/2020/day/19
 
+namespace {
+
 static const char * const RULE_DESCRIPTION = R"(^([0-9]*): (.*)$)";
 
 // ============================================================================
@@ -211,6 +213,8 @@ public:
     }
 };
 
+}
+
 // ============================================================================
 
 Output day_2020_19(const std::vector<std::string> & lines, const DayExtraInfo &) {
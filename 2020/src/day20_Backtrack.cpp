@@ -12,6 +12,8 @@
 
 // https://adventofcode.com/2020/day/20
 
+namespace {
+
 struct Tile;
 
 class RawPixels {
@@ -510,6 +512,8 @@ namespace part_b {
     }
 }
 
+}
+
 Output day_2020_20(const std::vector<std::string> & lines, const DayExtraInfo &) {
     std::optional<part_a::Grid> grid = part_a::solve(lines);
     if (!grid) return Output(0, 0);
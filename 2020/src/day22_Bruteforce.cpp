@@ -5,6 +5,8 @@
 
 // https://adventofcode.com/2020/day/22
 
+namespace {
+
 class Game {
 private:
     using Card = size_t;
@@ -105,6 +107,8 @@ public:
     }
 };
 
+}
+
 Output day_2020_22(const std::vector<std::string> & lines, const DayExtraInfo &) {
     Game game { lines };
     Game recursive_game = game;
@@ -1,16 +1,13 @@
 #include "../../common/advent_of_code.hpp"
+#include "../../util/game_of_life.hpp"
 
 #include <set>
-#include <map>
 
 // https://adventofcode.com/2020/day/24
 
-enum class HexaDirection { e, se, sw, w, nw, ne };
+namespace {
 
-static constexpr auto DIRECTIONS = {
-    HexaDirection::e , HexaDirection::ne, HexaDirection::nw,
-    HexaDirection::se, HexaDirection::sw, HexaDirection::w
-};
+enum class HexaDirection { e, se, sw, w, nw, ne };
 
 static auto to_directions(std::string_view line) {
     std::vector<HexaDirection> retval;
@@ -72,15 +69,6 @@ struct Position {
             case HexaDirection::ne:     x += 1; y -= 1; break;
         }
     }
-
-    template <typename Consumer>
-    void for_each_adjacent(Consumer c) const {
-        for (auto d : DIRECTIONS) {
-            Position p  = *this;
-            p.move(d);
-            c(p);
-        }
-    }
 };
 
 static auto to_tiles(const std::vector<std::vector<HexaDirection>> & directionss) {
@@ -99,37 +87,36 @@ static auto to_tiles(const std::vector<std::vector<HexaDirection>> & directionss
     return black_tiles;
 }
 
-static std::set<Position> game_of_life(std::set<Position> black) {
-    std::map<Position, int> black_neighbours;
-
-    for (const auto & position : black) {
-        position.for_each_adjacent([&](Position p) {
-            ++black_neighbours[p];
-        });
-    }
+/// The tiles are alive when they are black
+struct HexagonalRules {
+    using Element = bj::Position;
 
-    std::set<Position> result;
+    static constexpr std::uint64_t birth = bj::neighbour_counts({ 2 });
+    static constexpr std::uint64_t survival = bj::neighbour_counts({ 1, 2 });
+    // Position::move in the hexagonal directions
+    static constexpr std::array<std::array<int, 2>, 6> neighbourhood {{
+        { 1, 0 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { 0, -1 }, { 1, -1 }
+    }};
 
-    for (const auto & [tile, black_neighbour] : black_neighbours) {
-        if (!black.contains(tile)) {
-            if (black_neighbour == 2) result.insert(tile);
-        } else {
-            if (!(black_neighbour == 0 || black_neighbour > 2)) result.insert(tile);
-        }
-    }
+    [[nodiscard]] static bool is_valid(const bj::Position &) noexcept { return true; }
+};
 
-    return result;
 }
 
 Output day_2020_24(const std::vector<std::string> & lines, const DayExtraInfo &) {
     const auto directionss = lines_transform::map<std::vector<HexaDirection>>(lines, to_directions);
 
-    auto black_tiles = to_tiles(directionss);
-    const size_t init_black_tiles = black_tiles.size();
+    const auto black_tiles = to_tiles(directionss);
+
+    std::vector<bj::Position> alive;
+    for (const Position & tile : black_tiles) {
+        alive.emplace_back(bj::Position{ tile.x, tile.y });
+    }
 
+    bj::DenseGameOfLife<HexagonalRules> floor(alive, HexagonalRules{});
     for (size_t i = 0 ; i != 100 ; ++i) {
-        black_tiles = game_of_life(black_tiles);
+        floor.step();
     }
     
-    return Output(init_black_tiles, black_tiles.size());
+    return Output(black_tiles.size(), floor.count());
 }
@@ -2,6 +2,8 @@
 
 // https://adventofcode.com/2020/day/25
 
+namespace {
+
 class EncryptionKey {
 private:
     long long int m_key;
@@ -31,6 +33,8 @@ public:
     }
 };
 
+}
+
 Output day_2020_25(const std::vector<std::string> & lines, const DayExtraInfo &) {
     const auto keys = lines_transform::map<long long int>(lines, [](const std::string & s) { return std::stoll(s);});
 
@@ -35,7 +35,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2021 {
     &day_2021_21, &day_2021_22, &day_2021_23, &day_2021_24, &day_2021_25
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2021() {
+    return to_day_entries(days_2021);
+}
+#else
 int main(int argc, const char * argv[]) {
     run_aoc(days_2021, argc, argv);
     return 0;
 }
+#endif
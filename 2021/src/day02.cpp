@@ -2,6 +2,8 @@
 #include "../../util/instruction_reader.hpp"
 #include <numeric>
 
+namespace {
+
 enum class MovementType {
   Forward, Down, Up
 };
@@ -11,22 +13,21 @@ struct Movement {
   int qtt;
 };
 
+}
+
 Output day_2021_02(const std::vector<std::string> & lines, const DayExtraInfo &) {
   bj::InstructionReader<Movement> converter;
 
-  converter.add_handler(
-    R"(forward ([0-9]+))",
-    [](const std::vector<std::string> & values) -> Movement { return { MovementType::Forward, std::stoi(values[0]) }; }
+  converter.add_handler<"forward {digits}">(
+    [](int qtt) -> Movement { return { MovementType::Forward, qtt }; }
   );
 
-  converter.add_handler(
-    R"(down ([0-9]+))",
-    [](const std::vector<std::string> & values) -> Movement { return { MovementType::Down, std::stoi(values[0]) }; }
+  converter.add_handler<"down {digits}">(
+    [](int qtt) -> Movement { return { MovementType::Down, qtt }; }
   );
   
-  converter.add_handler(
-    R"(up ([0-9]+))",
-    [](const std::vector<std::string> & values) -> Movement { return { MovementType::Up, std::stoi(values[0]) }; }
+  converter.add_handler<"up {digits}">(
+    [](int qtt) -> Movement { return { MovementType::Up, qtt }; }
   );
 
   const auto instructions = converter(lines).value();
@@ -3,6 +3,8 @@
 #include <optional>
 #include <array>
 
+namespace {
+
 /**
  * A bingo grid
  */
@@ -65,6 +67,8 @@ struct Grid {
   }
 };
 
+}
+
 /**
  * Converts a string to a list of integers
  */
@@ -14,6 +14,8 @@
 // part a: if we only consider straigh lines
 // part b: if we consider all lines
 
+namespace {
+
 /** A line defined from two positions */
 struct DrawLine {
   bj::Position from;
@@ -24,11 +26,10 @@ struct DrawLine {
 static std::vector<DrawLine> read_input(const std::vector<std::string> & lines) {
   bj::InstructionReader<DrawLine> reader;
 
-  reader.add_handler(
-    R"(([0-9]+),([0-9]+) -> ([0-9]+),([0-9]+))",
-    [](const std::vector<std::string> & values) -> DrawLine {
-      const bj::Position top_left = { std::stoi(values[0]), std::stoi(values[1]) };
-      const bj::Position bottom_right = { std::stoi(values[2]), std::stoi(values[3]) };
+  reader.add_handler<"{digits},{digits} -> {digits},{digits}">(
+    [](int x1, int y1, int x2, int y2) -> DrawLine {
+      const bj::Position top_left = { x1, y1 };
+      const bj::Position bottom_right = { x2, y2 };
       return { top_left, bottom_right };
     }
   );
@@ -55,6 +56,8 @@ void for_all_points_between(bj::Position from, bj::Position to, Callable callabl
   callable(i, is_straight);
 }
 
+}
+
 /**
  * Solves the problem using an approach with std::map.
  * 
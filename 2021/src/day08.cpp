@@ -9,6 +9,8 @@
 // We use the fact that in each line, every number is sent.
 // word = set of segments
 
+namespace {
+
 /** Return true if all letters in lhs are contained in rhs*/
 static bool lhs_is_in_rhs(const std::string & lhs, const std::string & rhs) {
   if (lhs.size() >= rhs.size()) {
@@ -165,6 +167,8 @@ private:
   }
 };
 
+}
+
 Output day_2021_08(const std::vector<std::string> & lines, const DayExtraInfo &) {
   long long int part_a = 0;
   long long int part_b = 0;
@@ -9,6 +9,8 @@
 // https://adventofcode.com/2021/day/9
 
 
+namespace {
+
 long long int bassin_size(const std::vector<std::string> & lines, int col, int row) {
   const auto get = [&](int r, int c) -> int {
     if (r < 0) return 9;
@@ -47,6 +49,8 @@ long long int bassin_size(const std::vector<std::string> & lines, int col, int r
   return positions.size();
 }
 
+}
+
 Output day_2021_09(const std::vector<std::string> & lines, const DayExtraInfo &) {
   long long int part_a = 0;
 
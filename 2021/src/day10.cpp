@@ -6,8 +6,12 @@
 
 // https://adventofcode.com/2021/day/10
 
+namespace {
+
 enum class Type { Opening, Closing };
 
+}
+
 static std::tuple<Type, char, int> get_operation(char c) {
   if (c == '(') return std::tuple(Type::Opening, ')', 3);
   if (c == ')') return std::tuple(Type::Closing, ')', 3);
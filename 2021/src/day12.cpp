@@ -5,6 +5,8 @@
 
 // https://adventofcode.com/2021/day/12
 
+namespace {
+
 /** Returns true if c is an uppercase character */
 static bool is_uppercase(char c) {
   return c >= 'A' && c <= 'Z';
@@ -106,6 +108,8 @@ struct Explorations {
   }
 };
 
+}
+
 /** Transform the input into a list of caves */
 static std::vector<Cave> build_network(const std::vector<std::string> & lines) {
   // Read list of caves + connections
@@ -10,6 +10,8 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
 enum class Axis { x, y };
 
 struct FoldInstruction {
@@ -17,6 +19,8 @@ struct FoldInstruction {
   int line;
 };
 
+}
+
 /** Transforms the given list of strings into a list of dots */
 static std::set<bj::Position> read_initial_dots(
   const std::vector<std::string>::const_iterator begin,
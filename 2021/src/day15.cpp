@@ -1,13 +1,14 @@
 #include "../../common/advent_of_code.hpp"
 #include <algorithm>
-#include <set>
 #include <vector>
-#include <map>
 #include <array>
 #include "../../util/position.hpp"
+#include "../../util/graph_search.hpp"
 
 // https://adventofcode.com/2021/day/15
 
+namespace {
+
 struct Grid {
   std::vector<int> danger_level;
   int width;
@@ -49,41 +50,26 @@ struct Grid {
   [[nodiscard]] long long int compute_danger() const;
 };
 
-static bool next_step(std::vector<std::optional<int>> & total_danger, const Grid & grid) {
-  bool stable = true;
-
-  for (int x = 0; x != grid.width; ++x) {
-    for (int y = 0; y != grid.height; ++y) {
-      if (!total_danger[x + y * grid.width].has_value()) continue;
-
-      const auto my_score = total_danger[x + y * grid.width].value();
-
-      bj::Position{ x, y }.for_each_neighbour([&](bj::Position neighbour) {
-        const auto dangerosity_here = grid[neighbour];
-        if (!dangerosity_here) return;
-
-        const auto dangerosity_to_reach = my_score + dangerosity_here.value();
-
-        auto & current_known = total_danger[neighbour.x + neighbour.y * grid.width];
-
-        if (!current_known || current_known.value() > dangerosity_to_reach) {
-          current_known = dangerosity_to_reach;
-          stable = false;
-        }
+long long int Grid::compute_danger() const {
+  // The danger levels are 1 to 9, so the frontier is a bucket queue
+  const bj::graph::GridSpace space { width, height };
+  const bj::Position exit { width - 1, height - 1 };
+
+  const auto result = bj::graph::dijkstra(
+    space, bj::Position{ 0, 0 },
+    [&](bj::Position position, auto emit) {
+      position.for_each_neighbour([&](bj::Position neighbour) {
+        const auto dangerosity_here = (*this)[neighbour];
+        if (dangerosity_here) emit(neighbour, dangerosity_here.value());
       });
-    }
-  }
+    },
+    [&](bj::Position position) { return position == exit; },
+    bj::graph::SearchOptions<int>{ .max_weight = 9 }
+  );
 
-  return stable;
+  return result.target_distance().value();
 }
 
-long long int Grid::compute_danger() const {
-  std::vector<std::optional<int>> total_danger(danger_level.size(), std::nullopt);
-  total_danger[0] = 0;
-
-  while (!next_step(total_danger, *this)) {}
-
-  return total_danger[total_danger.size() - 1].value();
 }
 
 Output day_2021_15(const std::vector<std::string> & lines, const DayExtraInfo &) {
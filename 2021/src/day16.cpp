@@ -7,6 +7,8 @@
 // (I already did packet / binary decoding 3 times, and all these times
 // I didn't have access to a proper complete documentation)
 
+namespace {
+
 /** Converts an hexadecimal-format string into a sequence of bits */
 std::vector<bool> to_bits(const std::string & line) {
   std::vector<bool> res;
@@ -169,6 +171,8 @@ struct Packet {
   }
 };
 
+}
+
 
 Output day_2021_16(const std::vector<std::string> & lines, const DayExtraInfo &) {
   // More accurate input
@@ -5,6 +5,8 @@
 
 // https://adventofcode.com/2021/day/17
 
+namespace {
+
 static bool is_in(int point1d, int min, int max) {
   return point1d >= min && point1d <= max;
 }
@@ -24,6 +26,8 @@ struct TargetArea {
   }
 };
 
+}
+
 static std::optional<long long int> throw_ball(int x_velocity, int y_velocity, TargetArea target) {
   int x = 0;
   int y = 0;
@@ -6,6 +6,8 @@
 
 // https://adventofcode.com/2021/day/18
 
+namespace {
+
 enum class SnailfishType { SingleValue, Embedded };
 
 struct Snailfish;
@@ -142,6 +144,8 @@ bool LinedSnailCombiner::split() {
   return false;
 }
 
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -10,6 +10,8 @@
 #include <cstring>
 #include <ostream>
 
+namespace {
+
 struct Position : std::array<long long int, 3> {
   long long int & x() { return (*this)[0]; }
   long long int & y() { return (*this)[1]; }
@@ -246,6 +248,8 @@ struct KnownBeacons {
   }
 };
 
+}
+
 
 Output day_2021_19(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   std::vector<Scanner> scanners;
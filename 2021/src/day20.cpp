@@ -1,13 +1,13 @@
 #include "../../common/advent_of_code.hpp"
 #include <vector>
-#include <map>
-#include <set>
-#include <ostream>
-#include "../../util/position.hpp"
+#include <span>
+#include "../../util/grid.hpp"
 
 // Day 17 was boring, days 18 and 19 were too long, today is
 // "I'm very smart with my non representative only example"
 
+namespace {
+
 static std::vector<bool> compute_enchancement(const std::string & s) {
   std::vector<bool> r;
   for (const char c : s) {
@@ -16,90 +16,60 @@ static std::vector<bool> compute_enchancement(const std::string & s) {
   return r;
 }
 
-struct Grid {
-  std::map<bj::Position, bool> pixels;
-  bool padding;
+/** The image, with a border of two pixels that have the value of the infinite outside */
+struct Image {
+  bj::Grid<char> pixels;
+  char outside;
   const std::vector<bool> * enhancement;
 
-  Grid(const std::vector<bool> * enhancement, std::set<bj::Position> lit)
-  : padding(false), enhancement(enhancement) {
-    for (const auto & position : lit) {
-      pixels.emplace(position, true);
-    }
-  }
+  Image(const std::vector<bool> * enhancement, bj::Grid<char> pixels)
+  : pixels(std::move(pixels)), outside(0), enhancement(enhancement) {}
+
+  [[nodiscard]] Image next() const {
+    const char next_outside = outside ? enhancement->back() : enhancement->front();
 
-  Grid next() const {
-    Grid n;
-    n.enhancement = enhancement;
-    n.padding = padding ? enhancement->back() : enhancement->front();
+    // The image grows by one pixel on each side
+    Image n(enhancement, bj::Grid<char>(pixels.width() + 2, pixels.height() + 2, 0, 2, next_outside));
+    n.outside = next_outside;
 
-    const auto consider = [&](bj::Position pos) {
+    for (const bj::Position position : n.pixels.positions()) {
       int enhance_code = 0;
-      for (int dy = -1; dy <= 1; ++dy) {
-        for (int dx = -1; dx <= 1; ++dx) {
-          enhance_code = enhance_code * 2;
-          
-          auto it = pixels.find(bj::Position{ pos.x + dx, pos.y + dy });
-          bool is_lit;
-          if (it == pixels.end()) {
-            is_lit = padding;
-          } else {
-            is_lit = it->second;
-          }
-
-          if (is_lit) {
-            enhance_code += 1;
-          }
+      for (int dy = -2; dy <= 0; ++dy) {
+        for (int dx = -2; dx <= 0; ++dx) {
+          enhance_code = enhance_code * 2 + pixels[bj::Position{ position.x + dx, position.y + dy }];
         }
       }
 
-      bool will_be_lit = (*enhancement)[enhance_code];
-
-      if (n.padding || will_be_lit) n.pixels.emplace(pos, will_be_lit);
-    };
-
-    for (const auto & [position, is_lit] : pixels) {
-      consider(position);
-
-      for (const auto & neighbour : position.get_8_neighbours()) {
-        consider(neighbour);
-      }
+      n.pixels[position] = (*enhancement)[enhance_code];
     }
 
     return n;
   }
 
-
-private:
-  Grid() = default;
+  [[nodiscard]] size_t lit() const { return pixels.count(1); }
 };
 
+}
+
 Output day_2021_20(const std::vector<std::string> & lines, const DayExtraInfo &) {
   std::vector<bool> image_enhancement = compute_enchancement(lines[0]);
 
-  std::set<bj::Position> origin;
-
-  for (size_t line = 0; line + 2 != lines.size(); ++line) {
-    for (size_t col = 0; col != lines[line + 2].size(); ++col) {
-      if (lines[line + 2][col] == '#') {
-        origin.emplace(bj::Position{ int(col), int(line) });
-      }
-    }
-  }
-
-  Grid grid(&image_enhancement, origin);
+  const std::span<const std::string> image_lines(lines.begin() + 2, lines.end());
+  Image image(&image_enhancement,
+    bj::Grid<char>::from_lines(image_lines, [](char c) -> char { return c == '#'; }, 2, 0)
+  );
 
   for (int i = 0; i != 2; ++i) {
-    grid = grid.next();
+    image = image.next();
   }
 
-  const long long int part_a = grid.pixels.size();
+  const long long int part_a = image.lit();
 
   for (int i = 2; i != 50; ++i) {
-    grid = grid.next();
+    image = image.next();
   }
 
-  const long long int part_b = grid.pixels.size();
+  const long long int part_b = image.lit();
 
   return Output(part_a, part_b);
 }
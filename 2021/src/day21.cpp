@@ -3,6 +3,8 @@
 #include <unordered_map>
 #include <tuple>
 
+namespace {
+
 struct Config {
   int myScore;
   int hisScore;
@@ -25,6 +27,8 @@ struct Config {
   }
 };
 
+}
+
 namespace std {
   template <> struct hash<Config> {
     size_t operator()(const Config & x) const {
@@ -1,5 +1,5 @@
 #include "../../common/advent_of_code.hpp"
-#include <regex>
+#include "../../util/pattern.hpp"
 #include <vector>
 #include <unordered_map>
 #include <map>
@@ -307,39 +307,34 @@ struct HitTheLights {
 ////////////////////////////////////////////////////////////////////////////////
 // ==== Hello
 
-Output day_2021_22(const std::vector<std::string> & lines, const DayExtraInfo &) {
+Output day_2021_22(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   // ==== Parsing
-  const std::regex regex(R"((on|off) x=(-?[0-9]+)\.\.(-?[0-9]+),y=(-?[0-9]+)\.\.(-?[0-9]+),z=(-?[0-9]+)\.\.(-?[0-9]+))");
-  std::smatch matches;
+  using Pattern = bj::Pattern<"{on|off} x={int}..{int},y={int}..{int},z={int}..{int}">;
 
   std::vector<Instruction> instructions;
   for (const auto & line : lines) {
     if (line == "") continue;
 
-    if (!std::regex_search(line, matches, regex)) {
+    const auto captures = Pattern::match(line);
+    if (!captures) {
       std::cerr << "Error on reading " << line << '\n';
       continue;
     }
 
+    const auto [state, x1, x2, y1, y2, z1, z2] = *captures;
+
     Cuboid<int> cube = Cuboid<int>{
-      Point3D<int> {
-        std::stoi(matches[2].str()),
-        std::stoi(matches[4].str()),
-        std::stoi(matches[6].str()),
-      },
-      
-      Point3D<int> {
-        std::stoi(matches[3].str()) + 1,
-        std::stoi(matches[5].str()) + 1,
-        std::stoi(matches[7].str()) + 1,
-      }
+      Point3D<int> { x1, y1, z1 },
+      Point3D<int> { x2 + 1, y2 + 1, z2 + 1 }
     };
 
-    instructions.push_back(Instruction{ matches[1] == "on", { cube } });
+    instructions.push_back(Instruction{ state == 0, { cube } });
   }
 
   // ==== Run
+  dei.start_phase(test::Phase::PartA);
   const long long int init = HelloDarkness::my_old_friend(instructions);
+  dei.start_phase(test::Phase::PartB);
   const long long int reload = HitTheLights::let_the_music_move_you(instructions);
 
   return Output(init, reload);
@@ -15,9 +15,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
 enum class IType { imp, add, mul, div, mod, eql };
 
-IType to_type(const std::string & s) {
+IType to_type(std::string_view s) {
   if (s == "inp") return IType::imp;
   if (s == "add") return IType::add;
   if (s == "mul") return IType::mul;
@@ -69,6 +71,8 @@ struct RAMState {
   }
 };
 
+}
+
 
 namespace std {
   template <> struct hash<RAMState> {
@@ -81,6 +85,8 @@ namespace std {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
 struct Instruction {
   IType type;
 
@@ -90,21 +96,21 @@ struct Instruction {
   long long int int_value = 0;
   char variable_2 = '0';
 
-  Instruction(std::string c) {
+  explicit Instruction(char c) {
     type = IType::imp;
-    variable = c[0];
+    variable = c;
   }
 
-  Instruction(std::string type_, const std::string & dest, const std::string & src) {
+  Instruction(std::string_view type_, char dest, char src) {
     type = to_type(type_);
-    variable = dest[0];
+    variable = dest;
     is_int = false;
-    variable_2 = src[0];
+    variable_2 = src;
   }
 
-  Instruction(std::string type_, const std::string & dest, int val) {
+  Instruction(std::string_view type_, char dest, int val) {
     type = to_type(type_);
-    variable = dest[0];
+    variable = dest;
     is_int = true;
     int_value = val;
   }
@@ -263,25 +269,26 @@ struct Memory {
   }
 };
 
+}
+
 static std::vector<Instruction> read_input(const std::vector<std::string> & lines) {
   bj::InstructionReader<Instruction> ir;
 
-  ir.add_handler(R"(inp ([a-z]))",
-    [](const std::vector<std::string> & strs) {
-      return Instruction(strs[0]);
+  ir.add_handler<"inp {char}">(
+    [](char variable) {
+      return Instruction(variable);
     }
   );
 
-  ir.add_handler(R"(([a-z]+) ([a-z]) (-?[0-9]+))",
-    [](const std::vector<std::string> & strs) {
-      return Instruction(strs[0], strs[1], std::stoi(strs[2]));
+  ir.add_handler<"{word} {char} {int}">(
+    [](std::string_view type, char dest, int value) {
+      return Instruction(type, dest, value);
     }
   );
 
-  ir.add_handler(
-    R"(([a-z]+) ([a-z]) ([a-z]))",
-    [](const std::vector<std::string> & strs) {
-      return Instruction(strs[0], strs[1], strs[2]);
+  ir.add_handler<"{word} {char} {char}">(
+    [](std::string_view type, char dest, char src) {
+      return Instruction(type, dest, src);
     }
   );
 
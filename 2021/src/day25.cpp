@@ -13,6 +13,8 @@
 // https://adventofcode.com/2021/day/25
 
 
+namespace {
+
 enum class Cucumber { None, Down, Right };
 
 struct CucumberPosition { size_t x; size_t y; };
@@ -105,6 +107,8 @@ struct Grid {
   }
 };
 
+}
+
 Output day_2021_25(const std::vector<std::string> & lines, const DayExtraInfo &) {
   Grid grid = Grid(lines);
 
@@ -35,7 +35,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2022 {
     &day_2022_21, &day_2022_22, &day_2022_23, &day_2022_24, &day_2022_25
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2022() {
+    return to_day_entries(days_2022);
+}
+#else
 int main(int argc, const char * argv[]) {
     run_aoc(days_2022, argc, argv);
     return 0;
 }
+#endif
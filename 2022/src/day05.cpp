@@ -1,9 +1,8 @@
 #include "../../common/advent_of_code.hpp"
-#include "../../util/regex_helper.hpp"
+#include "../../util/pattern.hpp"
 #include <vector>
 #include <set>
 #include <span>
-#include <regex>
 #include <ranges>
 
 // https://adventofcode.com/2022/day/5
@@ -91,16 +90,9 @@ Output day_2022_05(const std::vector<std::string> & lines, const DayExtraInfo &)
 
 
   // == Compute and run instructions 
-  std::regex regex_ { R"(move ([0-9]*) from ([0-9]*) to ([0-9]*))" };
-  std::smatch smatch;
-
   const auto instructions_start = std::find(lines.begin(), lines.end(), "") + 1;
   for (auto it = instructions_start; it != lines.end(); ++it) {
-    std::regex_search(*it, smatch, regex_);
-
-    const int quantity = std::stoi(smatch[1].str());
-    const int from     = std::stoi(smatch[2].str());
-    const int to       = std::stoi(smatch[3].str());
+    const auto [quantity, from, to] = bj::Pattern<"move {digits} from {digits} to {digits}">::match(*it).value();
 
     stacks_elves[from].elve_move     (stacks_elves[to], quantity);
     stacks_crane[from].cranelift_move(stacks_crane[to], quantity);
@@ -5,6 +5,8 @@
 // https://adventofcode.com/2022/day/6
 // Find the first position where the n previous characters are distinct
 
+namespace {
+
 template<size_t PrefixSize>
 [[nodiscard]] size_t find_end_of_start_of_message(const std::string & line) {
   if (line.size() < PrefixSize) return static_cast<size_t>(-1);
@@ -36,6 +38,8 @@ template<size_t PrefixSize>
   return static_cast<size_t>(-1);
 }
 
+}
+
 Output day_2022_06(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   return Output(
     dei.can_skip_part_A ? 0 : find_end_of_start_of_message< 4>(lines[0]),
@@ -12,6 +12,8 @@
 // (B) Find the smallest folder whose size is at least something
 
 
+namespace {
+
 // A folder
 class Folder {
   // The content of a folder = association from names to folder|file
@@ -132,6 +134,8 @@ public:
   }
 };
 
+}
+
 
 Output day_2022_07(const std::vector<std::string> & lines, const DayExtraInfo &) {
   Folder root(nullptr);
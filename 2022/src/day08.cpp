@@ -15,6 +15,8 @@
 // (b) Find the maximum scenic score.
 //     scenic score = product of how many trees can be seen for each direction.
 
+namespace {
+
 // The forest
 struct Grid {
 public:
@@ -135,6 +137,8 @@ public:
   }
 };
 
+}
+
 
 Output day_2022_08(const std::vector<std::string> & lines, const DayExtraInfo &) {
   const Grid grid = Grid(lines);
@@ -2,6 +2,8 @@
 
 // https://adventofcode.com/2022/day/10
 
+namespace {
+
 class CathodeRay_Tube {
 private:
   int cycle_number = 1;
@@ -41,6 +43,8 @@ public:
   }
 };
 
+}
+
 Output day_2022_10(const std::vector<std::string> & lines, const DayExtraInfo &) {
   CathodeRay_Tube tube;
   
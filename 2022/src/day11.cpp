@@ -9,6 +9,8 @@
 
 // https://adventofcode.com/2022/day/11
 
+namespace {
+
 using Item = unsigned long long int;
 
 enum class Operator { Plus, Times };
@@ -206,6 +208,8 @@ Monkey::Monkey(std::smatch regex_match)
   }
 }
 
+}
+
 Output day_2022_11(const std::vector<std::string> & lines, const DayExtraInfo &) {
   const std::vector<Monkey> monkeys = Monkey::read_monkeys(lines);
 
@@ -1,10 +1,9 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
+#include "../../util/graph_search.hpp"
 #include <concepts>
 #include <exception>
 #include <optional>
-#include <queue>
-#include <set>
 
 
 // https://adventofcode.com/2022/day/12
@@ -58,40 +57,25 @@ std::optional<std::uint64_t> Grid::go_to(
   is_final_position is_final_position_,
   can_go_on can_go_on_
 ) const {
-  std::set<bj::Position> visited;
-  std::queue<std::pair<bj::Position, std::uint64_t>> next_values;
+  const auto result = bj::graph::bfs(
+    bj::graph::GridSpace::of(*lines), from,
+    [&](bj::Position pos, auto emit) {
+      const char my_elevation = elevation_at(pos);
 
-  next_values.emplace(from, 0);
-  visited.emplace(from);
+      pos.for_each_neighbour([&](bj::Position neighbour) {
+        if (is_out_of_bound(neighbour)) return;
 
-  std::optional<std::uint64_t> result = std::nullopt;
-
-  while (!result && !next_values.empty()) {
-    const auto [pos, steps] = next_values.front();
-    next_values.pop();
-
-    const char my_elevation = elevation_at(pos);
-
-    pos.for_each_neighbour([&](bj::Position neighbour) {
-      if (result) return;
-      if (is_out_of_bound(neighbour)) return;
-      if (visited.contains(neighbour)) return;
-      
-      const char neighbour_elevation = elevation_at(neighbour);
-
-      if (can_go_on_(normalize(my_elevation), normalize(neighbour_elevation))) {
-        if (is_final_position_(neighbour_elevation)) {
-          result = steps + 1;
-          return;
+        if (can_go_on_(normalize(my_elevation), normalize(elevation_at(neighbour)))) {
+          emit(neighbour);
         }
+      });
+    },
+    [&](bj::Position pos) { return is_final_position_(elevation_at(pos)); }
+  );
 
-        next_values.emplace(neighbour, steps + 1);
-        visited.emplace(neighbour);
-      }
-    });
-  }
-
-  return result;
+  const auto steps = result.target_distance();
+  if (!steps) return std::nullopt;
+  return static_cast<std::uint64_t>(*steps);
 }
 
 }
@@ -1,13 +1,15 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
+#include "../../util/flat_hash.hpp"
 #include <ranges>
-#include <map>
 
 // https://adventofcode.com/2022/day/14
 
+namespace {
+
 class Grid {
 private:
-  std::map<bj::Position, char> m_grid;
+  bj::FlatMap<bj::Position, char> m_grid;
   int m_ceiling = 2;
   bool ceiling_is_hard = false;
 
@@ -82,6 +84,8 @@ unsigned int Grid::drop_until_stability() {
   return bj::Position{ std::stoi(str.substr(0, pos)), std::stoi(str.substr(pos + 1)) };
 }
 
+}
+
 Output day_2022_14(const std::vector<std::string> & lines, const DayExtraInfo &) {
   Grid grid;
 
@@ -1,13 +1,14 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
 #include <cmath>
-#include <map>
-#include <ranges>
-#include <regex>
+#include "../../util/pattern.hpp"
+#include "../../util/interval_set.hpp"
 #include <stdexcept>
 
 // https://adventofcode.com/2022/day/15
 
+namespace {
+
 static int man_distance(const bj::Position p1, const bj::Position p2) {
   const int xDiff = std::abs(p1.x - p2.x);
   const int yDiff = std::abs(p1.y - p2.y);
@@ -26,47 +27,32 @@ struct Scanner {
   }
 };
 
-static size_t part_a(const std::vector<Scanner> & scanners, int scanned_y) {
-  enum class SlotStatus { Scanner, Beacon, Scanned };
-
-  std::map<int, SlotStatus> status;
-
-  // Place scanner and beacon
-  for (const auto & pair : scanners) {
-    if (pair.scanner.y == scanned_y) {
-      status[pair.scanner.x] = SlotStatus::Scanner;
-    }
+}
 
-    if (pair.nearest_beacon.y == scanned_y) {
-      status[pair.nearest_beacon.x] = SlotStatus::Beacon;
-    }
-  }
+// The positions of the row seen by a scanner are an interval, so the row is
+// the union of the intervals of the scanners, minus the known beacons
+static size_t part_a(const std::vector<Scanner> & scanners, int scanned_y) {
+  std::vector<bj::Interval<int>> scanned;
+  std::vector<bj::Interval<int>> beacons;
 
-  // scan points in the rectangle of each scanner-beacon pairs
   for (const auto & scanner_pair : scanners) {
     const auto & scanner = scanner_pair.scanner;
-    const int distance_to_scanline = std::abs(scanner_pair.scanner.y - scanned_y);
-    const int distance_to_beacon = scanner_pair.get_distance_to_beacon();
-
-    /* optimization line */ if (distance_to_scanline > distance_to_beacon) continue;
-
-    for (int dx = -distance_to_beacon; dx <= distance_to_beacon; ++dx) {
-      bj::Position scanned_point { scanner.x + dx, scanned_y };
-
-      if (man_distance(scanner, scanned_point) > distance_to_beacon) continue;
+    const int distance_to_scanline = std::abs(scanner.y - scanned_y);
+    const int remaining = scanner_pair.get_distance_to_beacon() - distance_to_scanline;
 
-      status.try_emplace(scanned_point.x, SlotStatus::Scanned);
+    if (remaining >= 0) {
+      scanned.emplace_back(bj::Interval<int>::closed(scanner.x - remaining, scanner.x + remaining));
     }
-  }
 
-  // Only count points where there are no beacons
-  size_t answer = 0;
-  for (const SlotStatus status_1 : status | std::views::values) {
-    if (status_1 != SlotStatus::Beacon) {
-      ++answer;
+    if (scanner_pair.nearest_beacon.y == scanned_y) {
+      beacons.emplace_back(bj::Interval<int>::closed(scanner_pair.nearest_beacon.x, scanner_pair.nearest_beacon.x));
     }
   }
-  return answer;
+
+  const bj::IntervalSet<int> no_beacon
+    = bj::IntervalSet<int>(std::move(scanned)) - bj::IntervalSet<int>(std::move(beacons));
+
+  return static_cast<size_t>(no_beacon.size());
 }
 
 static bool is_scanned_point(const std::vector<Scanner> & scanners, const bj::Position point) {
@@ -111,33 +97,29 @@ static bj::Position part_b(const std::vector<Scanner> & scanners, int max) {
   return bj::Position{0, 0};
 } 
 
-Output day_2022_15(const std::vector<std::string> & lines, const DayExtraInfo &) {
+Output day_2022_15(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   std::vector<Scanner> scanners;
 
-  const char * regex = R"(Sensor at x=(-?\d+), y=(-?\d+): closest beacon is at x=(-?\d+), y=(-?\d+))";
-  std::regex regex_ { regex };
-  std::smatch smatch_;
+  using Pattern = bj::Pattern<"Sensor at x={int}, y={int}: closest beacon is at x={int}, y={int}">;
 
   for (const std::string & line : lines) {
-    if (!std::regex_search(line, smatch_, regex_)) {
+    const auto captures = Pattern::match(line);
+    if (!captures) {
       throw std::runtime_error("bad input");
     }
 
+    const auto [sensor_x, sensor_y, beacon_x, beacon_y] = *captures;
     scanners.emplace_back(
-      bj::Position{
-        std::stoi(smatch_[1].str()),
-        std::stoi(smatch_[2].str())
-      },
-      bj::Position{
-        std::stoi(smatch_[3].str()),
-        std::stoi(smatch_[4].str())
-      }
+      bj::Position{ sensor_x, sensor_y },
+      bj::Position{ beacon_x, beacon_y }
     );
   }
 
   const bool is_example = scanners.size() == 14;
 
+  dei.start_phase(test::Phase::PartA);
   const auto part_a_res = part_a(scanners, is_example ? 10 : 2000000);
+  dei.start_phase(test::Phase::PartB);
   const auto part_b_almost_res = part_b(scanners, is_example ? 20 : 4000000);
   const std::uint64_t part_b_res = part_b_almost_res.x * std::uint64_t(4000000) + part_b_almost_res.y;
 
@@ -4,7 +4,7 @@
 #include <map>
 #include <chrono>
 #include <ranges>
-#include <regex>
+#include "../../util/pattern.hpp"
 #include <stdexcept>
 #include <set>
 #include <list>
@@ -55,8 +55,7 @@ public:
 };
 
 Valves::Valves(const std::vector<std::string> & lines) {
-  std::regex regex_ { R"(Valve ([A-Z][A-Z]) has flow rate=(\d+); tunnels? leads? to valves? (.*))"};
-  std::smatch smatch_;
+  using Pattern = bj::Pattern<"Valve {word} has flow rate={digits}; {tunnels lead to valves|tunnel leads to valve} {str}">;
 
   m_valves.reserve(lines.size());
 
@@ -71,28 +70,29 @@ Valves::Valves(const std::vector<std::string> & lines) {
 
   // Put non empty flow_rate first
   for (const auto & line : lines) {
-    if (!std::regex_search(line, smatch_, regex_)) {
+    const auto captures = Pattern::match(line);
+    if (!captures) {
       throw std::runtime_error(":(");
     }
 
-    const int flow_rate = std::stoi(smatch_[2].str());
+    const auto & [name, flow_rate, _, next] = *captures;
     if (flow_rate != 0) {
-      const std::string str_name = smatch_[1].str();
-      create_or_get_valve(str_name);
+      create_or_get_valve(std::string(name));
     }
   }
 
   // Ok, read tunnels and put empty tunnels
   for (const auto & line : lines) {
-    if (!std::regex_search(line, smatch_, regex_)) {
+    const auto captures = Pattern::match(line);
+    if (!captures) {
       throw std::runtime_error(":(");
     }
 
-    const std::string str_name = smatch_[1].str();
-    Valve * ptrValve = create_or_get_valve(str_name);
+    const auto & [name, flow_rate, _, next] = *captures;
+    Valve * ptrValve = create_or_get_valve(std::string(name));
 
-    ptrValve->flow_rate = std::stoi(smatch_[2].str());
-    std::vector<std::string> next_name = bj::string_split(smatch_[3].str(), ", ");
+    ptrValve->flow_rate = flow_rate;
+    std::vector<std::string> next_name = bj::string_split(std::string(next), ", ");
     for (const auto & name : next_name) {
       create_or_get_valve(name);
       ptrValve->lead_to.add(get_id_of(name));
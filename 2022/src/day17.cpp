@@ -15,6 +15,8 @@
 
 // https://adventofcode.com/2022/day/17
 
+namespace {
+
 static constexpr size_t LastLines = 5;
 
 struct Grid {
@@ -232,6 +234,8 @@ public:
   void add_fake_rocks(long long int nb) { present_rocks.number_of_rocks += nb; }
 };
 
+}
+
 
 
 Output day_2022_17(const std::vector<std::string> & lines, const DayExtraInfo &) {
@@ -5,6 +5,7 @@
 #include "../../util/position.hpp"
 // https://adventofcode.com/2022/day/22
 
+namespace {
 
 struct Grid;
 
@@ -271,7 +272,7 @@ int Grid::run_instructions(std::string instructions) const {
   return current_pos.get_score();
 }
 
-
+}
 
 Output day_2022_22(const std::vector<std::string> & lines, const DayExtraInfo &) {
   std::vector<std::string> grid_lines = lines;
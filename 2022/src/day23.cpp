@@ -1,9 +1,8 @@
 #include "../../common/advent_of_code.hpp"
 #include <algorithm>
-#include <map>
 #include <vector>
 #include "../../util/position.hpp"
-#include <set>
+#include "../../util/flat_hash.hpp"
 #include <span>
 #include <array>
 
@@ -11,10 +10,10 @@
 
 namespace {
 
-using Propositions = std::map<bj::Position, bad_static_vector<bj::Position, 4>>;
+using Propositions = bj::FlatMap<bj::Position, bad_static_vector<bj::Position, 4>>;
 
 struct ElvesInAVolcano {
-  std::set<bj::Position> elves;
+  bj::FlatSet<bj::Position> elves;
 
   bool run_a_round(size_t round_id);
 
@@ -144,7 +143,7 @@ void ElvesInAVolcano::draw_grid() {
 }
 
 Output day_2022_23(const std::vector<std::string> & lines, const DayExtraInfo &) {
-  std::set<bj::Position> elves;
+  bj::FlatSet<bj::Position> elves;
 
   for (size_t y = 0; y != lines.size(); ++y) {
     const std::string & line = lines[y];
@@ -1,13 +1,14 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
+#include "../../util/graph_search.hpp"
 #include <array>
 #include <bitset>
-#include <queue>
-#include <unordered_map>
 #include <vector>
 
 // https://adventofcode.com/2022/day/24
 
+namespace {
+
 // A blizzard situation
 struct Blizzard {
   static constexpr size_t dir_left = 0;
@@ -24,7 +25,6 @@ struct Blizzard {
   [[nodiscard]] bool operator==(const Blizzard & other) const { return blizzard == other.blizzard; }
 
   [[nodiscard]] bool is_blocked(bj::Position position) const;
-  [[nodiscard]] std::uint8_t compute_step(bj::Position position, std::uint8_t former_step) const;
 
   void print() const;
 
@@ -93,16 +93,6 @@ bool Blizzard::is_blocked(bj::Position position) const {
   return blizzard[position.y][position.x].any();
 }
 
-std::uint8_t Blizzard::compute_step(const bj::Position position, const std::uint8_t former_step) const {
-  if (former_step % 2 == 0) {
-    if (position == bj::Position{ width() - 1, height() }) return former_step + 1;
-    return former_step;
-  } else {
-    if (position == bj::Position{ 0, -1 }) return former_step + 1;
-    else return former_step;
-  }
-}
-
 void Blizzard::print() const {
   const int width_ = width();
   const int height_ = height();
@@ -147,27 +137,11 @@ void Blizzard::print() const {
 
 // All setup precomputations
 
-struct State {
+struct Expedition {
   bj::Position where;
   size_t blizzard_id;
-  std::uint8_t step;
-
-  State(bj::Position where, size_t blizzard_id, std::uint8_t step)
-    : where(where), blizzard_id(blizzard_id), step(step) {}
-
-  [[nodiscard]] bool operator==(const State & other) const noexcept {
-    return where == other.where && blizzard_id == other.blizzard_id && step == other.step;
-  }
 };
 
-namespace std {
-  template <> struct hash<State> {
-    std::size_t operator()(const State & state) const noexcept {
-      return state.where.x * 100000 + state.where.y * 1000 + state.blizzard_id * 5 + state.step;
-    }
-  };
-}
-
 struct Blizzards {
   std::vector<Blizzard> all_setups;
   int width;
@@ -175,7 +149,22 @@ struct Blizzards {
 
   explicit Blizzards(const std::vector<std::string> & lines);
 
-  [[nodiscard]] int distance_to_end(State state) const;
+  [[nodiscard]] bool is_legal_position(bj::Position position, const Blizzard & blizzard) const;
+
+  // The expedition is in the valley or in one of the two holes of the
+  // border, at some time in the period of the blizzards
+  using State = Expedition;
+
+  [[nodiscard]] size_t size() const noexcept {
+    return static_cast<size_t>(width) * static_cast<size_t>(height + 2) * all_setups.size();
+  }
+
+  [[nodiscard]] size_t index(const State & state) const noexcept {
+    return (state.blizzard_id * static_cast<size_t>(height + 2) + static_cast<size_t>(state.where.y + 1))
+      * static_cast<size_t>(width) + static_cast<size_t>(state.where.x);
+  }
+
+  [[nodiscard]] std::optional<size_t> walk(bj::Position from, bj::Position to, size_t start_time) const;
 };
 
 Blizzards::Blizzards(const std::vector<std::string> & lines) {
@@ -196,111 +185,65 @@ Blizzards::Blizzards(const std::vector<std::string> & lines) {
   }
 }
 
-int Blizzards::distance_to_end(const State state) const {
-  int added = (2 - state.step) * (width + height);
-
-  if (state.step % 2 == 0) {
-    return added + (width - 1 - state.where.x) + (height - state.where.y);
-  } else {
-    return added + (state.where.x + state.where.y + 1);
-  }
-}
-
-// DFS
-struct DFS {
-  static std::optional<size_t> run(const Blizzards & blizzards, size_t initial_step);
-
-private:
-  const Blizzards * blizzards;
-  std::unordered_map<State, size_t> visited;
-  std::queue<State> to_visit;
-
-  std::optional<size_t> best = std::nullopt;
-
-  DFS(const Blizzards & blizzards, size_t initial_step);
-
-  void visit_state();
-
-  void try_add(bj::Position where, size_t blizzard_setup, size_t walked, std::uint8_t step);
-
-  [[nodiscard]] static bool is_legal_position(const bj::Position position, const Blizzard & blizzard);
-};
-
-std::optional<size_t> DFS::run(const Blizzards & blizzards, size_t initial_step) {
-  DFS dfs(blizzards, initial_step);
-  
-  while (!dfs.to_visit.empty()) {
-    dfs.visit_state();
-  }
-
-  return dfs.best;
-}
-
-DFS::DFS(const Blizzards & blizzards, size_t initial_step) : blizzards(&blizzards) {
-  State state(bj::Position{ 0, -1 }, 0, initial_step);
-  to_visit.emplace(state);
-  visited.emplace(state, 0);
-}
-
-bool DFS::is_legal_position(const bj::Position position, const Blizzard & blizzard) {
-  if (position.y < -1 || position.y > blizzard.height()) return false;
-  if (position.x <= -1 || position.x >= blizzard.width()) return false;
+bool Blizzards::is_legal_position(const bj::Position position, const Blizzard & blizzard) const {
+  if (position.y < -1 || position.y > height) return false;
+  if (position.x <= -1 || position.x >= width) return false;
 
   if (position.y == -1) {
     return position.x == 0;
-  } else if (position.y == blizzard.height()) {
-    return position.x + 1 == blizzard.width();
+  } else if (position.y == height) {
+    return position.x + 1 == width;
   } else {
     return !blizzard.is_blocked(position);
   }
 }
 
-void DFS::visit_state() {
-  const auto state = to_visit.front();
-  const auto walked = visited.find(state)->second;
-  to_visit.pop();
-
-  if (best && blizzards->distance_to_end(state) + walked >= *best) return;
-
-  const size_t next_setup_id = (state.blizzard_id + 1) % blizzards->all_setups.size();
+// Returns the time to go from `from` to `to`, leaving at start_time
+std::optional<size_t> Blizzards::walk(bj::Position from, bj::Position to, size_t start_time) const {
+  const State start { from, start_time % all_setups.size() };
+
+  const auto result = bj::graph::bfs(
+    *this, start,
+    [&](const State & state, auto emit) {
+      const size_t next_setup_id = (state.blizzard_id + 1) % all_setups.size();
+      const Blizzard & blizzard = all_setups[next_setup_id];
+
+      std::array<bj::Position, 5> nexts;
+      nexts[0] = state.where; nexts[0].y += 1;
+      nexts[1] = state.where; nexts[1].x += 1;
+      nexts[2] = state.where;
+      nexts[3] = state.where; nexts[3].y -= 1;
+      nexts[4] = state.where; nexts[4].x -= 1;
+
+      for (const auto & next : nexts) {
+        if (is_legal_position(next, blizzard)) emit(State{ next, next_setup_id });
+      }
+    },
+    [&](const State & state) { return state.where == to; }
+  );
 
-  std::array<bj::Position, 5> nexts;
-  nexts[0] = state.where; nexts[0].y += 1;
-  nexts[1] = state.where; nexts[1].x += 1;
-  nexts[2] = state.where;
-  nexts[3] = state.where; nexts[3].y -= 1;
-  nexts[4] = state.where; nexts[4].x -= 1;
-  
-  for (const auto & next : nexts) {
-    try_add(next, next_setup_id, walked + 1, state.step);
-  }
+  const auto time = result.target_distance();
+  if (!time) return std::nullopt;
+  return static_cast<size_t>(*time);
 }
 
-void DFS::try_add(bj::Position where, size_t blizzard_setup, size_t walked, std::uint8_t step) {
-  const Blizzard & blizzard = blizzards->all_setups[blizzard_setup];
+}
 
-  if (!is_legal_position(where, blizzard)) return;
+// Ok
+Output day_2022_24(const std::vector<std::string> & lines, const DayExtraInfo &) {
+  const Blizzards blizzards(lines);
 
-  State state{ where, blizzard_setup, blizzard.compute_step(where, step) };
+  const bj::Position entrance { 0, -1 };
+  const bj::Position exit { blizzards.width - 1, blizzards.height };
 
-  const auto in_visited = visited.find(state);
-  if (in_visited != visited.end() && in_visited->second <= walked) return;
+  const auto there = blizzards.walk(entrance, exit, 0);
+  if (!there) return Output(-1, -1);
 
-  visited[state] = walked;
+  const auto back = blizzards.walk(exit, entrance, *there);
+  if (!back) return Output(*there, -1);
 
-  if (state.step == 3) {
-    best = walked;
-  } else {
-    to_visit.emplace(state);
-  }
-}
-
-// Ok
-Output day_2022_24(const std::vector<std::string> & lines, const DayExtraInfo &) {
-  Blizzards blizzards(lines);
+  const auto there_again = blizzards.walk(entrance, exit, *there + *back);
+  if (!there_again) return Output(*there, -1);
 
-  return Output(
-    DFS::run(blizzards, 2).value_or(-1),
-    DFS::run(blizzards, 0).value_or(-1)
-  );
+  return Output(*there, *there + *back + *there_again);
 }
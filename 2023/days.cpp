@@ -35,7 +35,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2023 {
   &day_2023_21, &day_2023_22, &day_2023_23, &day_2023_24, &day_2023_25
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2023() {
+  return to_day_entries(days_2023);
+}
+#else
 int main(int argc, const char * argv[]) {
   run_aoc(days_2023, argc, argv);
   return 0;
 }
+#endif
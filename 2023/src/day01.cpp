@@ -5,6 +5,8 @@
 
 // https://adventofcode.com/2023/day/1
 
+namespace {
+
 // Read the first and the last digit in a string
 static int get_calibration_simple(const std::string & line) {
   int first = -1;
@@ -89,6 +91,8 @@ int get_calibration_complicated(std::string line, const Digits2Digits & good_ord
   return first_digit * 10 + second_digit;
 }
 
+}
+
 
 Output day_2023_01(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   int part_a = 0;
@@ -9,6 +9,8 @@
 
 // https://adventofcode.com/2023/day/2
 
+namespace {
+
 struct SetOfCubes {
   std::map<std::string, int> cubes;
 
@@ -80,6 +82,8 @@ Game::Game(const std::string & line) {
   }
 }
 
+}
+
 
 Output day_2023_02(const std::vector<std::string> & lines, const DayExtraInfo &) {
   SetOfCubes reference_cubes = SetOfCubes::GetElfCubes();
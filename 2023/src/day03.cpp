@@ -5,6 +5,8 @@
 
 // https://adventofcode.com/2023/day/3
 
+namespace {
+
 using Input = const std::vector<std::string> &;
 
 struct PartNumber {
@@ -44,6 +46,8 @@ struct SymbolSearcher {
   }
 };
 
+}
+
 static
 SymbolSearcher
 isSurrounded(Input lines, size_t xleft, size_t xright, size_t y) {
@@ -11,6 +11,8 @@
 
 // https://adventofcode.com/2023/day/6
 
+namespace {
+
 using i64 = long long int;
 
 struct how_many_ways_to_win {
@@ -64,6 +66,8 @@ long long int read_int(const std::string & str) {
   return r;
 }
 
+}
+
 Output day_2023_06(const std::vector<std::string> & lines, const DayExtraInfo &) {
   const std::vector<int> times = bj::extract_ints_from_line(lines[0]);
   const std::vector<int> distances = bj::extract_ints_from_line(lines[1]);
@@ -6,6 +6,8 @@
 
 // https://adventofcode.com/2023/day/7
 
+namespace {
+
 using i64 = long long int;
 
 enum class Type {
@@ -82,6 +84,8 @@ struct Hand {
   }
 };
 
+}
+
 Output day_2023_07(const std::vector<std::string> & lines, const DayExtraInfo &) {
   std::array<i64, 2> answers;
   answers.fill(0);
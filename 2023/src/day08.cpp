@@ -30,6 +30,8 @@ i64 compute_lcm(std::span<const i64> values) {
   return lcm;
 }
 
+namespace {
+
 class Graph {
 private:
   std::string m_directions;
@@ -146,6 +148,8 @@ public:
   }
 };
 
+}
+
 Output day_2023_08(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   Graph g { lines[0], std::span(lines.begin() + 2, lines.end()) };
   
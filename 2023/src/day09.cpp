@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <set>
 
+namespace {
+
 using i64 = std::int64_t;
 
 // https://adventofcode.com/2023/day/9
@@ -38,13 +40,16 @@ struct Prediction {
   }
 };
 
+}
+
 
 Output day_2023_09(const std::vector<std::string> & lines, const DayExtraInfo &) {
   Prediction sum_of_predictions { 0, 0 };
 
-  for (const std::string & line : lines) {
-    std::vector<i64> numbers = bj::extract_signed_i64_from_line(line);
-    const Prediction answer = Prediction::predict(numbers);
+  const bj::IntsByLine numbers(lines);
+
+  for (size_t i = 0; i != numbers.size(); ++i) {
+    const Prediction answer = Prediction::predict(numbers[i]);
     
     sum_of_predictions.next     += answer.next;
     sum_of_predictions.previous += answer.previous;
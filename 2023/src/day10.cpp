@@ -9,6 +9,8 @@
 
 #pragma GCC diagnostic ignored "-Wsign-compare"
 
+namespace {
+
 using i64 = std::int64_t;
 
 // https://adventofcode.com/2023/day/10
@@ -216,6 +218,8 @@ struct PartB {
   }
 };
 
+}
+
 Output day_2023_10(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   const PartA part_a_solution = PartA::solve(lines);
   
@@ -4,6 +4,8 @@
 #include <set>
 #include <map>
 
+namespace {
+
 using i64 = std::int64_t;
 
 // https://adventofcode.com/2023/day/12
@@ -126,6 +128,8 @@ std::string trim_dots(const std::string & original_word) {
   return original_word.substr(i);
 }
 
+}
+
 
 Output day_2023_12(const std::vector<std::string> & lines, const DayExtraInfo &) {
   i64 part_a = 0;
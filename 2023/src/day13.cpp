@@ -4,6 +4,8 @@
 #include <set>
 #include <map>
 
+namespace {
+
 using i64 = std::int64_t;
 
 // https://adventofcode.com/2023/day/13
@@ -102,6 +104,8 @@ i64 solve(std::span<const std::string> lines) {
   return -1000000;
 }
 
+}
+
 Output day_2023_13(const std::vector<std::string> & lines, const DayExtraInfo &) {
   i64 part_a = 0;
   i64 part_b = 0;
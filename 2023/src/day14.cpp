@@ -1,5 +1,6 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
+#include "../../common/scale.h"
 #include <vector>
 #include <algorithm>
 #include <set>
@@ -105,3 +106,9 @@ Output day_2023_14(const std::vector<std::string> & lines, const DayExtraInfo &)
 
   return Output(part_a, part_b);
 }
+
+static std::vector<std::string> scale_up(std::span<const std::string_view> lines, unsigned int factor, std::uint64_t) {
+  return test::tile_grid(lines, factor);
+}
+
+[[maybe_unused]] static const bool day_2023_14_is_scalable = register_scale_generator(&day_2023_14, &scale_up);
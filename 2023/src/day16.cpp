@@ -7,6 +7,8 @@
 #include <charconv>
 #include "../../util/position.hpp"
 
+namespace {
+
 using i64 = std::int64_t;
 using Grid = std::vector<std::string>;
 
@@ -118,6 +120,8 @@ i64 solve(const std::vector<std::string> & lines, Beam first_beam) {
   return lighten.size();
 }
 
+}
+
 Output day_2023_16(const std::vector<std::string> & lines, const DayExtraInfo &) { 
   i64 part_a = solve(lines, Beam{ bj::Kitten( bj::Position{0, 0}, bj::Direction::Right ) } );
 
@@ -2,6 +2,7 @@
 #include <vector>
 #include <map>
 #include "../../util/instruction_reader.hpp"
+#include "../../util/interval_set.hpp"
 
 using i64 = std::int64_t;
 
@@ -77,76 +78,23 @@ struct MachinePart {
   }
 };
 
-struct Interval {
-  int min;
-  int max;
+using Interval = bj::Interval<int>;
 
-  i64 get_width() const {
-    return max - min;
-  }
-
-  [[nodiscard]] std::pair<std::optional<Interval>, std::optional<Interval>> splice(bool inferior, int value) const {
-    using ReturnType = std::pair<std::optional<Interval>, std::optional<Interval>>;
-
-    if (inferior) {
-      if (value <= min) {
-        return ReturnType(std::nullopt, *this);
-      } else if (value < max) {
-        Interval yes = *this;
-        Interval no = *this;
-        yes.max = value;
-        no.min = value;
-        
-        return ReturnType(yes, no);
-      } else {
-        return ReturnType(*this, std::nullopt);
-      }
-    } else {
-      if (value < min) {
-        return ReturnType(*this, std::nullopt);
-      } else if (value < max - 1) {
-        Interval yes = *this;
-        Interval no = *this;
-        no.max = value + 1;
-        yes.min = value + 1;
-        
-        return ReturnType(yes, no);
-      } else {
-        return ReturnType(std::nullopt, *this);
-      }
-    }
-  }
-
-  [[maybe_unused]] static void test() {
-    Interval interval{ 4, 8 };
-
-    for (int i = 0; i != 10; ++i) {
-      std::cout << "< "  << i << " : " << interval.splice(true, i) << "\n";
-    }
-    
-    for (int i = 0; i != 10; ++i) {
-      std::cout << "> "  << i << " : " << interval.splice(false, i) << "\n";
-    }
-  }
-
-  friend std::ostream & operator<<(std::ostream & stream, Interval interval) {
-    return stream << '[' << interval.min << ", " << interval.max << "[";
-  }
-
-  friend std::ostream & operator<<(std::ostream & stream, std::optional<Interval> interval) {
-    if (interval) {
-      stream << *interval;
-    } else {
-      stream << "0";
-    }
-
-    return stream;
-  }
+/** The ratings that pass the test of the rule, and the ones that do not */
+std::pair<std::optional<Interval>, std::optional<Interval>> splice_interval(Interval interval, bool inferior, int value) {
+  const auto to_optional = [](Interval part) -> std::optional<Interval> {
+    if (part.empty()) return std::nullopt;
+    return part;
+  };
 
-  friend std::ostream & operator<<(std::ostream & stream, std::pair<std::optional<Interval>, std::optional<Interval>> intervals) {
-    return stream << intervals.first << " / " << intervals.second;
+  if (inferior) {
+    const auto [below, above] = interval.split_at(value);
+    return std::pair(to_optional(below), to_optional(above));
+  } else {
+    const auto [below, above] = interval.split_at(value + 1);
+    return std::pair(to_optional(above), to_optional(below));
   }
-};
+}
 
 struct GroupOfMachineParts {
   std::array<Interval, 4> ratings; // x m a s
@@ -157,7 +105,7 @@ struct GroupOfMachineParts {
                    rule.tested_rating == 'a' ? 2 :
                                                3;
     
-    const auto [accepted, rejected] = ratings[index].splice(rule.inferior, rule.value);
+    const auto [accepted, rejected] = splice_interval(ratings[index], rule.inferior, rule.value);
 
     return std::pair(from_spliced_interval(index, accepted), from_spliced_interval(index, rejected));
   }
@@ -173,15 +121,12 @@ struct GroupOfMachineParts {
   }
 
   [[nodiscard]] i64 get_number_in_group() const noexcept {
-    return ratings[0].get_width() * ratings[1].get_width() * ratings[2].get_width() * ratings[3].get_width();
+    return i64(ratings[0].size()) * ratings[1].size() * ratings[2].size() * ratings[3].size();
   }
 
   [[nodiscard]] static GroupOfMachineParts initial_group() {
     GroupOfMachineParts p;
-    for (size_t i = 0; i != 4; ++i) {
-      p.ratings[i].min = 1;
-      p.ratings[i].max = 4000 + 1;
-    }
+    p.ratings.fill(Interval::closed(1, 4000));
     return p;
   }
 };
@@ -223,14 +168,9 @@ std::pair<WorkflowChart, std::vector<MachinePart>> parse(const std::vector<std::
   };
 
   bj::InstructionReader<MachinePart> machine_part_reader;
-  machine_part_reader.add_handler(R"(\{x=(\d*),m=(\d*),a=(\d*),s=(\d*)\})",
-    [](const std::vector<std::string> & vals) -> MachinePart {
-      return MachinePart {
-        .x = std::stoi(vals[0]),
-        .m = std::stoi(vals[1]),
-        .a = std::stoi(vals[2]),
-        .s = std::stoi(vals[3])
-      };
+  machine_part_reader.add_handler<"{{x={digits},m={digits},a={digits},s={digits}}}">(
+    [](int x, int m, int a, int s) -> MachinePart {
+      return MachinePart { .x = x, .m = m, .a = a, .s = s };
     });
 
   bool on_workflows = true;
@@ -13,6 +13,8 @@ i64 compute_lcm(std::span<const long long int> values);
 // https://adventofcode.com/2023/day/20
 
 
+namespace {
+
 class Module;
 
 using SignalQueue = std::queue<std::tuple<bool, Module *, Module *>>;
@@ -182,6 +184,8 @@ Network Network::parse(const std::vector<std::string> & lines) {
   return retval;
 }
 
+}
+
 
 
 
@@ -226,3 +230,6 @@ Output day_2023_20(const std::vector<std::string> & lines, const DayExtraInfo &
 
   return Output(part_a, part_b);
 }
+
+// The module network lives in global state
+[[maybe_unused]] static const bool day_2023_20_is_sequential = register_sequential_day(&day_2023_20);
@@ -7,6 +7,8 @@
 #include <memory>
 #include "../../util/position.hpp"
 
+namespace {
+
 using i64 = std::int64_t;
 
 
@@ -191,6 +193,8 @@ i64 do_part_b(std::vector<std::string> lines, int initial_step) {
   return infinity.solve(initial_step);
 }
 
+}
+
 
 Output day_2023_21(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   
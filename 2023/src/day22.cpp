@@ -8,6 +8,8 @@
 #include <ranges>
 #include <algorithm>
 
+namespace {
+
 using i64 = std::int64_t;
 
 // https://adventofcode.com/2023/day/22
@@ -185,21 +187,15 @@ i64 number_of_moved_blocks_if_erased(std::span<const Brick> bricks, size_t i) {
   return result;
 }
 
+}
+
 Output day_2023_22(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
 
   bj::InstructionReader<Brick> reader;
 
-  reader.add_handler(
-    R"(^(\d*),(\d*),(\d*)~(\d*),(\d*),(\d*)$)",
-    [](const std::vector<std::string> & v) -> Brick {
-      return Brick(
-        std::stoi(v[0]),
-        std::stoi(v[1]),
-        std::stoi(v[2]),
-        std::stoi(v[3]),
-        std::stoi(v[4]),
-        std::stoi(v[5])
-      );
+  reader.add_handler<"{digits},{digits},{digits}~{digits},{digits},{digits}">(
+    [](int x1, int y1, int z1, int x2, int y2, int z2) -> Brick {
+      return Brick(x1, y1, z1, x2, y2, z2);
     }
   );
 
@@ -8,6 +8,8 @@
 #include <ranges>
 #include <algorithm>
 
+namespace {
+
 using i64 = std::int64_t;
 using Grid = std::vector<std::string>;
 
@@ -300,6 +302,8 @@ void remove_slopes(Grid & grid) {
   }
 }
 
+}
+
 
 Output day_2023_23(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   const bj::Position target { int(lines[0].size() - 2), int(lines.size() - 1) };
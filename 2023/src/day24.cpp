@@ -1,6 +1,9 @@
 #include "../../common/advent_of_code.hpp"
+#include "../../common/scale.h"
 #include <vector>
 
+namespace {
+
 using i64 = std::int64_t;
 
 // https://adventofcode.com/2023/day/24
@@ -52,17 +55,20 @@ struct TwinkleStar {
   }
 };
 
+}
+
 
 
 
 Output day_2023_24(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   std::vector<TwinkleStar> stars;
 
-  for (const std::string & line : lines) {
-    std::vector<i64> vals = bj::extract_signed_i64_from_line(line);
+  const bj::IntsByLine values(lines);
+  for (size_t i = 0; i != values.size(); ++i) {
+    const std::span<const i64> vals = values[i];
     stars.emplace_back(
       TwinkleStar {
-        vals[0], vals[1], vals[2], vals[3], vals[4], vals.at(5)
+        vals[0], vals[1], vals[2], vals[3], vals[4], vals[5]
       }
     );
   }
@@ -95,3 +101,6 @@ Output day_2023_24(const std::vector<std::string> & lines, const DayExtraInfo &
 
   return Output(part_a, "Run js/2023_24.py");
 }
+
+// More hailstones, with positions and velocities in the ranges of the input
+[[maybe_unused]] static const bool day_2023_24_is_scalable = register_scale_generator(&day_2023_24, &test::lines_like);
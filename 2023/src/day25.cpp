@@ -9,6 +9,8 @@
 #include <algorithm>
 #include <format>
 
+namespace {
+
 using i64 = std::int64_t;
 using Grid = std::vector<std::string>;
 
@@ -69,6 +71,8 @@ i64 count(
   return group_1.size() * (all.size() - group_1.size());
 }
 
+}
+
 
 Output day_2023_25(const std::vector<std::string> & lines, const DayExtraInfo &) {
   return Output("This file does not work and is not worth fixing, run the python script js/2023_25.py", 0);
@@ -35,7 +35,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2024 {
   &day_2024_21, &day_2024_22, &day_2024_23, &day_2024_24, &day_2024_25
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2024() {
+  return to_day_entries(days_2024);
+}
+#else
 int main(int argc, const char * argv[]) {
   run_aoc(days_2024, argc, argv);
   return 0;
 }
+#endif
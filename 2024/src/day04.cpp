@@ -4,6 +4,8 @@
 
 // https://adventofcode.com/2024/day/4
 
+namespace {
+
 enum class Direction {
   // Directions named according to num pad
   Dir8,
@@ -16,6 +18,8 @@ enum class Direction {
   Dir7
 };
 
+}
+
 static
 bj::Position move(bj::Position position, Direction direction) {
   using enum Direction;
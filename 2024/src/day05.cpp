@@ -8,6 +8,8 @@
 
 // https://adventofcode.com/2024/day/5
 
+namespace {
+
 /**
  * Add the rank of each value in the order described by rank_map
  */
@@ -89,6 +91,8 @@ struct PuzzleInput {
   std::vector<std::vector<int>> page_lists;
 };
 
+}
+
 static
 PuzzleInput read_puzzle_input(const std::vector<std::string> & lines) {
   PuzzleInput retval;
@@ -1,49 +1,41 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
-#include <set>
-#include <utility>
+#include "../../util/grid.hpp"
+#include "../../common/scale.h"
+#include <cstdint>
 
 // https://adventofcode.com/2024/day/6
 
-using Grid = std::vector<std::string>;
+// The map has a border of 'O', so the guard can look at the cell in front
+// of it without checking the bounds
+using Grid = bj::Grid<char>;
 
+// Bit of each direction in the cells of the visited grid
 static
-char get_at(const Grid & grid, bj::Position position) {
-  return grid[position.y][position.x];
+std::uint8_t bit_of(bj::Direction direction) {
+  return static_cast<std::uint8_t>(1 << static_cast<int>(direction));
 }
 
 static
-bj::Position find_guard(const Grid & grid) {
-  for (size_t y = 0; y != grid.size(); ++y) {
-    for (size_t x = 0; x != grid[0].size(); ++x) {
-      if (grid[y][x] == '^') {
-        return bj::Position{ int(x), int(y) };
-      }
-    }
-  }
-
-  throw std::runtime_error("2024-06 no guard");
-}
-
-static
-bool obstacle_here_provokes_loop(bj::Kitten guard, const bj::Position extra_obstacle, const Grid & grid) {
-  std::set<std::pair<bj::Direction, bj::Position>> already_visited;
+bool obstacle_here_provokes_loop(bj::Kitten guard, const bj::Position extra_obstacle, const Grid & grid, bj::Grid<std::uint8_t> & already_visited) {
+  already_visited.fill(0);
 
   while (true) {
-    if (already_visited.contains(std::pair(guard.direction, guard.position))) {
+    std::uint8_t & visited_directions = already_visited[guard.position];
+    if (visited_directions & bit_of(guard.direction)) {
       // cycle
       return true;
     }
 
-    already_visited.emplace(std::pair(guard.direction, guard.position));
+    visited_directions |= bit_of(guard.direction);
 
     guard.advance();
-    if (guard.position.is_out_of_bound(grid)) {
+    if (grid[guard.position] == 'O') {
       // No cycle
       return false;
     }
 
-    if (guard.position == extra_obstacle || get_at(grid, guard.position) == '#') {
+    if (guard.position == extra_obstacle || grid[guard.position] == '#') {
       // Obstacle
       guard.move_backward();
       guard.turn_right();
@@ -51,43 +43,72 @@ bool obstacle_here_provokes_loop(bj::Kitten guard, const bj::Position extra_obst
   }
 }
 
-
 Output day_2024_06(const std::vector<std::string> & lines, const DayExtraInfo &) {
-  
-  bj::Position guard_pos = find_guard(lines);
+  const Grid grid = Grid::from_lines(lines, 1, 'O');
+
+  const std::optional<bj::Position> guard_pos = grid.find('^');
+  if (!guard_pos) throw std::runtime_error("2024-06 no guard");
+
+  bj::Kitten guard(*guard_pos, bj::Direction::Top);
+  bj::Kitten guard_default_position(*guard_pos, bj::Direction::Top);
+
+  enum class Obstacle : char { Untested, ProvokesCycle, Safe };
 
-  bj::Kitten guard(guard_pos, bj::Direction::Top);
-  bj::Kitten guard_default_position(guard_pos, bj::Direction::Top);
+  bj::Grid<char> visited(grid.width(), grid.height(), false);
+  bj::Grid<Obstacle> obstacles(grid.width(), grid.height(), Obstacle::Untested);
+  bj::Grid<std::uint8_t> already_visited(grid.width(), grid.height(), 0);
 
-  std::set<bj::Position> visited;
-  std::set<bj::Position> obstacle_that_would_provoke_a_cycle, safe_place;
   while (true) {
-    visited.emplace(guard.position);
+    visited[guard.position] = true;
 
     guard.advance();
 
-    if (guard.position.is_out_of_bound(lines)) break;
+    char c = grid[guard.position];
 
-    char c = get_at(lines, guard.position);
+    if (c == 'O') break;
 
     if (c == '#') {
       guard.move_backward();
       guard.turn_right();
     } else if (c == '.') {
-      if (!obstacle_that_would_provoke_a_cycle.contains(guard.position)
-        && !safe_place.contains(guard.position)
-      ) {
-        if (obstacle_here_provokes_loop(guard_default_position, guard.position, lines)) {
-          obstacle_that_would_provoke_a_cycle.emplace(guard.position);
+      if (obstacles[guard.position] == Obstacle::Untested) {
+        if (obstacle_here_provokes_loop(guard_default_position, guard.position, grid, already_visited)) {
+          obstacles[guard.position] = Obstacle::ProvokesCycle;
         } else {
-          safe_place.emplace(guard.position);
+          obstacles[guard.position] = Obstacle::Safe;
         }
       }
     }
   }
 
-  return Output(visited.size(), obstacle_that_would_provoke_a_cycle.size());
+  return Output(visited.count(true), obstacles.count(Obstacle::ProvokesCycle));
 }
 
+// Tiles of the map, with only one guard, in the middle tile
+static
+std::vector<std::string> scale_up(std::span<const std::string_view> lines, unsigned int factor, std::uint64_t) {
+  std::vector<std::string> tiled = test::tile_grid(lines, factor);
+
+  const size_t height = lines.size();
+  const size_t width = lines[0].size();
+  const size_t tile_rows = tiled.size() / height;
+  const size_t tile_columns = tiled[0].size() / width;
+
+  for (std::string & line : tiled) {
+    std::replace(line.begin(), line.end(), '^', '.');
+  }
+
+  for (size_t y = 0; y != height; ++y) {
+    const size_t x = lines[y].find('^');
+    if (x != std::string_view::npos) {
+      tiled[y + tile_rows / 2 * height][x + tile_columns / 2 * width] = '^';
+    }
+  }
+
+  return tiled;
+}
+
+[[maybe_unused]] static const bool day_2024_06_is_scalable = register_scale_generator(&day_2024_06, &scale_up);
+
 // not 1792
 
@@ -210,12 +210,12 @@ std::vector<Block> defrag_part_b(std::span<const Block> original_disk) {
   for (const Block & block : blocks) {
     for (size_t i = 0; i != block.size; ++i) {
       if (block.data == -1)
-        printf(".");
+        std::cout << '.';
       else
-        printf("%d", block.data);
+        std::cout << block.data;
     }
   }
-  printf("\n");
+  std::cout << '\n';
 }
 
 }
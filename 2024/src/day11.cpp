@@ -3,6 +3,7 @@
 #include <ranges>
 #include <algorithm>
 #include <map>
+#include <random>
 
 // https://adventofcode.com/2024/day/11
 
@@ -148,3 +149,30 @@ Output day_2024_11(const std::vector<std::string> & lines, const DayExtraInfo &
 
   return Output(part_a, part_b); 
 }
+
+// factor times more stones, each with as many digits as a stone of the input
+static std::vector<std::string> scale_up(std::span<const std::string_view> lines, unsigned int factor, std::uint64_t seed) {
+  std::vector<std::string_view> stones;
+  for (const auto & stone : std::views::split(lines[0], ' ')) {
+    if (!stone.empty()) stones.emplace_back(stone.begin(), stone.end());
+  }
+
+  std::mt19937_64 random(seed);
+  std::uniform_int_distribution<size_t> pick_stone(0, stones.size() - 1);
+  std::uniform_int_distribution<int> pick_digit(0, 9);
+
+  std::string line;
+  for (size_t i = 0; i != stones.size() * factor; ++i) {
+    if (i != 0) line += ' ';
+
+    const size_t digits = stones[pick_stone(random)].size();
+    line += static_cast<char>('1' + pick_digit(random) % 9);
+    for (size_t d = 1; d < digits; ++d) {
+      line += static_cast<char>('0' + pick_digit(random));
+    }
+  }
+
+  return { line };
+}
+
+[[maybe_unused]] static const bool day_2024_11_is_scalable = register_scale_generator(&day_2024_11, &scale_up);
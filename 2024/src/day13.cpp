@@ -16,18 +16,22 @@ struct ClawMachine {
   bj::Position prize;
 
   ClawMachine(
-    std::string line1,
-    std::string line2,
-    std::string line3
+    std::string_view line1,
+    std::string_view line2,
+    std::string_view line3
   ) {
 
-    const auto v1 = bj::extract_ints_from_line(line1);
-    const auto v2 = bj::extract_ints_from_line(line2);
-    const auto v3 = bj::extract_ints_from_line(line3);
+    a_button = read_position(line1);
+    b_button = read_position(line2);
+    prize    = read_position(line3);
+  }
 
-    a_button = { v1[0], v1[1] };
-    b_button = { v2[0], v2[1] };
-    prize    = { v3[0], v3[1] };
+  static bj::Position read_position(std::string_view line) {
+    std::array<int, 2> values {};
+    if (bj::scan_ints(line, values) != values.size()) {
+      throw std::invalid_argument("Bad input: " + std::string(line));
+    }
+    return bj::Position{ values[0], values[1] };
   }
 
   int solve_a() const {
@@ -61,9 +61,9 @@ struct LineReader {
 
 void draw(const std::vector<std::string> & grid) {
   for (const std::string & line : grid) {
-    printf("%s\n", line.c_str());
+    std::cout << line << '\n';
   }
-  printf("\n");
+  std::cout << '\n';
 }
 
 long long int after_100_seconds(std::vector<Robot> robots, bj::Position bottom_right) {
@@ -134,8 +134,10 @@ Output day_2024_14(const std::vector<std::string> & lines, const DayExtraInfo &
 
   std::vector<Robot> robots = LineReader()(lines);
 
+  dei.start_phase(test::Phase::PartA);
   long long int part_a = after_100_seconds(robots, bottom_right);
 
+  dei.start_phase(test::Phase::PartB);
   long long int part_b = 0;
   if (wide > 20)
     part_b = find_the_tree(robots, bottom_right);
@@ -1,64 +1,30 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
-// #include <map>
-// #include <cstring>
-// #include <utility>
-#include <climits>
-#include <queue>
-// #include <span>
+#include "../../util/graph_search.hpp"
+#include <span>
 
 // https://adventofcode.com/2024/day/17
 
 namespace {
 
 
-std::vector<std::vector<std::optional<int>>> to_step_map(const std::vector<std::string> & grid) {
-  std::vector<std::vector<std::optional<int>>> output;
-  output.reserve(grid.size());
-
-  for (const std::string & line : grid) {
-    output.emplace_back();
-    output.back().reserve(line.size());
-    for (const char c : line) {
-      if (c == '#') {
-        output.back().emplace_back(INT_MAX);
-      } else{
-        output.back().emplace_back(std::nullopt);
-      }
-    }
-  }
-
-  return output;
-}
-
-
-
 int steps_to_reach_the_end(const std::vector<std::string> & grid) {
-  auto step_map = to_step_map(grid);
-
-  step_map[0][0] = 0;
-
-  std::queue<bj::Position> todo;
-  todo.emplace(bj::Position{ 0, 0 });
-
-  while (!todo.empty()) {
-    bj::Position pos = todo.front();
-    todo.pop();
-    const int neighbour_cost = *step_map[pos.y][pos.x] + 1;
-
-    pos.for_each_neighbour([&](bj::Position neighbour) {
-      std::optional<int> & neighbour_known_cost = step_map[neighbour.y][neighbour.x];
-
-      if (neighbour.is_out_of_bound(grid)) return;
-      if (grid[neighbour.y][neighbour.x] == '#') return;
-      if (neighbour_known_cost && *neighbour_known_cost <= neighbour_cost) return;
-
-      neighbour_known_cost = neighbour_cost;
-      todo.emplace(neighbour);
-    });
-  }
-
-  return step_map.back().back().value_or(-1);
+  const bj::graph::GridSpace space = bj::graph::GridSpace::of(grid);
+  const bj::Position exit { space.width - 1, space.height - 1 };
+
+  const auto result = bj::graph::bfs(
+    space, bj::Position{ 0, 0 },
+    [&](bj::Position pos, auto emit) {
+      pos.for_each_neighbour([&](bj::Position neighbour) {
+        if (neighbour.is_out_of_bound(grid)) return;
+        if (grid[neighbour.y][neighbour.x] == '#') return;
+        emit(neighbour);
+      });
+    },
+    [&](bj::Position pos) { return pos == exit; }
+  );
+
+  return result.target_distance().value_or(-1);
 }
 
 std::vector<std::string> make_mock_grid(int size) {
@@ -107,7 +73,10 @@ Output day_2024_18(const std::vector<std::string> & lines, const DayExtraInfo &
 
   std::vector<bj::Position> corruptions;
   for (const std::string & line : lines) {
-    std::vector<int> values = bj::extract_ints_from_line(line);
+    std::array<int, 2> values {};
+    if (bj::scan_ints(line, values) != values.size()) {
+      throw std::invalid_argument("Bad input: " + line);
+    }
     corruptions.emplace_back(bj::Position{ values[0], values[1] });
   }
 
@@ -1,6 +1,6 @@
 #include "../../common/advent_of_code.hpp"
 #include "../../util/position.hpp"
-#include <map>
+#include "../../util/graph_search.hpp"
 #include <utility>
 
 // https://adventofcode.com/2024/day/20
@@ -18,89 +18,55 @@ bj::Position find_in_grid(const std::vector<std::string> & lines, char c) {
   return bj::Position{ -1, -1 };
 }
 
-template<typename T>
-std::vector<std::vector<T>> replicate(const std::vector<std::string> & lines, T default_value) {
-  std::vector<std::vector<T>> output;
-  output.reserve(lines.size());
-  for (const std::string & line : lines) {
-    output.emplace_back();
-    output.reserve(line.size());
-    for (const char _ : line) {
-      output.back().emplace_back(default_value);
-    }
-  }
-  return output;
-}
-
-
-std::pair<
-  std::vector<std::vector<std::optional<i64>>>,
-  std::vector<bj::Position>
-> compute_regular_path(const std::vector<std::string> & lines) {
-  std::vector<std::vector<std::optional<i64>>> distance_from_start = replicate<std::optional<i64>>(lines, std::nullopt);
-  std::vector<bj::Position> path;
-
-  bj::Position car = find_in_grid(lines, 'S');
-
-  int current_distance = 0;
-  distance_from_start[car.y][car.x] = 0;
-  path.emplace_back(car);
-
-
-  while (true) {
-    for (bj::Direction dir : { bj::Direction::Left, bj::Direction::Right, bj::Direction::Top, bj::Direction::Down }) {
-      bj::Position copy = car;
-      copy.move(dir);
+using Track = bj::graph::Distances<bj::graph::GridSpace>;
 
-      if (copy.is_out_of_bound(lines)) continue;
-      if (distance_from_start[copy.y][copy.x]) continue;
-      if (lines[copy.y][copy.x] == '.' || lines[copy.y][copy.x] == 'E') {
-        car = copy;
-        break;
-      }
+/** The time to reach each cell of the track from the start, and the cells of the track */
+std::pair<Track, std::vector<bj::Position>> compute_regular_path(const std::vector<std::string> & lines) {
+  const bj::graph::GridSpace space = bj::graph::GridSpace::of(lines);
 
-      if (dir == bj::Direction::Down) {
-        throw std::runtime_error("not found");
-      }
+  Track distance_from_start = bj::graph::bfs(
+    space, find_in_grid(lines, 'S'),
+    [&](bj::Position pos, auto emit) {
+      pos.for_each_neighbour([&](bj::Position neighbour) {
+        if (space.contains(neighbour) && lines[neighbour.y][neighbour.x] != '#') emit(neighbour);
+      });
     }
+  ).distances;
 
-    distance_from_start[car.y][car.x] = current_distance + 1;
-    current_distance += 1;
-    path.emplace_back(car);
-    if (lines[car.y][car.x] == 'E') {
-      break;
+  std::vector<bj::Position> path;
+  for (size_t y = 0; y != lines.size(); ++y) {
+    for (size_t x = 0; x != lines[y].size(); ++x) {
+      const bj::Position pos = bj::Position::from(x, y);
+      if (distance_from_start.reached(pos)) path.emplace_back(pos);
     }
   }
 
-  return { distance_from_start, path };
+  return { std::move(distance_from_start), std::move(path) };
 }
 
 
 struct PressingTheCtrlButton {
-  std::vector<std::vector<std::optional<i64>>> reference_times;
-  std::map<i64, i64> time_save; // An array would be better
+  const Track & reference_times;
+  std::vector<i64> time_save = {}; // time_save[delta] = number of cheats that save delta
 
   void consider(bj::Position pos, int at_with_cheating) {
-    if (pos.x < 0 || pos.y < 0) return;
-    if (std::cmp_greater_equal(pos.y, reference_times.size())) return;
-    if (std::cmp_greater_equal(pos.x, reference_times[pos.y].size())) return;
+    if (!reference_times.space().contains(pos)) return;
+
+    const int expected_time = reference_times[pos];
+    if (expected_time == Track::unreached) return;
 
-    if (!reference_times[pos.y][pos.x]) return;
-    
-    const int expected_time = *reference_times[pos.y][pos.x];
     const int delta = expected_time - at_with_cheating;
 
     if (delta > 0) {
+      if (std::cmp_greater_equal(delta, time_save.size())) time_save.resize(delta + 1, 0);
       time_save[delta] += 1;
     }
   }
 
   i64 sum_at_time_save_of_at_least(i64 min_time_save) {
     i64 acc = 0;
-    for (const auto & [delta, times] : time_save) {
-      if (delta >= min_time_save) {
-        acc += times;
-      }
+    for (size_t delta = min_time_save; delta < time_save.size(); ++delta) {
+      acc += time_save[delta];
     }
     return acc;
   }
@@ -112,11 +78,11 @@ struct PressingTheCtrlButton {
 Output day_2024_20(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   const auto [distance_from_start, path] = compute_regular_path(lines);
 
-  PressingTheCtrlButton part_a { distance_from_start, {} };
-  PressingTheCtrlButton part_b { distance_from_start, {} };
+  PressingTheCtrlButton part_a { distance_from_start };
+  PressingTheCtrlButton part_b { distance_from_start };
 
   for (bj::Position car : path) {
-    const int step_at_cat = *distance_from_start[car.y][car.x];
+    const int step_at_cat = distance_from_start[car];
 
     // Part A
     for (bj::Direction dir : { bj::Direction::Left, bj::Direction::Right, bj::Direction::Top, bj::Direction::Down }) {
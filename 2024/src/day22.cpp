@@ -29,7 +29,7 @@ Output day_2024_22(const std::vector<std::string> & lines, const DayExtraInfo &
 
   i64 sn = 123;
   for (int i = 0; i != 10; ++i) {
-    printf("%ld\n", sn);
+    std::cout << sn << '\n';
     sn = generate_next(sn);
   }
 
@@ -28,7 +28,7 @@ Operator to_operator(std::string str) {
   if (str == "XOR") return Operator::Xor;
   if (str == "AND") return Operator::And;
   if (str == "OR") return Operator::Or;
-  printf("str=  %s\n", str.c_str());
+  std::cout << "str=  " << str << '\n';
   throw std::runtime_error("not an operator");
 }
 
@@ -23,7 +23,13 @@ static constexpr std::array<DayEntryPoint *, 25> days_2025 {
   nullptr, nullptr, nullptr, nullptr, nullptr
 };
 
+#ifdef AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2025() {
+  return to_day_entries(days_2025);
+}
+#else
 int main(int argc, const char * argv[]) {
   run_aoc(days_2025, argc, argv);
   return 0;
 }
+#endif
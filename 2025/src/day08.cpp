@@ -1,4 +1,5 @@
 #include "../../common/advent_of_code.hpp"
+#include "../../common/scale.h"
 #include <vector>
 #include <algorithm>
 #include <numeric>
@@ -190,3 +191,7 @@ Output day_2025_08(const std::vector<std::string> & lines, const DayExtraInfo &
   // Return result
   return Output(part_a, part_b);
 }
+
+// More junction boxes in the same space. All the pairs are sorted, so x16
+// needs a few GB: use --scale-factors to choose smaller inputs.
+[[maybe_unused]] static const bool day_2025_08_is_scalable = register_scale_generator(&day_2025_08, &test::lines_like);
@@ -229,7 +229,10 @@ bool check_rect(const std::vector<std::string> & grid, bj::Position pa, bj::Posi
 Output day_2025_09(const std::vector<std::string> & lines, const DayExtraInfo & dei) {
   std::vector<bj::Position> points;
   for (const std::string & line : lines) {
-    std::vector<int> coords = bj::extract_ints_from_line(line);
+    std::array<int, 2> coords {};
+    if (bj::scan_ints(line, coords) != coords.size()) {
+      throw std::invalid_argument("Bad input: " + line);
+    }
     points.emplace_back(bj::Position{ coords[0], coords[1] });
   }
 
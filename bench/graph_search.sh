@@ -0,0 +1,47 @@
+#!/bin/sh
+# Compares the days that use util/graph_search.hpp with their former
+# implementations, with the timings history of the mains (--record and
+# --compare). Run from the root folder:
+#
+#     bench/graph_search.sh [revision] [repetitions]
+#
+# The revision, by default the one before util/graph_search.hpp was added, is
+# checked out and built in a git worktree in build/, where the days are timed
+# and recorded in the bench_history.jsonl of the worktree. The current tree is
+# then timed and compared with them through --history, so the bench_history.jsonl
+# of the years are left untouched. DAYS overrides the benchmarked days, e.g.
+# DAYS="2021:15 2022:12".
+
+set -e
+
+days=${DAYS:-"2016:13 2016:24 2021:15 2022:12 2022:24 2023:17 2024:16 2024:18 2024:20"}
+repetitions=${2:-10}
+
+added=$(git log --diff-filter=A --format=%H -1 -- util/graph_search.hpp)
+revision=${1:-${added:+$added~1}}
+commit=$(git rev-parse --verify "${revision:-HEAD}^{commit}")
+
+worktree=build/graph_search_baseline
+if [ -d "$worktree" ]; then
+  git -C "$worktree" checkout -q --detach "$commit"
+else
+  git worktree add -q --detach "$worktree" "$commit"
+fi
+
+years=$(for day in $days; do echo "${day%%:*}"; done | sort -u)
+
+for year in $years; do
+  make -C "$worktree/$year" -j"$(nproc)"
+  make -C "$year" -j"$(nproc)"
+  rm -f "$worktree/$year/bench_history.jsonl"
+done
+
+echo "Timing $commit"
+for day in $days; do
+  (cd "$worktree/${day%%:*}" && ./main "${day#*:}" --bench "$repetitions" --record > /dev/null)
+done
+
+for day in $days; do
+  history="$(pwd)/$worktree/${day%%:*}/bench_history.jsonl"
+  (cd "${day%%:*}" && ./main "${day#*:}" --bench "$repetitions" --compare "$commit" --history "$history")
+done
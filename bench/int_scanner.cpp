@@ -0,0 +1,190 @@
+// Compares the former character by character extraction of the numbers with
+// the vectorized scanner of common/int_scanner.h, on the inputs of a few days
+// whose parsing is only numbers. Built by `make bench` in the root folder,
+// and run from the root folder:
+//
+//     ./build/release/bench/int_scanner [repetitions]
+//
+// Each input is repeated to be about 1 MB, and the throughput is reported for
+// - the former extract_signed_i64_from_line, a vector per line,
+// - the current extract_signed_i64_from_line, still a vector per line,
+// - bj::scan_ints in a buffer reused for every line,
+// - bj::IntsByLine on the whole text at once.
+
+#include "../common/int_scanner.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    /** The former implementation of bj::extract_signed_i64_from_line */
+    std::vector<std::int64_t> former_extract_signed_i64(std::string_view line) {
+        size_t i = 0;
+
+        std::vector<std::int64_t> values;
+
+        while (true) {
+            std::int64_t accumulator = 0;
+            bool is_negative = false;
+
+            while (i < line.size()) {
+                if (line[i] >= '0' && line[i] <= '9') break;
+                if (line[i] == '-' || line[i] == '+') break;
+                ++i;
+            }
+
+            if (i == line.size()) return values;
+
+            if (line[i] == '-') {
+                is_negative = true;
+                ++i;
+            } else if (line[i] == '+') {
+                ++i;
+            }
+
+            while (i < line.size() && (line[i] >= '0' && line[i] <= '9')) {
+                accumulator = accumulator * 10 + (line[i] - '0');
+                ++i;
+            }
+
+            if (is_negative) accumulator *= -1;
+
+            values.emplace_back(accumulator);
+        }
+    }
+
+    /** The current one, that is in advent_of_code.hpp */
+    std::vector<std::int64_t> extract_signed_i64(std::string_view line) {
+        std::array<std::int64_t, 64> buffer;
+        const size_t count = bj::scan_ints(line, buffer, true);
+        if (count <= buffer.size()) return std::vector<std::int64_t>(buffer.begin(), buffer.begin() + count);
+
+        std::vector<std::int64_t> values(count);
+        bj::scan_ints(line, values, true);
+        return values;
+    }
+
+    const std::vector<const char *> inputs = {
+        "2022/inputs/15_puzzle.txt",
+        "2023/inputs/05_puzzle.txt",
+        "2023/inputs/09_puzzle.txt",
+        "2023/inputs/24_puzzle.txt",
+        "2024/inputs/18_real.txt",
+        "2025/inputs/09_real.txt",
+    };
+
+    /** The content of the file, repeated to be about `size` bytes */
+    std::string read_repeated(const char * path, std::size_t size) {
+        std::ifstream file(path);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        const std::string content = stream.str();
+        if (content.empty()) return content;
+
+        std::string text;
+        while (text.size() < size) {
+            text += content;
+            if (text.back() != '\n') text += '\n';
+        }
+        return text;
+    }
+
+    std::vector<std::string_view> split_lines(std::string_view text) {
+        std::vector<std::string_view> lines;
+        while (!text.empty()) {
+            const std::size_t end = std::min(text.find('\n'), text.size());
+            lines.push_back(text.substr(0, end));
+            text.remove_prefix(std::min(end + 1, text.size()));
+        }
+        return lines;
+    }
+
+    struct Measure {
+        double megabytes_per_second;
+        std::int64_t sum;
+    };
+
+    template<typename Parse>
+    Measure measure(std::size_t bytes, int repetitions, Parse parse) {
+        std::int64_t sum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int repetition = 0; repetition != repetitions; ++repetition) {
+            sum = parse();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        return Measure{ static_cast<double>(bytes) * repetitions / seconds / 1e6, sum };
+    }
+}
+
+int main(int argc, char ** argv) {
+    const int repetitions = argc > 1 ? std::atoi(argv[1]) : 10;
+
+    std::printf("Kernel: %s. Throughput in MB/s\n", bj::int_scanner_kernel_name());
+    std::printf("%-28s %10s %10s %10s %10s\n", "Input", "former", "vector", "buffer", "bulk");
+
+    bool same_sums = true;
+    for (const char * input : inputs) {
+        const std::string text = read_repeated(input, 1 << 20);
+        if (text.empty()) {
+            std::printf("%-28s missing\n", input);
+            continue;
+        }
+
+        const std::vector<std::string_view> lines = split_lines(text);
+
+        const Measure former = measure(text.size(), repetitions, [&]() {
+            std::int64_t sum = 0;
+            for (const std::string_view line : lines) {
+                for (const std::int64_t value : former_extract_signed_i64(line)) sum += value;
+            }
+            return sum;
+        });
+
+        const Measure vector = measure(text.size(), repetitions, [&]() {
+            std::int64_t sum = 0;
+            for (const std::string_view line : lines) {
+                for (const std::int64_t value : extract_signed_i64(line)) sum += value;
+            }
+            return sum;
+        });
+
+        const Measure buffer = measure(text.size(), repetitions, [&]() {
+            std::array<std::int64_t, 64> values;
+            std::int64_t sum = 0;
+            for (const std::string_view line : lines) {
+                const std::size_t count = std::min(bj::scan_ints(line, values, true), values.size());
+                for (std::size_t i = 0; i != count; ++i) sum += values[i];
+            }
+            return sum;
+        });
+
+        const Measure bulk = measure(text.size(), repetitions, [&]() {
+            const bj::IntsByLine numbers(text);
+            std::int64_t sum = 0;
+            for (const std::int64_t value : numbers.values()) sum += value;
+            return sum;
+        });
+
+        std::printf("%-28s %10.0f %10.0f %10.0f %10.0f",
+            input, former.megabytes_per_second, vector.megabytes_per_second,
+            buffer.megabytes_per_second, bulk.megabytes_per_second
+        );
+
+        if (former.sum != vector.sum || former.sum != buffer.sum || former.sum != bulk.sum) {
+            std::printf("  the sums of the numbers differ");
+            same_sums = false;
+        }
+        std::printf("\n");
+    }
+
+    return same_sums ? EXIT_SUCCESS : EXIT_FAILURE;
+}
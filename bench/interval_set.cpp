@@ -0,0 +1,305 @@
+// Compares the interval splitting that 2023/05 and 2022/15 wrote by hand with
+// util/interval_set.hpp, on synthetic inputs of the shape of the real ones,
+// from their size to 1000 times their size. Built by `make bench` in the root
+// folder, and run from the root folder:
+//
+//     ./build/release/bench/interval_set [max scale]
+//
+// - 2023/05: 10 seed ranges and 7 maps of 35 ranges per scale unit. The
+// former Map::transform scans the ranges of the map for each seed range.
+// - 2022/15: 25 scanners per scale unit, spread on a row that is as many
+// times longer, up to the limits of an int. The former part A inserted each
+// scanned position of the row in a std::map.
+//
+// The former implementations are quadratic or proportional to the length of
+// the row, so they are only timed up to a small scale.
+
+#include "../util/interval_set.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+    using i64 = long long int;
+
+    template<typename F>
+    double time_ms(F f) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    // 2023/05
+
+    struct ElementRange {
+        i64 min;
+        i64 length;
+    };
+
+    /** The map of the former 2023/05, sorted by source */
+    struct FormerMap {
+        struct Range {
+            i64 source;
+            i64 destination;
+            i64 length;
+        };
+
+        std::vector<Range> ranges;
+
+        [[nodiscard]] std::vector<ElementRange> transform(ElementRange to_transform) const {
+            std::vector<ElementRange> transformed;
+
+            for (const Range & range : ranges) {
+                if (to_transform.length == 0) break;
+
+                if (to_transform.min < range.source && to_transform.min + to_transform.length > range.source) {
+                    i64 overlapping = range.source - to_transform.min;
+                    transformed.emplace_back(ElementRange{ to_transform.min, overlapping });
+                    to_transform.min = range.source;
+                    to_transform.length -= overlapping;
+                }
+
+                if (to_transform.min >= range.source && to_transform.min < range.source + range.length) {
+                    i64 overlapping = range.source + range.length - to_transform.min;
+                    i64 really_overlapping = std::min(overlapping, to_transform.length);
+                    i64 distance = to_transform.min - range.source;
+                    transformed.emplace_back(ElementRange{ range.destination + distance, really_overlapping });
+                    to_transform.min += really_overlapping;
+                    to_transform.length -= really_overlapping;
+                    continue;
+                }
+            }
+
+            if (to_transform.length != 0) transformed.emplace_back(to_transform);
+            return transformed;
+        }
+    };
+
+    struct Almanac {
+        std::vector<ElementRange> seeds;
+        std::vector<FormerMap> maps;
+    };
+
+    /**
+     * Like the real inputs, the values are below 2^32, and each map cuts
+     * them in chunks that are moved in a shuffled order, so no two values
+     * are mapped to the same one and the number of values is kept.
+     */
+    Almanac make_almanac(int scale, std::mt19937_64 & rng) {
+        constexpr i64 universe = i64(1) << 32;
+
+        Almanac almanac;
+
+        // Disjoint seed ranges, between pairs of sorted random values
+        std::vector<i64> bounds;
+        for (int i = 0; i != 20 * scale; ++i) bounds.push_back(static_cast<i64>(rng() % universe));
+        std::ranges::sort(bounds);
+        for (std::size_t i = 0; i + 1 < bounds.size(); i += 2) {
+            if (bounds[i] != bounds[i + 1]) almanac.seeds.push_back(ElementRange{ bounds[i], bounds[i + 1] - bounds[i] });
+        }
+
+        for (int map = 0; map != 7; ++map) {
+            const std::size_t chunks = 35 * static_cast<std::size_t>(scale);
+
+            std::vector<i64> cuts { 0, universe };
+            for (std::size_t i = 1; i != chunks; ++i) cuts.push_back(static_cast<i64>(rng() % universe));
+            std::ranges::sort(cuts);
+
+            // The chunks are put back to back in the shuffled order
+            std::vector<std::size_t> order(chunks);
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::shuffle(order, rng);
+
+            std::vector<i64> destinations(chunks);
+            i64 destination = 0;
+            for (const std::size_t chunk : order) {
+                destinations[chunk] = destination;
+                destination += cuts[chunk + 1] - cuts[chunk];
+            }
+
+            FormerMap former;
+            for (std::size_t chunk = 0; chunk != chunks; ++chunk) {
+                if (cuts[chunk + 1] == cuts[chunk]) continue;
+                former.ranges.push_back(FormerMap::Range{ cuts[chunk], destinations[chunk], cuts[chunk + 1] - cuts[chunk] });
+            }
+
+            almanac.maps.push_back(std::move(former));
+        }
+
+        return almanac;
+    }
+
+    struct Lowest {
+        i64 min;
+        i64 size;
+    };
+
+    Lowest former_almanac(const Almanac & almanac) {
+        std::vector<ElementRange> ranges = almanac.seeds;
+        for (const FormerMap & map : almanac.maps) {
+            std::vector<ElementRange> result;
+            for (const ElementRange & range : ranges) {
+                for (const ElementRange & r : map.transform(range)) result.emplace_back(r);
+            }
+            ranges = std::move(result);
+        }
+
+        i64 min = ranges[0].min;
+        i64 size = 0;
+        for (const ElementRange & range : ranges) {
+            min = std::min(min, range.min);
+            size += range.length;
+        }
+        return Lowest{ min, size };
+    }
+
+    Lowest interval_set_almanac(const Almanac & almanac) {
+        std::vector<bj::PiecewiseShift<i64>> maps;
+        for (const FormerMap & former : almanac.maps) {
+            std::vector<bj::PiecewiseShift<i64>::Piece> pieces;
+            for (const FormerMap::Range & range : former.ranges) {
+                pieces.push_back({ { range.source, range.source + range.length }, range.destination - range.source });
+            }
+            maps.emplace_back(std::move(pieces));
+        }
+
+        std::vector<bj::Interval<i64>> seeds;
+        for (const ElementRange & seed : almanac.seeds) seeds.push_back({ seed.min, seed.min + seed.length });
+
+        bj::IntervalSet<i64> ranges(std::move(seeds));
+        for (const auto & map : maps) ranges = map(ranges);
+
+        return Lowest{ ranges.min().value(), ranges.size() };
+    }
+
+    // 2022/15
+
+    struct Scanner {
+        int x;
+        int y;
+        int beacon_x;
+        int beacon_y;
+
+        [[nodiscard]] int get_distance_to_beacon() const {
+            return std::abs(x - beacon_x) + std::abs(y - beacon_y);
+        }
+    };
+
+    /** Scanners around the row 0 with a range of about a million, like the real inputs */
+    std::vector<Scanner> make_scanners(int scale, std::mt19937_64 & rng) {
+        const int row_length = 4000000 * std::min(scale, 500);
+
+        std::vector<Scanner> scanners;
+        for (int i = 0; i != 25 * scale; ++i) {
+            const int x = static_cast<int>(rng() % row_length);
+            const int y = static_cast<int>(rng() % 2000000) - 1000000;
+            const int dx = static_cast<int>(rng() % 1000000) - 500000;
+            const int dy = static_cast<int>(rng() % 1000000) - 500000;
+            scanners.push_back(Scanner{ x, y, x + dx, y + dy });
+        }
+        return scanners;
+    }
+
+    /** The part A of the former 2022/15 */
+    std::size_t former_row(const std::vector<Scanner> & scanners, int scanned_y) {
+        enum class SlotStatus { Scanner, Beacon, Scanned };
+
+        std::map<int, SlotStatus> status;
+
+        for (const Scanner & scanner : scanners) {
+            if (scanner.y == scanned_y) status[scanner.x] = SlotStatus::Scanner;
+            if (scanner.beacon_y == scanned_y) status[scanner.beacon_x] = SlotStatus::Beacon;
+        }
+
+        for (const Scanner & scanner : scanners) {
+            const int distance_to_scanline = std::abs(scanner.y - scanned_y);
+            const int distance_to_beacon = scanner.get_distance_to_beacon();
+            if (distance_to_scanline > distance_to_beacon) continue;
+
+            for (int dx = -distance_to_beacon; dx <= distance_to_beacon; ++dx) {
+                if (std::abs(dx) + distance_to_scanline > distance_to_beacon) continue;
+                status.try_emplace(scanner.x + dx, SlotStatus::Scanned);
+            }
+        }
+
+        std::size_t answer = 0;
+        for (const auto & [x, slot] : status) {
+            if (slot != SlotStatus::Beacon) ++answer;
+        }
+        return answer;
+    }
+
+    std::size_t interval_set_row(const std::vector<Scanner> & scanners, int scanned_y) {
+        std::vector<bj::Interval<int>> scanned;
+        std::vector<bj::Interval<int>> beacons;
+
+        for (const Scanner & scanner : scanners) {
+            const int remaining = scanner.get_distance_to_beacon() - std::abs(scanner.y - scanned_y);
+            if (remaining >= 0) scanned.push_back(bj::Interval<int>::closed(scanner.x - remaining, scanner.x + remaining));
+            if (scanner.beacon_y == scanned_y) beacons.push_back(bj::Interval<int>::closed(scanner.beacon_x, scanner.beacon_x));
+        }
+
+        const bj::IntervalSet<int> no_beacon = bj::IntervalSet<int>(std::move(scanned)) - bj::IntervalSet<int>(std::move(beacons));
+        return static_cast<std::size_t>(no_beacon.size());
+    }
+}
+
+int main(int argc, char ** argv) {
+    const int max_scale = argc > 1 ? std::atoi(argv[1]) : 1000;
+
+    std::mt19937_64 rng(2023);
+    bool same_results = true;
+
+    std::printf("%-8s %6s %12s %12s\n", "Day", "Scale", "former ms", "interval ms");
+
+    for (int scale = 1; scale <= max_scale; scale *= 10) {
+        const Almanac almanac = make_almanac(scale, rng);
+
+        Lowest former {};
+        const bool run_former = scale <= 100;
+        const double former_ms = run_former ? time_ms([&]() { former = former_almanac(almanac); }) : 0.;
+
+        Lowest current {};
+        const double current_ms = time_ms([&]() { current = interval_set_almanac(almanac); });
+
+        std::printf("%-8s %6d ", "2023/05", scale);
+        if (run_former) std::printf("%12.2f ", former_ms); else std::printf("%12s ", "-");
+        std::printf("%12.2f", current_ms);
+
+        if (run_former && (former.min != current.min || former.size != current.size)) {
+            std::printf("  the results differ");
+            same_results = false;
+        }
+        std::printf("\n");
+    }
+
+    for (int scale = 1; scale <= max_scale; scale *= 10) {
+        const std::vector<Scanner> scanners = make_scanners(scale, rng);
+
+        std::size_t former = 0;
+        const bool run_former = scale <= 1;
+        const double former_ms = run_former ? time_ms([&]() { former = former_row(scanners, 0); }) : 0.;
+
+        std::size_t current = 0;
+        const double current_ms = time_ms([&]() { current = interval_set_row(scanners, 0); });
+
+        std::printf("%-8s %6d ", "2022/15", scale);
+        if (run_former) std::printf("%12.2f ", former_ms); else std::printf("%12s ", "-");
+        std::printf("%12.2f", current_ms);
+
+        if (run_former && former != current) {
+            std::printf("  the results differ");
+            same_results = false;
+        }
+        std::printf("\n");
+    }
+
+    return same_results ? EXIT_SUCCESS : EXIT_FAILURE;
+}
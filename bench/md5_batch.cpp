@@ -0,0 +1,152 @@
+// Checks that every MD5 kernel of util/md5_batch.hpp gives the digests of
+// the scalar MD5 of util/md5.h, then times them. Built by `make bench` in the
+// root folder, and run from the root folder:
+//
+//     ./build/release/bench/md5_batch [messages to time]
+//
+// The messages are hashed by digest_batch and stretched_digest_batch with
+// each kernel supported by the CPU and with the kernel chosen at runtime:
+// - every size from 0 to 120 bytes, so the sizes around the 55/56 bytes
+// limit of a single block and the long messages hashed by the scalar
+// fallback in the middle of the short ones,
+// - every number of messages from 1 to 35, so the last group of lanes is
+// partial for every kernel.
+// The program fails if a digest differs.
+
+#include "../util/md5.h"
+#include "../util/md5_batch.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    /** The kernels to check, nullopt for the one chosen at runtime */
+    const std::vector<std::optional<bj::md5::Kernel>> kernels {
+        bj::md5::Kernel::Scalar, bj::md5::Kernel::Lanes4, bj::md5::Kernel::Lanes8, bj::md5::Kernel::Lanes16, std::nullopt
+    };
+
+    std::string name_of(std::optional<bj::md5::Kernel> kernel) {
+        if (!kernel) return std::string("runtime (") + bj::md5::kernel_name(bj::md5::best_kernel()) + ")";
+        return bj::md5::kernel_name(*kernel);
+    }
+
+    /** The hex of the message hashed 1 + stretches times by the scalar MD5 */
+    std::string reference(std::string_view message, std::size_t stretches) {
+        MD5 md5;
+        std::string hex = md5(message.data(), message.size());
+        for (std::size_t i = 0; i != stretches; ++i) {
+            hex = md5(hex);
+        }
+        return hex;
+    }
+
+    /** Messages of every size from 0 to 120 bytes, in a shuffled order of sizes */
+    std::vector<std::string> make_messages() {
+        std::vector<std::string> messages;
+        for (std::size_t i = 0; i <= 120; ++i) {
+            const std::size_t size = (i * 37) % 121;
+
+            std::string message;
+            for (std::size_t c = 0; c != size; ++c) {
+                message += static_cast<char>('!' + (c * 7 + size) % 90);
+            }
+            messages.emplace_back(std::move(message));
+        }
+        return messages;
+    }
+
+    /**
+     * Hashes the first `count` messages with the kernel and compares them with
+     * the reference. Returns the number of wrong digests.
+     */
+    std::size_t check(
+        std::optional<bj::md5::Kernel> kernel,
+        const std::vector<std::string_view> & messages, std::size_t count, std::size_t stretches
+    ) {
+        const std::span<const std::string_view> batch(messages.data(), count);
+        std::vector<bj::md5::Digest> digests(count);
+
+        if (stretches == 0) {
+            if (kernel) bj::md5::digest_batch(batch, digests.data(), *kernel);
+            else        bj::md5::digest_batch(batch, digests.data());
+        } else {
+            if (kernel) bj::md5::stretched_digest_batch(batch, stretches, digests.data(), *kernel);
+            else        bj::md5::stretched_digest_batch(batch, stretches, digests.data());
+        }
+
+        std::size_t wrong = 0;
+        for (std::size_t i = 0; i != count; ++i) {
+            const std::string expected = reference(messages[i], stretches);
+            const std::string computed = bj::md5::to_hex(digests[i]);
+            if (computed != expected) {
+                if (wrong == 0) {
+                    std::printf("  %s, %zu messages, %zu stretches: the message of %zu bytes gives %s instead of %s\n",
+                        name_of(kernel).c_str(), count, stretches, messages[i].size(), computed.c_str(), expected.c_str());
+                }
+                ++wrong;
+            }
+        }
+        return wrong;
+    }
+
+    double time_ms(std::optional<bj::md5::Kernel> kernel, const std::vector<std::string_view> & messages) {
+        std::vector<bj::md5::Digest> digests(messages.size());
+
+        const auto start = std::chrono::steady_clock::now();
+        if (kernel) bj::md5::digest_batch(messages, digests.data(), *kernel);
+        else        bj::md5::digest_batch(messages, digests.data());
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+}
+
+int main(int argc, char ** argv) {
+    const std::size_t timed_messages = argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 4000000;
+
+    const std::vector<std::string> owned = make_messages();
+    const std::vector<std::string_view> messages(owned.begin(), owned.end());
+
+    // Short messages like the ones of the mining days
+    std::vector<std::string> timed_owned;
+    timed_owned.reserve(timed_messages);
+    for (std::size_t i = 0; i != timed_messages; ++i) timed_owned.emplace_back("abcdefgh" + std::to_string(i));
+    const std::vector<std::string_view> timed(timed_owned.begin(), timed_owned.end());
+
+    bool all_valid = true;
+
+    std::printf("%-20s %10s %12s\n", "Kernel", "Check", "MH/s");
+
+    for (const std::optional<bj::md5::Kernel> kernel : kernels) {
+        if (kernel && !bj::md5::is_supported(*kernel)) {
+            std::printf("%-20s %10s\n", name_of(kernel).c_str(), "no CPU");
+            continue;
+        }
+
+        std::size_t wrong = 0;
+
+        // Every size, and every partial last group of lanes
+        wrong += check(kernel, messages, messages.size(), 0);
+        wrong += check(kernel, messages, messages.size(), 1);
+        for (std::size_t count = 1; count <= 35; ++count) {
+            wrong += check(kernel, messages, count, 0);
+            wrong += check(kernel, messages, count, 3);
+        }
+
+        // The stretching of 2016/14
+        wrong += check(kernel, messages, 21, 2016);
+
+        all_valid = all_valid && wrong == 0;
+
+        const double ms = time_ms(kernel, timed);
+        std::printf("%-20s %10s %12.1f\n", name_of(kernel).c_str(), wrong == 0 ? "ok" : "WRONG",
+            static_cast<double>(timed_messages) / ms / 1000.);
+    }
+
+    return all_valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,242 @@
+// Compares the std::regex parsing that the days used with bj::Pattern, on
+// the inputs of the days. Built by `make bench` in the root folder, and run
+// from the root folder:
+//
+//     ./build/release/bench/parsers [repetitions]
+//
+// The regex path is the one of the former InstructionReader: regex_search,
+// then the captures are copied in a std::vector<std::string>. The regexes are
+// built once, out of the timed loop, so the regex path is at its best.
+
+#include "../util/pattern.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    /** Sum of the captures, so the compiler does not remove the parsing */
+    void consume(int value, std::size_t & checksum) { checksum += static_cast<std::size_t>(value); }
+    void consume(char value, std::size_t & checksum) { checksum += static_cast<std::size_t>(value); }
+    void consume(std::string_view value, std::size_t & checksum) { checksum += value.size(); }
+
+    template<bj::FixedString Text>
+    bool match_one(std::string_view line, std::size_t & checksum) {
+        typename bj::Pattern<Text>::Captures values;
+        if (!bj::Pattern<Text>::match_into(line, values)) return false;
+
+        std::apply([&](const auto & ... value) { (consume(value, checksum), ...); }, values);
+        return true;
+    }
+
+    /** Tries the patterns in order, like the handlers of an InstructionReader */
+    template<bj::FixedString... Texts>
+    bool match_any(std::string_view line, std::size_t & checksum) {
+        return (match_one<Texts>(line, checksum) || ...);
+    }
+
+    using PatternMatcher = bool (*)(std::string_view, std::size_t &);
+
+    struct Case {
+        const char * day;
+        const char * input;
+        std::vector<const char *> regexes;
+        PatternMatcher pattern;
+        /** The lines are split on the spaces, and each part is parsed (2020/04) */
+        bool split_on_spaces = false;
+    };
+
+    const std::vector<Case> cases = {
+        { "2015/06", "2015/inputs/06_tosolve.txt",
+            { R"(^(turn off|turn on|toggle) ([0-9]+),([0-9]+) through ([0-9]+),([0-9]+)$)" },
+            match_any<"{turn on|turn off|toggle} {digits},{digits} through {digits},{digits}">
+        },
+        { "2015/14", "2015/inputs/14_tosolve.txt",
+            { R"(^([A-Za-z]*) can fly ([0-9]+) km\/s for ([0-9]+) seconds?, but then must rest for ([0-9]+) seconds?\.$)" },
+            match_any<"{word} can fly {digits} km/s for {digits} {seconds|second}, but then must rest for {digits} {seconds|second}.">
+        },
+        { "2015/15", "2015/inputs/15_tosolve.txt",
+            { R"(^([a-zA-Z]*): capacity (-?[0-9]+), durability (-?[0-9]+), flavor (-?[0-9]+), texture (-?[0-9]+), calories (-?[0-9]+)$)" },
+            match_any<"{word}: capacity {int}, durability {int}, flavor {int}, texture {int}, calories {int}">
+        },
+        { "2015/16", "2015/inputs/16_tosolve.txt",
+            { R"(^Sue ([0-9]+): ([a-z]*): ([0-9]+), ([a-z]*): ([0-9]+), ([a-z]*): ([0-9]+)$)" },
+            match_any<"Sue {digits}: {word}: {digits}, {word}: {digits}, {word}: {digits}">
+        },
+        { "2015/23", "2015/inputs/23_tosolve.txt",
+            { R"(^([a-z]*) (a|b)?,? *((\+|-)[0-9]*)?$)" },
+            match_any<"{hlf|tpl|inc} {a|b}", "jmp {int}", "{jie|jio} {a|b}, {int}">
+        },
+        { "2016/04", "2016/inputs/04_tosolve.txt",
+            { R"(^([a-z\-]*)-([0-9]*)\[([a-z]*)\]$)" },
+            match_any<"{str}-{digits}[{word}]">
+        },
+        { "2016/08", "2016/inputs/08_tosolve.txt",
+            { R"(^rect ([0-9]*)x([0-9]*)$)", R"(^rotate row y=([0-9]*) by ([0-9]*)$)", R"(^rotate column x=([0-9]*) by ([0-9]*)$)" },
+            match_any<"rect {digits}x{digits}", "rotate row y={digits} by {digits}", "rotate column x={digits} by {digits}">
+        },
+        { "2016/10", "2016/inputs/10_tosolve.txt",
+            { R"(^value ([0-9]*) goes to bot ([0-9]*)$)", R"(^bot ([0-9]*) gives low to (bot|output) ([0-9]*) and high to (bot|output) ([0-9]*)$)" },
+            match_any<"value {digits} goes to bot {digits}", "bot {digits} gives low to {bot|output} {digits} and high to {bot|output} {digits}">
+        },
+        { "2016/21", "2016/inputs/21_puzzle.txt",
+            {
+                R"(swap position ([0-9]) with position ([0-9]))", R"(swap letter ([a-z]) with letter ([a-z]))",
+                R"(rotate left ([0-9]) steps?)", R"(rotate right ([0-9]) steps?)",
+                R"(rotate based on position of letter ([a-z]))", R"(reverse positions ([0-9]) through ([0-9]))",
+                R"(move position ([0-9]) to position ([0-9]))"
+            },
+            match_any<
+                "swap position {digits} with position {digits}", "swap letter {char} with letter {char}",
+                "rotate left {digits} {steps|step}", "rotate right {digits} {steps|step}",
+                "rotate based on position of letter {char}", "reverse positions {digits} through {digits}",
+                "move position {digits} to position {digits}"
+            >
+        },
+        { "2020/04", "2020/inputs/04_real.txt",
+            { R"(^ ?([a-z]*):([#|0-9a-zA-Z]*))" },
+            match_any<"{word}:{str}">,
+            true
+        },
+        { "2020/16", "2020/inputs/16_tosolve.txt",
+            { R"(([a-z ]*): ([0-9]*)-([0-9]*) or ([0-9]*)-([0-9]*))" },
+            match_any<"{str}: {digits}-{digits} or {digits}-{digits}">
+        },
+        { "2021/02", "2021/inputs/02_real.txt",
+            { R"(forward ([0-9]+))", R"(down ([0-9]+))", R"(up ([0-9]+))" },
+            match_any<"forward {digits}", "down {digits}", "up {digits}">
+        },
+        { "2021/05", "2021/inputs/05_real.txt",
+            { R"(([0-9]+),([0-9]+) -> ([0-9]+),([0-9]+))" },
+            match_any<"{digits},{digits} -> {digits},{digits}">
+        },
+        { "2021/22", "2021/inputs/22_real.txt",
+            { R"((on|off) x=(-?[0-9]+)\.\.(-?[0-9]+),y=(-?[0-9]+)\.\.(-?[0-9]+),z=(-?[0-9]+)\.\.(-?[0-9]+))" },
+            match_any<"{on|off} x={int}..{int},y={int}..{int},z={int}..{int}">
+        },
+        { "2021/24", "2021/inputs/24_real.txt",
+            { R"(inp ([a-z]))", R"(([a-z]+) ([a-z]) (-?[0-9]+))", R"(([a-z]+) ([a-z]) ([a-z]))" },
+            match_any<"inp {char}", "{word} {char} {int}", "{word} {char} {char}">
+        },
+        { "2022/04", "2022/inputs/04_puzzle.txt",
+            { R"(([0-9]*)-([0-9]*),([0-9]*)-([0-9]*))" },
+            match_any<"{digits}-{digits},{digits}-{digits}">
+        },
+        { "2022/05", "2022/inputs/05_puzzle.txt",
+            { R"(move ([0-9]*) from ([0-9]*) to ([0-9]*))" },
+            match_any<"move {digits} from {digits} to {digits}">
+        },
+        { "2022/15", "2022/inputs/15_puzzle.txt",
+            { R"(Sensor at x=(-?\d+), y=(-?\d+): closest beacon is at x=(-?\d+), y=(-?\d+))" },
+            match_any<"Sensor at x={int}, y={int}: closest beacon is at x={int}, y={int}">
+        },
+        { "2022/16", "2022/inputs/16_puzzle.txt",
+            { R"(Valve ([A-Z][A-Z]) has flow rate=(\d+); tunnels? leads? to valves? (.*))" },
+            match_any<"Valve {word} has flow rate={digits}; {tunnels lead to valves|tunnel leads to valve} {str}">
+        },
+        { "2023/19", "2023/inputs/19_puzzle.txt",
+            { R"(\{x=(\d*),m=(\d*),a=(\d*),s=(\d*)\})" },
+            match_any<"{{x={digits},m={digits},a={digits},s={digits}}}">
+        },
+        { "2023/22", "2023/inputs/22_puzzle.txt",
+            { R"(^(\d*),(\d*),(\d*)~(\d*),(\d*),(\d*)$)" },
+            match_any<"{digits},{digits},{digits}~{digits},{digits},{digits}">
+        },
+    };
+
+    std::vector<std::string> read_items(const Case & c) {
+        std::vector<std::string> items;
+        std::ifstream file(c.input);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!c.split_on_spaces) {
+                items.push_back(line);
+                continue;
+            }
+
+            std::istringstream parts(line);
+            std::string part;
+            while (parts >> part) items.push_back(part);
+        }
+        return items;
+    }
+
+    struct Measure {
+        double nanoseconds_per_line;
+        std::size_t matched_lines;
+    };
+
+    template<typename Parse>
+    Measure measure(const std::vector<std::string> & items, int repetitions, Parse parse) {
+        std::size_t matched = 0;
+        std::size_t checksum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int repetition = 0; repetition != repetitions; ++repetition) {
+            matched = 0;
+            for (const std::string & item : items) {
+                if (parse(item, checksum)) ++matched;
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        // The checksum is printed nowhere but has to be computed
+        asm volatile("" : : "r"(checksum));
+
+        const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+        return Measure{ nanoseconds / static_cast<double>(items.size() * repetitions), matched };
+    }
+}
+
+int main(int argc, char ** argv) {
+    const int repetitions = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    std::printf("%-8s %7s %12s %12s %8s\n", "Day", "Lines", "regex ns", "pattern ns", "Speedup");
+
+    bool same_matches = true;
+    for (const Case & c : cases) {
+        const std::vector<std::string> items = read_items(c);
+        if (items.empty()) {
+            std::printf("%-8s missing input %s\n", c.day, c.input);
+            continue;
+        }
+
+        std::vector<std::regex> regexes;
+        for (const char * regex : c.regexes) regexes.emplace_back(regex);
+
+        const Measure regex = measure(items, repetitions, [&](const std::string & line, std::size_t & checksum) {
+            std::smatch matches;
+            for (const std::regex & r : regexes) {
+                if (!std::regex_search(line, matches, r)) continue;
+
+                std::vector<std::string> values;
+                for (std::size_t i = 1; i < matches.size(); ++i) values.push_back(matches[i].str());
+                for (const std::string & value : values) checksum += value.size();
+                return true;
+            }
+            return false;
+        });
+
+        const Measure pattern = measure(items, repetitions, [&](const std::string & line, std::size_t & checksum) {
+            return c.pattern(line, checksum);
+        });
+
+        std::printf("%-8s %7zu %12.1f %12.1f %7.1fx",
+            c.day, items.size(), regex.nanoseconds_per_line, pattern.nanoseconds_per_line,
+            regex.nanoseconds_per_line / pattern.nanoseconds_per_line
+        );
+
+        if (regex.matched_lines != pattern.matched_lines) {
+            std::printf("  matched lines differ: %zu with the regex, %zu with the pattern", regex.matched_lines, pattern.matched_lines);
+            same_matches = false;
+        }
+        std::printf("\n");
+    }
+
+    return same_matches ? EXIT_SUCCESS : EXIT_FAILURE;
+}
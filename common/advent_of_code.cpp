@@ -1,22 +1,143 @@
 #include <iostream>
 #include "configuration.h"
+#include "bench_environment.h"
+#include "input_file.h"
+#include "isolation.h"
+#include "options.h"
+#include "output_capture.h"
+#include "report.h"
+#include "result_cache.h"
+#include "scale.h"
+#include "scheduler.h"
 #include <algorithm>
 #include "colors.h"
+#include <cmath>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <cstdlib>
+#include <limits>
 #include <map>
+#include <mutex>
+#include <set>
+#include <thread>
 
-void print(const InputConfig & config, const std::optional<test::RunResult> & r);
+void print(const InputConfig & config, const std::optional<test::RunResult> & r, const test::HarnessOptions & options);
 
-void dispatch(const InputConfig & config, test::Score & ts, const std::array<DayEntryPoint *, 25> & days) {
-    if (DayEntryPoint * day = days[config.day - 1]) {
-        std::optional<test::RunResult> r = config.run(day);
-        print(config, r);
-        ts += r;
-    } else {
-        print(config, std::nullopt);
+static std::set<std::pair<DayEntryPoint *, DayViewEntryPoint *>> & sequential_days() {
+    static std::set<std::pair<DayEntryPoint *, DayViewEntryPoint *>> days;
+    return days;
+}
+
+bool register_sequential_day(DayEntry entry_point) {
+    sequential_days().emplace(entry_point.strings, entry_point.views);
+    return true;
+}
+
+bool is_sequential_day(DayEntry entry_point) {
+    return sequential_days().contains(std::pair(entry_point.strings, entry_point.views));
+}
+
+static std::map<std::pair<DayEntryPoint *, DayViewEntryPoint *>, test::ScaleGenerator *> & scale_generators() {
+    static std::map<std::pair<DayEntryPoint *, DayViewEntryPoint *>, test::ScaleGenerator *> generators;
+    return generators;
+}
+
+bool register_scale_generator(DayEntry entry_point, test::ScaleGenerator * generator) {
+    scale_generators().emplace(std::pair(entry_point.strings, entry_point.views), generator);
+    return true;
+}
+
+test::ScaleGenerator * scale_generator_of(DayEntry entry_point) {
+    const auto it = scale_generators().find(std::pair(entry_point.strings, entry_point.views));
+    return it != scale_generators().end() ? it->second : nullptr;
+}
+
+namespace {
+    /** Results of the configs, filled by the workers and printed in config order */
+    class ResultBoard {
+        struct Slot {
+            bool done = false;
+            std::optional<test::RunResult> result;
+        };
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::vector<Slot> m_slots;
+
+    public:
+        explicit ResultBoard(size_t size) : m_slots(size) {}
+
+        void publish(size_t i, std::optional<test::RunResult> result) {
+            {
+                std::lock_guard lock(m_mutex);
+                m_slots[i].result = std::move(result);
+                m_slots[i].done = true;
+            }
+            m_condition.notify_all();
+        }
+
+        std::optional<test::RunResult> wait(size_t i) {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [&]() { return m_slots[i].done; });
+            return m_slots[i].result;
+        }
+    };
+
+    /**
+     * Groups the configs into jobs, the longest first according to the
+     * recorded timings. Configs of sequential days all go into the same job.
+     */
+    std::vector<std::vector<size_t>> make_jobs(
+        const std::vector<InputConfig> & configs,
+        const std::vector<DayEntry> & entries,
+        const test::RecordedTimings & timings
+    ) {
+        std::vector<std::vector<size_t>> jobs;
+        std::map<std::pair<DayEntryPoint *, DayViewEntryPoint *>, size_t> sequential_job_of_day;
+
+        for (size_t i = 0; i != configs.size(); ++i) {
+            const DayEntry day = entries[i];
+            if (!day) continue;
+
+            if (is_sequential_day(day)) {
+                const auto [it, inserted] = sequential_job_of_day.emplace(std::pair(day.strings, day.views), jobs.size());
+                if (inserted) jobs.emplace_back();
+                jobs[it->second].emplace_back(i);
+            } else {
+                jobs.emplace_back(std::vector<size_t>{ i });
+            }
+        }
+
+        // Configs that were never timed are assumed to be long
+        const auto expected_duration = [&](const std::vector<size_t> & job) {
+            double total = 0.;
+            for (const size_t i : job) {
+                const auto seconds = timings.get(configs[i].day, configs[i].filename);
+                if (!seconds) return std::numeric_limits<double>::infinity();
+                total += *seconds;
+            }
+            return total;
+        };
+
+        std::stable_sort(jobs.begin(), jobs.end(),
+            [&](const auto & lhs, const auto & rhs) { return expected_duration(lhs) > expected_duration(rhs); }
+        );
+
+        return jobs;
+    }
+
+    /** Runs the config, keeping what it writes to print it after its row */
+    std::optional<test::RunResult> run_captured(const InputConfig & config, DayEntry entry, const test::RunSettings & settings) {
+        test::OutputCapture capture;
+        std::optional<test::RunResult> result = config.run(entry, settings);
+        if (result) result->output = capture.take();
+        return result;
     }
 }
 
-void print(const InputConfig & config, const std::optional<test::RunResult> & r) {
+void print(const InputConfig & config, const std::optional<test::RunResult> & r, const test::HarnessOptions & options) {
     // I really hate std::ostream, and std::format is not yet available in g++
     // So let's pretend it's C even thought that's unsafe
 
@@ -32,8 +153,34 @@ void print(const InputConfig & config, const std::optional<test::RunResult> & r)
     if (!r) {
         std::cout << KRED << "No handler";
     } else {
-        const auto t = static_cast<int>(r->elapsed_time.count() * 1000);
-        std::sprintf(buffer, "%5d ms   ", t); std::cout << buffer;
+        std::sprintf(buffer, "%9s   ", r->cached ? "cached" : test::format_duration(r->timings.median()).c_str());
+        std::cout << buffer;
+
+        if (options.is_bench()) {
+            std::sprintf(buffer, "min %9s  p90 %9s  sd %9s   ",
+                test::format_duration(r->timings.min()).c_str(),
+                test::format_duration(r->timings.p90()).c_str(),
+                test::format_duration(r->timings.stddev()).c_str()
+            );
+            std::cout << buffer;
+        }
+
+        if (!r->phases[0].empty()) {
+            std::sprintf(buffer, "P %9s  A %9s  B %9s   ",
+                test::format_duration(r->phases[static_cast<size_t>(test::Phase::Parse)].median()).c_str(),
+                test::format_duration(r->phases[static_cast<size_t>(test::Phase::PartA)].median()).c_str(),
+                test::format_duration(r->phases[static_cast<size_t>(test::Phase::PartB)].median()).c_str()
+            );
+            std::cout << buffer;
+        }
+
+        if (r->counters) {
+            std::cout << r->counters->summary() << "  ";
+        }
+
+        if (r->allocations) {
+            std::cout << r->allocations->summary() << "  ";
+        }
 
         for (const std::optional<test::PartResult> & part_result : r->parts) {
             if (!part_result) {
@@ -52,6 +199,12 @@ void print(const InputConfig & config, const std::optional<test::RunResult> & r)
                 case test::TestValidation::Fail:
                     std::sprintf(buffer, KRED "%-15s EXP=%-15s ", part_result->computed.c_str(), part_result->expected.c_str());
                     break;
+                case test::TestValidation::Timeout:
+                    std::sprintf(buffer, KMAG "%-35s ", "TIMEOUT");
+                    break;
+                case test::TestValidation::Crash:
+                    std::sprintf(buffer, KYEL "CRASH %-29s ", part_result->computed.c_str());
+                    break;
             }
 
             std::cout << buffer;
@@ -61,38 +214,491 @@ void print(const InputConfig & config, const std::optional<test::RunResult> & r)
     std::cout << RST "\n";
 }
 
-void run_aoc(const std::array<DayEntryPoint *, 25> & entries, int argc, const char * argv[]) {
-    const int day = argc > 1 ? std::stoi(argv[1]) : -2;
+static void print_summary(const test::Score & testScore, const test::HarnessOptions & options, std::chrono::duration<double> wall_time) {
+    const auto format_time = [](std::chrono::duration<double> duration) {
+        char time[256];
+        std::sprintf(time, "%02ld:%02ld:%03ld",
+            std::chrono::duration_cast<std::chrono::minutes>(duration).count(),
+            std::chrono::duration_cast<std::chrono::seconds>(duration).count() % 60,
+            std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() % 1000
+        );
+        return std::string(time);
+    };
 
-    auto configs = InputConfig::read_configuration();
+    std::cout << "\x1B[1m"
+              << "\nTotal  = " << testScore.total()
+              << "\n" KGRN "Success= " << testScore.success
+              << "\n" KRED "Failed = " << testScore.failed << RST << '\n';
 
-    const int required_day = day != -2 ? day : InputConfig::last_day(configs);
+    if (testScore.timeout != 0) {
+        std::cout << "\x1B[1m" KMAG "Timeout= " << testScore.timeout << RST << '\n';
+    }
+
+    if (testScore.crashed != 0) {
+        std::cout << "\x1B[1m" KYEL "Crashed= " << testScore.crashed << RST << '\n';
+    }
+
+    std::cout << "\n\x1B[1m" KCYN     "Time = " << format_time(testScore.total_time.median()) << RST << '\n';
+
+    if (!testScore.total_phases[0].empty()) {
+        std::cout << "\x1B[1m" KCYN "       of which, for the days that mark their phases: "
+                  << "parse " << test::format_duration(testScore.total_phases[static_cast<size_t>(test::Phase::Parse)].median())
+                  << "  part A " << test::format_duration(testScore.total_phases[static_cast<size_t>(test::Phase::PartA)].median())
+                  << "  part B " << test::format_duration(testScore.total_phases[static_cast<size_t>(test::Phase::PartB)].median())
+                  << RST << '\n';
+    }
+
+    if (options.is_bench()) {
+        std::cout << "\x1B[1m" KCYN "       min " << test::format_duration(testScore.total_time.min())
+                  << "  p90 " << test::format_duration(testScore.total_time.p90())
+                  << "  sd " << test::format_duration(testScore.total_time.stddev())
+                  << " over " << *options.bench_runs << " runs" << RST << '\n';
+    }
+
+    if (options.jobs > 1) {
+        std::cout << "\x1B[1m" KCYN "Wall = " << format_time(wall_time)
+                  << " (" << options.jobs << " workers)" << RST << '\n';
+    }
+
+    if (options.is_bench() || options.pin_cpu) {
+        std::cout << "\x1B[1m" KCYN "Machine: " << test::machine_state().summary() << RST << '\n';
+    }
+}
+
+static constexpr const char * result_cache_path = ".aoc_cache";
+static constexpr const char * shards_path = ".aoc_shards";
+static constexpr const char * profiles_path = "profiles";
+
+/**
+ * The threads that each solver may use. The configs that run in parallel
+ * already use the cores, a pinned process has one core, and the counters
+ * and the profiler only see the thread that calls the solver.
+ */
+static unsigned int solver_threads_of(const test::HarnessOptions & options, const test::RunSettings & settings, bool configs_in_parallel) {
+    if (configs_in_parallel || options.pin_cpu || settings.count_events || settings.profile) return 1;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * Runs the solvers whose day has a scale generator on inputs generated from
+ * their configs, and prints the median duration for each size with the
+ * exponent k of duration ~ size^k.
+ */
+static void run_scale(const std::vector<InputConfig> & configs, const std::vector<DayEntry> & entries, const test::HarnessOptions & options) {
+    test::RunSettings settings;
+    settings.warmup_runs = options.is_bench() ? options.warmup_runs : 1;
+    settings.timed_runs = options.is_bench() ? *options.bench_runs : 3;
+    settings.timeout = options.timeout;
+    settings.solver_threads = solver_threads_of(options, settings, false);
+
+    std::optional<std::pair<int, int>> last_seen_day = std::nullopt;
+
+    for (size_t i = 0; i != configs.size(); ++i) {
+        if (!entries[i] || configs[i].m_is_inline) continue;
+
+        test::ScaleGenerator * const generator = scale_generator_of(entries[i]);
+        if (!generator) continue;
+
+        const InputFile file(configs[i].filename);
+        if (!file.is_open()) continue;
+
+        if (last_seen_day.has_value() && std::pair(configs[i].year, configs[i].day) != *last_seen_day) {
+            std::cout << "\n";
+        }
+        last_seen_day = std::pair(configs[i].year, configs[i].day);
+
+        // The answers of the generated inputs are not known
+        const InputConfig config = configs[i].without_expected_values();
+
+        std::cout << "\x1B[1m" << (config.year != 0 ? std::to_string(config.year) + " " : "")
+                  << "Day " << config.day << " " << config.filename << RST "\n";
+
+        std::vector<std::pair<unsigned int, std::chrono::nanoseconds>> points;
+
+        for (const unsigned int factor : options.scale_factors) {
+            // The same seed for every run, so two runs measure the same inputs
+            const std::vector<std::string> generated = factor == 1
+                ? std::vector<std::string>{}
+                : generator(file.lines(), factor, 0x5CA1E + factor);
+            const std::vector<std::string_view> generated_views(generated.begin(), generated.end());
+
+            const std::span<const std::string_view> lines = factor == 1
+                ? file.lines()
+                : std::span<const std::string_view>(generated_views);
+
+            const std::optional<test::RunResult> r = config.run(entries[i], lines, settings);
+            if (!r) break;
+
+            const bool timed_out = std::any_of(r->parts.begin(), r->parts.end(),
+                [](const auto & part) { return part && part->type == test::TestValidation::Timeout; }
+            );
+
+            std::cout << "  x" << std::left << std::setw(5) << factor << std::right
+                      << std::setw(8) << lines.size() << " lines  ";
+
+            if (timed_out) {
+                std::cout << KMAG "TIMEOUT" RST "\n";
+                break;
+            }
+
+            std::cout << std::setw(10) << test::format_duration(r->timings.median()) << "\n";
+            points.emplace_back(factor, r->timings.median());
+        }
+
+        const double exponent = test::fit_exponent(points);
+        if (!std::isnan(exponent)) {
+            std::cout << "  ~ n^" << std::fixed << std::setprecision(2) << exponent << std::defaultfloat << "\n";
+        }
+    }
+}
+
+static std::ostream & messages_of(const test::HarnessOptions & options) {
+    // Machine readable formats keep the standard output for the results
+    return options.format == test::OutputFormat::Table ? std::cout : std::cerr;
+}
+
+/** Writes the call stacks sampled in the configs of each day in profiles/YEAR-dayXX.folded */
+static void write_profiles(const std::vector<test::ReportEntry> & entries, std::ostream & messages) {
+    std::map<std::pair<int, int>, test::FoldedStacks> days;
+    for (const test::ReportEntry & entry : entries) {
+        if (entry.result && !entry.result->profile.empty()) {
+            test::add_stacks(days[std::pair(entry.config->year, entry.config->day)], entry.result->profile);
+        }
+    }
+
+    if (days.empty()) return;
+
+    std::error_code error;
+    std::filesystem::create_directories(profiles_path, error);
+
+    for (const auto & [day, stacks] : days) {
+        char name[32];
+        if (day.first != 0) {
+            std::sprintf(name, "%04d-day%02d.folded", day.first, day.second);
+        } else {
+            std::sprintf(name, "day%02d.folded", day.second);
+        }
+
+        const std::filesystem::path path = std::filesystem::path(profiles_path) / name;
+        std::ofstream file(path);
+        test::write_folded_stacks(file, stacks);
+
+        if (!file) {
+            messages << KRED "Unable to write " << path.string() << RST "\n";
+        }
+    }
+
+    messages << "Call stacks written in " << profiles_path << "/ (flamegraph.pl, inferno-flamegraph or speedscope can read them)\n";
+}
+
+/**
+ * Runs the configs and reports their results. entries[i] is the solver of configs[i].
+ * command_line is the arguments of the process, given to the children of --isolate.
+ */
+static void run_configs(
+    const std::vector<InputConfig> & all_configs, const std::vector<DayEntry> & all_entries,
+    const test::HarnessOptions & options, const std::vector<std::string> & command_line
+) {
+    // A child of --isolate only runs its config, on the affinity of its parent
+    const bool is_isolated_child = options.isolated_child.has_value();
+
+    // Before any thread is started, as they inherit the affinity
+    if (options.pin_cpu && !is_isolated_child) {
+        test::pin_for_benchmark(*options.pin_cpu, std::cerr);
+    }
+
+    if (options.scale) {
+        run_scale(all_configs, all_entries, options);
+        return;
+    }
+
+    // The configs of the shard, with their position in the list of all the configs
+    std::vector<InputConfig> configs;
+    std::vector<DayEntry> entries;
+    std::vector<size_t> positions;
+    for (size_t i = 0; i != all_configs.size(); ++i) {
+        if (!options.shard || i % options.shard->second == options.shard->first - 1) {
+            configs.emplace_back(all_configs[i]);
+            entries.emplace_back(all_entries[i]);
+            positions.emplace_back(i);
+        }
+    }
+
+    std::optional<test::ShardFile::Results> merged;
+    if (options.merge_shards) {
+        merged.emplace();
+        for (unsigned int shard = 1; shard <= *options.merge_shards; ++shard) {
+            if (std::optional<test::ShardFile::Results> results = test::ShardFile::read(shards_path, shard, *options.merge_shards)) {
+                merged->merge(*results);
+            } else {
+                std::cerr << KRED "No results for the shard " << shard << "/" << *options.merge_shards
+                          << " in " << shards_path << RST "\n";
+            }
+        }
+    }
+
+    test::RunSettings settings;
+    if (options.is_bench()) {
+        settings.warmup_runs = options.warmup_runs;
+        settings.timed_runs = *options.bench_runs;
+    }
+    settings.timeout = options.timeout;
+    settings.track_allocations = options.allocations;
+
+    // Benchmarks always run the solvers
+    const test::ResultCache cache(result_cache_path);
+    if (options.cached && !options.is_bench()) {
+        settings.cache = &cache;
+    }
+
+    if (options.counters) {
+        if (const auto probe = test::PerfCounters::open()) {
+            settings.count_events = true;
+
+            if (is_isolated_child) {
+                // Already reported by the parent
+            } else if (!probe->has(test::PerfEvent::Cycles) || !probe->has(test::PerfEvent::Instructions)) {
+                std::cerr << "The hardware performance counters are not available (virtual machine, or "
+                             "refused by /proc/sys/kernel/perf_event_paranoid). Only the software events are reported.\n";
+            }
+        } else if (!is_isolated_child) {
+            std::cerr << "The performance counters are not available (perf_event_open is refused, "
+                         "see /proc/sys/kernel/perf_event_paranoid). Only the durations are reported.\n";
+        }
+    }
+
+    if (options.profile) {
+        if (test::SamplingProfiler::is_available()) {
+            settings.profile = true;
+        } else if (!is_isolated_child) {
+            std::cerr << "The sampling profiler is not available (timer_create is refused, or not on Linux)\n";
+        }
+    }
+
+    settings.solver_threads = solver_threads_of(options, settings, options.jobs > 1 && configs.size() > 1);
+
+    if (is_isolated_child) {
+        const test::CapturedStandardStreams captured_streams;
+        const size_t i = *options.isolated_child;
+        test::run_isolated_child([&]() { return run_captured(all_configs.at(i), all_entries.at(i), settings); });
+    }
+
+    // The children of --isolate are killed when they do not stop by themselves
+    std::optional<std::chrono::milliseconds> isolation_deadline;
+    if (options.isolate && settings.timeout) {
+        isolation_deadline = *settings.timeout * (settings.warmup_runs + settings.timed_runs) + std::chrono::seconds(1);
+    }
+
+    // The arguments of the children of --isolate, followed by the position of their config
+    std::vector<std::string> isolated_arguments = command_line;
+    isolated_arguments.emplace_back("--isolated-child");
+
+    test::RecordedTimings timings(".aoc_timings");
+    ResultBoard results(configs.size());
+
+    std::vector<test::WorkStealingPool::Job> jobs;
+    for (std::vector<size_t> & job : make_jobs(configs, entries, timings)) {
+        jobs.emplace_back([&, job = std::move(job)]() {
+            for (const size_t i : job) {
+                if (merged) {
+                    const auto it = merged->find(positions[i]);
+                    const bool found = it != merged->end() && it->second.first == configs[i].filename;
+                    results.publish(i, found ? it->second.second : std::nullopt);
+                } else if (options.isolate) {
+                    std::vector<std::string> arguments = isolated_arguments;
+                    arguments.emplace_back(std::to_string(positions[i]));
+                    results.publish(i, test::run_isolated(arguments, isolation_deadline));
+                } else {
+                    results.publish(i, run_captured(configs[i], entries[i], settings));
+                }
+            }
+        });
+    }
+
+    // The main thread prints the table while the configs run
+    const test::CapturedStandardStreams captured_streams;
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    std::thread runner([&, jobs = std::move(jobs)]() mutable {
+        test::WorkStealingPool(options.jobs).run(std::move(jobs));
+    });
 
     test::Score testScore;
+    std::vector<test::ReportEntry> report_entries;
+    const bool print_table = options.format == test::OutputFormat::Table;
 
-    std::optional<int> last_seen_day = std::nullopt;
+    std::optional<std::pair<int, int>> last_seen_day = std::nullopt;
 
-    for (const auto & config : configs) {
-        if (config.day == required_day || required_day == 0) {
-            if (last_seen_day.has_value() && config.day != *last_seen_day) {
-                std::cout << "\n";
+    for (size_t i = 0; i != configs.size(); ++i) {
+        const InputConfig & config = configs[i];
+
+        if (print_table && last_seen_day.has_value() && std::pair(config.year, config.day) != *last_seen_day) {
+            std::cout << "\n";
+        }
+        last_seen_day = std::pair(config.year, config.day);
+
+        const std::optional<test::RunResult> r = entries[i] ? results.wait(i) : std::nullopt;
+
+        if (print_table) {
+            print(config, r, options);
+        }
+
+        if (r && !r->output.empty()) {
+            messages_of(options) << r->output;
+        }
+
+        if (print_table) {
+            std::cout.flush();
+        }
+
+        testScore += r;
+        report_entries.emplace_back(test::ReportEntry{ &config, r });
+
+        if (r && !r->cached) {
+            timings.set(config.day, config.filename,
+                std::chrono::duration<double>(r->timings.median()).count()
+            );
+        }
+    }
+
+    runner.join();
+    const std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - wall_start;
+
+    timings.save();
+
+    if (options.shard) {
+        test::ShardFile::Results shard_results;
+        for (size_t i = 0; i != report_entries.size(); ++i) {
+            shard_results.emplace(positions[i], std::pair(configs[i].filename, report_entries[i].result));
+        }
+
+        if (!test::ShardFile::write(shards_path, options.shard->first, options.shard->second, shard_results)) {
+            std::cerr << KRED "Unable to write the results of the shard in " << shards_path << RST "\n";
+        }
+    }
+
+    switch (options.format) {
+        case test::OutputFormat::Table:
+            print_summary(testScore, options, wall_time);
+            break;
+        case test::OutputFormat::Json:
+            test::write_json(std::cout, report_entries);
+            break;
+        case test::OutputFormat::Csv:
+            test::write_csv(std::cout, report_entries);
+            break;
+    }
+
+    std::ostream & messages = messages_of(options);
+
+    if (settings.profile) {
+        write_profiles(report_entries, messages);
+    }
+
+    if (options.compare_with) {
+        const std::optional<std::string> baseline_commit = test::git_rev_parse(*options.compare_with);
+        const auto baseline = baseline_commit
+            ? test::BenchHistory(options.history_path).medians_of(*baseline_commit)
+            : std::map<std::pair<int, std::string>, long long int>{};
+
+        if (!baseline_commit) {
+            messages << KRED "Unknown revision " << *options.compare_with << RST "\n";
+        } else if (baseline.empty()) {
+            messages << KRED "No recorded timings for " << *options.compare_with
+                     << " (" << *baseline_commit << ") in " << options.history_path << RST "\n";
+        } else {
+            messages << "\n\x1B[1mCompared with " << *options.compare_with << " (" << baseline_commit->substr(0, 10) << ")" RST "\n";
+
+            const std::optional<std::string> baseline_machine = test::BenchHistory(options.history_path).machine_of(*baseline_commit);
+            if (baseline_machine && *baseline_machine != test::machine_state().summary()) {
+                messages << KYEL "The timings of " << *options.compare_with << " were recorded with " << *baseline_machine
+                         << ", and now with " << test::machine_state().summary() << RST "\n";
             }
-            last_seen_day = config.day;
+            const unsigned int regressions = test::compare_with_baseline(messages, report_entries, baseline, options.regression_threshold);
+            messages << "\x1B[1m" << (regressions == 0 ? KGRN : KRED) << regressions
+                     << " config(s) more than " << options.regression_threshold << "% slower" RST "\n";
+        }
+    }
 
-            dispatch(config, testScore, entries);
+    if (options.record) {
+        if (const std::optional<std::string> commit = test::git_rev_parse("HEAD")) {
+            test::BenchHistory(options.history_path).append(*commit, test::git_is_dirty(), report_entries);
+        } else {
+            messages << KRED "Not in a git repository, the timings were not recorded" RST "\n";
         }
     }
+}
 
-    char time[256];
-    std::sprintf(time, "%02ld:%02ld:%03ld",
-        std::chrono::duration_cast<std::chrono::minutes>(testScore.total_time).count(),
-        std::chrono::duration_cast<std::chrono::seconds>(testScore.total_time).count() % 60,
-        std::chrono::duration_cast<std::chrono::milliseconds>(testScore.total_time).count() % 1000
-    );
+void run_aoc(const std::array<DayEntry, 25> & days, int argc, const char * argv[]) {
+    const test::HarnessOptions options = test::HarnessOptions::parse(argc, argv);
 
-    std::cout << "\x1B[1m"
-              << "\nTotal  = " << testScore.total()
-              << "\n" KGRN "Success= " << testScore.success
-              << "\n" KRED "Failed = " << testScore.failed << RST << '\n'
-              << "\n\x1B[1m" KCYN     "Time = " << time << RST << '\n';
+    auto all_configs = InputConfig::read_configuration();
+
+    const int required_day = options.day ? *options.day : InputConfig::last_day(all_configs);
+
+    std::vector<InputConfig> configs;
+    std::vector<DayEntry> entries;
+    for (const auto & config : all_configs) {
+        if (config.day == required_day || required_day == 0) {
+            configs.emplace_back(config);
+            entries.emplace_back(days[config.day - 1]);
+        }
+    }
+
+    run_configs(configs, entries, options, std::vector<std::string>(argv, argv + argc));
+}
+
+void run_aoc(std::span<const AocYear> years, int argc, const char * argv[]) {
+    const auto usage_error = [&](const std::string & message) {
+        std::cerr << message << "\n"
+                  << "Usage: " << argv[0] << " all|YEAR [day] [options of the year executables]\n"
+                  << "  all          Run the configs of every year, all days if no day is given\n"
+                  << "  YEAR         Run the configs of a year, its last day if no day is given\n"
+                  << "The inputs are read from YEAR/inputs, relative to the current directory.\n";
+        std::exit(EXIT_FAILURE);
+    };
+
+    if (argc < 2) usage_error("Missing year");
+
+    const std::string_view selection = argv[1];
+    std::vector<const AocYear *> selected_years;
+    if (selection == "all") {
+        for (const AocYear & year : years) selected_years.emplace_back(&year);
+    } else {
+        const auto it = std::find_if(years.begin(), years.end(),
+            [&](const AocYear & year) { return std::to_string(year.year) == selection; }
+        );
+        if (it == years.end()) usage_error("Unknown year " + std::string(selection));
+        selected_years.emplace_back(&*it);
+    }
+
+    // The other arguments are the same as the ones of the executable of a year
+    std::vector<const char *> arguments { argv[0] };
+    arguments.insert(arguments.end(), argv + 2, argv + argc);
+    const test::HarnessOptions options = test::HarnessOptions::parse(static_cast<int>(arguments.size()), arguments.data());
+
+    std::vector<InputConfig> configs;
+    std::vector<DayEntry> entries;
+
+    for (const AocYear * year : selected_years) {
+        const std::array<DayEntry, 25> days = year->days();
+        const auto year_configs = InputConfig::read_configuration(std::to_string(year->year) + "/", year->year);
+        if (year_configs.empty()) continue;
+
+        int required_day = 0;
+        if (options.day) {
+            required_day = *options.day;
+        } else if (selection != "all") {
+            required_day = InputConfig::last_day(year_configs);
+        }
+
+        for (const auto & config : year_configs) {
+            if (config.day == required_day || required_day == 0) {
+                configs.emplace_back(config);
+                entries.emplace_back(days[config.day - 1]);
+            }
+        }
+    }
+
+    run_configs(configs, entries, options, std::vector<std::string>(argv, argv + argc));
 }
@@ -1,19 +1,28 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <variant>
 #include <vector>
 #include <span>
 #include <string>
 #include <string_view>
 #include <optional>
+#include <stdexcept>
 #include <iostream>
 #include <chrono>
+#include <stop_token>
 
 #include <fstream>
 #include <sstream>
 
+#include "allocation_tracker.h"
 #include "colors.h"
+#include "int_scanner.h"
+#include "perf_counters.h"
+#include "sampling_profiler.h"
 
 
 namespace test {
@@ -46,12 +55,16 @@ namespace test {
         [[nodiscard]] bool is_ignore() const noexcept { return type == Type::Ignore; }
     };
     
-    enum class TestValidation { Success, Fail, Computed };
+    /** Timeout: the solver ran for longer than the --timeout of the harness */
+    /** Crash: the solver threw or its process died, with --isolate */
+    enum class TestValidation { Success, Fail, Computed, Timeout, Crash };
 
     inline TestValidation validation_reduce(std::optional<TestValidation> lhs, std::optional<TestValidation> rhs) {
         if (!lhs && !rhs) return TestValidation::Computed;
         if ( lhs && !rhs) return *lhs;
         if (!lhs &&  rhs) return *rhs;
+        if (*lhs == TestValidation::Crash || *rhs == TestValidation::Crash) return TestValidation::Crash;
+        if (*lhs == TestValidation::Timeout || *rhs == TestValidation::Timeout) return TestValidation::Timeout;
         if (*lhs == TestValidation::Fail || *rhs == TestValidation::Fail) return TestValidation::Fail;
 
         return *lhs;
@@ -111,6 +124,19 @@ namespace test {
             
             return p;
         }
+
+        static PartResult timeout() {
+            PartResult p;
+            p.type = TestValidation::Timeout;
+            return p;
+        }
+
+        static PartResult crash(std::string reason) {
+            PartResult p;
+            p.type = TestValidation::Crash;
+            p.computed = std::move(reason);
+            return p;
+        }
     };
 
     inline const char * get_color(std::optional<TestValidation> test_validation) {
@@ -120,13 +146,120 @@ namespace test {
             case TestValidation::Success : return KGRN;
             case TestValidation::Fail    : return KRED;
             case TestValidation::Computed: return KBLU;
+            case TestValidation::Timeout : return KMAG;
+            case TestValidation::Crash   : return KYEL;
             default:                       return KCYN;
         }
     }
 
+    /** The durations of the timed runs of a config */
+    class TimingDistribution {
+        std::vector<std::chrono::nanoseconds> m_samples;
+
+    public:
+        TimingDistribution() = default;
+        explicit TimingDistribution(std::vector<std::chrono::nanoseconds> samples);
+
+        [[nodiscard]] const std::vector<std::chrono::nanoseconds> & samples() const noexcept { return m_samples; }
+        [[nodiscard]] bool empty() const noexcept { return m_samples.empty(); }
+
+        [[nodiscard]] std::chrono::nanoseconds min() const;
+        [[nodiscard]] std::chrono::nanoseconds median() const;
+        [[nodiscard]] std::chrono::nanoseconds p90() const;
+        [[nodiscard]] std::chrono::nanoseconds percentile(double ratio) const;
+        [[nodiscard]] std::chrono::nanoseconds stddev() const;
+
+        /** Sums the i-th sample of both distributions, to get the distribution of a whole sweep */
+        TimingDistribution & operator+=(const TimingDistribution & other);
+    };
+
+    /** The phases of a solver, that it can mark with `DayExtraInfo::start_phase` */
+    enum class Phase { Parse, PartA, PartB };
+    inline constexpr size_t nb_of_phases = 3;
+
+    /**
+     * Accumulates the time spent in each phase of a solver. The solver starts
+     * in the Parse phase, and the durations are only reported if the solver
+     * marked at least one phase.
+     */
+    class PhaseTimer {
+        using Clock = std::chrono::steady_clock;
+
+        std::array<std::chrono::nanoseconds, nb_of_phases> m_durations {};
+        Phase m_current = Phase::Parse;
+        Clock::time_point m_since;
+        bool m_running = false;
+        bool m_was_marked = false;
+
+        void flush(Clock::time_point now) {
+            if (m_running) {
+                m_durations[static_cast<size_t>(m_current)] += std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_since);
+            }
+            m_since = now;
+        }
+
+    public:
+        void start_run() {
+            m_current = Phase::Parse;
+            m_since = Clock::now();
+            m_running = true;
+        }
+
+        void start_phase(Phase phase) {
+            flush(Clock::now());
+            m_current = phase;
+            m_was_marked = true;
+        }
+
+        void stop_run() {
+            flush(Clock::now());
+            m_running = false;
+        }
+
+        [[nodiscard]] bool was_marked() const noexcept { return m_was_marked; }
+        [[nodiscard]] std::chrono::nanoseconds get(Phase phase) const { return m_durations[static_cast<size_t>(phase)]; }
+    };
+
+    /** Formats a duration with a unit that fits it, like "12.3 us" */
+    std::string format_duration(std::chrono::nanoseconds duration);
+
+    class ResultCache;
+
+    /** How many times a config is run */
+    struct RunSettings {
+        /** Runs whose duration is discarded, to warm up the caches */
+        unsigned int warmup_runs = 0;
+        /** Runs whose duration is kept in the timing distribution */
+        unsigned int timed_runs = 1;
+        /** Read the hardware performance counters around the solver */
+        bool count_events = false;
+        /** Duration after which the solver is asked to stop, and its result is marked as Timeout */
+        std::optional<std::chrono::milliseconds> timeout = std::nullopt;
+        /** Cache whose outputs are reused instead of calling the solver, and where the new ones are stored. nullptr to not use any */
+        const ResultCache * cache = nullptr;
+        /** Sample the call stacks of the solver during the timed runs */
+        bool profile = false;
+        /** Count the allocations of the solver. Else operator new does not update any counter */
+        bool track_allocations = false;
+        /** Threads that the solver may use, given to it by DayExtraInfo::threads */
+        unsigned int solver_threads = 1;
+    };
+
     struct RunResult {
         std::array<std::optional<PartResult>, 2> parts;
-        std::chrono::duration<double> elapsed_time;
+        TimingDistribution timings;
+        /** Time spent in each phase, empty if the solver does not mark its phases */
+        std::array<TimingDistribution, nb_of_phases> phases;
+        /** Performance counters, averaged over the timed runs */
+        std::optional<CounterValues> counters;
+        /** Allocations done by the solver during the last timed run, with --allocations */
+        std::optional<AllocationStats> allocations;
+        /** The outputs come from the cache, so the timings are meaningless */
+        bool cached = false;
+        /** Call stacks of the solver sampled during the timed runs, with --profile */
+        FoldedStacks profile;
+        /** Text written by the solver on std::cout and std::cerr, printed after its row */
+        std::string output;
 
         [[nodiscard]] TestValidation get_overall() const noexcept;
     };
@@ -140,7 +273,10 @@ namespace test {
     struct Score {
         unsigned int success = 0;
         unsigned int failed  = 0;
-        std::chrono::duration<double> total_time;
+        unsigned int timeout = 0;
+        unsigned int crashed = 0;
+        TimingDistribution total_time;
+        std::array<TimingDistribution, nb_of_phases> total_phases;
 
         Score & operator+=(const std::optional<RunResult> & run_result) {
             if (!run_result) return *this;
@@ -151,7 +287,11 @@ namespace test {
                 }
             }
 
-            total_time += run_result->elapsed_time;
+            total_time += run_result->timings;
+
+            for (size_t i = 0; i != nb_of_phases; ++i) {
+                total_phases[i] += run_result->phases[i];
+            }
 
             return *this;
         }
@@ -161,13 +301,17 @@ namespace test {
                 ++success;
             } else if (test_validation == TestValidation::Fail) {
                 ++failed;
+            } else if (test_validation == TestValidation::Timeout) {
+                ++timeout;
+            } else if (test_validation == TestValidation::Crash) {
+                ++crashed;
             }
 
             return *this;
         }
 
 
-        [[nodiscard]] unsigned int total() const noexcept { return success + failed; }
+        [[nodiscard]] unsigned int total() const noexcept { return success + failed + timeout + crashed; }
     };
 }
 
@@ -187,34 +331,56 @@ struct DayExtraInfo {
     int  part_a_extra_param = 0;
     bool can_skip_part_B = false;
     int  part_b_extra_param = 0;
+    test::PhaseTimer * phase_timer = nullptr;
+    std::stop_token stop_token = {};
+    /**
+     * Threads that the solver may use, counting the one that calls it. It is
+     * 1 when the configs run in parallel, as they already use the cores.
+     */
+    unsigned int threads = 1;
+
+    /**
+     * Marks the start of a phase of the solver, so the harness reports the
+     * time spent parsing the input and solving each part separately.
+     */
+    void start_phase(test::Phase phase) const {
+        if (phase_timer) phase_timer->start_phase(phase);
+    }
+
+    /**
+     * True when the solver ran for longer than the --timeout of the harness.
+     * Long loops can poll it and return early, as their result is discarded.
+     */
+    [[nodiscard]] bool stop_requested() const noexcept {
+        return stop_token.stop_requested();
+    }
 };
 
 class StringSplitter {
-    std::string_view::const_iterator pos;
-    std::string_view::const_iterator end;
+    std::string_view rest;
     char split_character;
 
 public:
     explicit StringSplitter(const std::string_view & str, char split_character = ' ')
-    : pos(str.begin()), end(str.end()), split_character(split_character) {}
+    : rest(str), split_character(split_character) {}
 
-    std::string operator()() {
-        const auto from = pos;
-
-        while (pos != end && *pos != split_character) {
-            ++pos;
-        }
+    /** The next part, as a view of the string given to the constructor */
+    std::string_view next() {
+        // find is a memchr, that looks for the separator several bytes at a time
+        const size_t separator = std::min(rest.find(split_character), rest.size());
+        const std::string_view part = rest.substr(0, separator);
 
-        const auto to = pos;
+        const size_t next_part = std::min(rest.find_first_not_of(split_character, separator), rest.size());
+        rest.remove_prefix(next_part);
 
-        while (pos != end && *pos == split_character) {
-            ++pos;
-        }
+        return part;
+    }
 
-        return std::string(from, to);
+    std::string operator()() {
+        return std::string(next());
     }
 
-    [[nodiscard]] operator bool() const { return pos != end; }
+    [[nodiscard]] operator bool() const { return !rest.empty(); }
 
     template<typename T, typename Mapper>
     static std::vector<T> line_to_vector(std::string_view line, Mapper mapper, char separator = ' ') {
@@ -258,133 +424,37 @@ inline std::vector<std::string> string_split(
   return retval;
 }
 
-inline std::vector<int> extract_ints_from_line(const std::string & line) {
-  size_t i = 0;
-
-  std::vector<int> values;
-
-  while (true) {
-    int accumulator = 0;
-    
-    while (i < line.size() && !(line[i] >= '0' && line[i] <= '9')) {
-      ++i;
-    }
-
-    if (i == line.size()) return values;
-
-    while (i < line.size() && (line[i] >= '0' && line[i] <= '9')) {
-      accumulator = accumulator * 10 + (line[i] - '0');
-      ++i;
-    }
-
-    values.emplace_back(accumulator);
-  }
+/**
+ * The numbers of the line, ignoring their signs. The hot loops can write
+ * them in their own buffer with bj::scan_ints, or read the whole input at
+ * once with bj::IntsByLine (int_scanner.h).
+ */
+inline std::vector<int> extract_ints_from_line(std::string_view line) {
+  // Most lines have a few numbers: they are scanned once, and the vector
+  // is allocated with its final size
+  std::array<int, 64> buffer;
+  const size_t count = scan_ints(line, buffer);
+  if (count <= buffer.size()) return std::vector<int>(buffer.begin(), buffer.begin() + count);
+
+  std::vector<int> values(count);
+  scan_ints(line, values);
+  return values;
 }
 
 
-inline std::vector<std::int64_t> extract_signed_i64_from_line(const std::string & line) {
-  size_t i = 0;
+/** The numbers of the line, with their sign */
+inline std::vector<std::int64_t> extract_signed_i64_from_line(std::string_view line) {
+  std::array<std::int64_t, 64> buffer;
+  const size_t count = scan_ints(line, buffer, true);
+  if (count <= buffer.size()) return std::vector<std::int64_t>(buffer.begin(), buffer.begin() + count);
 
-  std::vector<std::int64_t> values;
-
-  while (true) {
-    std::int64_t accumulator = 0;
-    bool is_negative = false;
-    
-    while (i < line.size()) {
-        if (line[i] >= '0' && line[i] <= '9') break;
-        if (line[i] == '-' || line[i] == '+') break;
-        ++i;
-    }
-
-    if (i == line.size()) return values;
-
-    if (line[i] == '-') {
-        is_negative = true;
-        ++i;
-    } else if (line[i] == '+') {
-        ++i;
-    }
-
-    while (i < line.size() && (line[i] >= '0' && line[i] <= '9')) {
-      accumulator = accumulator * 10 + (line[i] - '0');
-      ++i;
-    }
-
-    if (is_negative) accumulator *= -1;
-
-    values.emplace_back(accumulator);
-  }
+  std::vector<std::int64_t> values(count);
+  scan_ints(line, values, true);
+  return values;
 }
 
 }
 
-struct Board {
-    std::vector<std::vector<char>> m_board;
-
-public:
-    explicit Board(const std::vector<std::string> & lines) {
-        for (const auto & line : lines) {
-            m_board.emplace_back(line.begin(), line.end());
-        }
-    }
-
-    [[nodiscard]] size_t height() const { return m_board.size(); }
-
-    // Board should not be empty
-    [[nodiscard]] size_t width() const { return m_board[0].size(); }
-
-    [[nodiscard]] std::optional<char> get_at(size_t x, size_t y) const {
-        if (x >= width()) return std::nullopt;
-        if (y >= height()) return std::nullopt;
-        return m_board[y][x];
-    }
-
-    void set_at(size_t x, size_t y, char c) {
-        m_board[y][x] = c;
-    }
-
-    [[nodiscard]] int normalize_x(int x) const { return x % width();  }
-    [[nodiscard]] int normalize_y(int y) const { return y % height(); }
-
-    [[nodiscard]] bool operator==(const Board & other) const {
-        return m_board == other.m_board;
-    }
-};
-
-class BoardPosition {
-    size_t m_x;       bool loop_x;
-    size_t m_y;       bool loop_y;
-    Board * board;
-
-    static void offset_helper(size_t & i, int offset, size_t length, bool is_looped) {
-        if (!is_looped) {
-            i += offset;
-            return;
-        }
-
-        int i_as_int = (static_cast<int>(i) + offset) % length;
-        i = static_cast<size_t>(i_as_int);
-    }
-
-public:
-    BoardPosition(Board & pBoard, size_t x = 0, size_t y = 0, bool pLoop_x = false, bool pLoop_y = false)
-    : m_x(x), loop_x(pLoop_x), m_y(y), loop_y(pLoop_y), board(&pBoard) {}
-
-    [[nodiscard]] std::optional<char> operator*() const {
-        return board->get_at(m_x, m_y);
-    }
-
-    void set(char c) {
-        board->set_at(m_x, m_y, c);
-    }
-
-    void offset(int x, int y) {
-        offset_helper(m_x, x, board->width() , loop_x);
-        offset_helper(m_y, y, board->height(), loop_y);
-    }
-};
-
 template <typename Ts, typename Streamer>
 std::ostream & into_stream(std::ostream & stream, const Ts & values, const char * separator, Streamer streamer) {
     bool first = true;
@@ -400,11 +470,14 @@ std::ostream & into_stream(std::ostream & stream, const Ts & values, const char
 }
 
 namespace lines_transform {
+    /** The first number of each line. Throws std::invalid_argument on a line without number */
     inline std::vector<int> to_ints(const std::vector<std::string> & lines) {
-        std::vector<int> values;
+        std::vector<int> values(lines.size());
 
-        for (const std::string & line : lines) {
-            values.emplace_back(std::stoi(line));
+        for (size_t i = 0; i != lines.size(); ++i) {
+            if (bj::scan_ints(lines[i], std::span(&values[i], 1), true) == 0) {
+                throw std::invalid_argument("Bad input: " + lines[i]);
+            }
         }
 
         return values;
@@ -485,5 +558,73 @@ public:
 struct InputConfig;
 using InputsConfig = std::vector<InputConfig>;
 using DayEntryPoint = Output(const std::vector<std::string> & lines, const DayExtraInfo &);
+/** Entry point that receives views over the input file instead of a copy of each line */
+using DayViewEntryPoint = Output(std::span<const std::string_view> lines, const DayExtraInfo &);
+
+/** The entry point of a day, with either signature */
+struct DayEntry {
+    DayEntryPoint     * strings = nullptr;
+    DayViewEntryPoint * views   = nullptr;
+
+    constexpr DayEntry() = default;
+    constexpr DayEntry(std::nullptr_t) {}
+    constexpr DayEntry(DayEntryPoint * entry_point) : strings(entry_point) {}
+    constexpr DayEntry(DayViewEntryPoint * entry_point) : views(entry_point) {}
+
+    [[nodiscard]] explicit operator bool() const noexcept { return strings || views; }
+};
+
+/**
+ * Configs are run in parallel by default. Days that rely on mutable global
+ * state must register themselves with a static initializer, so their configs
+ * are run one after the other:
+ * `static const bool sequential = register_sequential_day(&day_2023_20);`
+ */
+bool register_sequential_day(DayEntry entry_point);
+[[nodiscard]] bool is_sequential_day(DayEntry entry_point);
+
+namespace test {
+    /**
+     * Builds an input about `factor` times larger than the given one, with
+     * the same shape. Random values must only be drawn from the seed, so the
+     * generated inputs are the same from one run to another.
+     */
+    using ScaleGenerator = std::vector<std::string>(std::span<const std::string_view> input, unsigned int factor, std::uint64_t seed);
+}
+
+/**
+ * Days that can generate larger inputs are benchmarked by `--scale`. The
+ * generator is registered like the sequential days:
+ * `static const bool scalable = register_scale_generator(&day_2024_06, &scale_up);`
+ */
+bool register_scale_generator(DayEntry entry_point, test::ScaleGenerator * generator);
+[[nodiscard]] test::ScaleGenerator * scale_generator_of(DayEntry entry_point);
+
+inline std::array<DayEntry, 25> to_day_entries(const std::array<DayEntry, 25> & entries) {
+    return entries;
+}
+
+inline std::array<DayEntry, 25> to_day_entries(const std::array<DayEntryPoint *, 25> & entries) {
+    std::array<DayEntry, 25> converted;
+    std::copy(entries.begin(), entries.end(), converted.begin());
+    return converted;
+}
+
+void run_aoc(const std::array<DayEntry, 25> & entries, int argc, const char * argv[]);
+
+inline void run_aoc(const std::array<DayEntryPoint *, 25> & entries, int argc, const char * argv[]) {
+    run_aoc(to_day_entries(entries), argc, argv);
+}
+
+/**
+ * The days of a year, in the multi year driver. When compiled with
+ * AOC_MULTI_YEAR, the file of each year that holds the list of the days
+ * defines `aoc_days_YEAR()` instead of `main`.
+ */
+struct AocYear {
+    int year;
+    std::array<DayEntry, 25> (* days)();
+};
 
-void run_aoc(const std::array<DayEntryPoint *, 25> & entries, int argc, const char * argv[]);
+/** Runs `aoc YEAR [day] [options]` or `aoc all [day] [options]` */
+void run_aoc(std::span<const AocYear> years, int argc, const char * argv[]);
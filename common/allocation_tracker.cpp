@@ -0,0 +1,137 @@
+#include "allocation_tracker.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if __has_include(<malloc.h>)
+#include <malloc.h>
+#define AOC_USABLE_SIZE(ptr) ::malloc_usable_size(ptr)
+#else
+#define AOC_USABLE_SIZE(ptr) std::size_t(0)
+#endif
+
+// Counters of the current thread. They are trivially constructible, so
+// accessing them never allocates. They are only updated while an
+// AllocationScope is active on the thread.
+namespace {
+    thread_local bool          tl_tracking = false;
+    thread_local std::uint64_t tl_allocations = 0;
+    thread_local std::uint64_t tl_bytes_allocated = 0;
+    thread_local std::int64_t  tl_live_bytes = 0;
+    thread_local std::int64_t  tl_peak_live_bytes = 0;
+
+    void on_allocation(void * ptr, std::size_t size) {
+        if (!tl_tracking) return;
+        ++tl_allocations;
+        tl_bytes_allocated += size;
+        tl_live_bytes += static_cast<std::int64_t>(AOC_USABLE_SIZE(ptr));
+        tl_peak_live_bytes = std::max(tl_peak_live_bytes, tl_live_bytes);
+    }
+
+    void on_deallocation(void * ptr) {
+        if (!tl_tracking) return;
+        tl_live_bytes -= static_cast<std::int64_t>(AOC_USABLE_SIZE(ptr));
+    }
+
+    void * allocate(std::size_t size) {
+        if (size == 0) size = 1;
+
+        while (true) {
+            if (void * ptr = std::malloc(size)) {
+                on_allocation(ptr, size);
+                return ptr;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void * allocate_aligned(std::size_t size, std::align_val_t alignment) {
+        const std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void *));
+        if (size == 0) size = 1;
+
+        while (true) {
+            void * ptr = nullptr;
+            if (::posix_memalign(&ptr, align, size) == 0) {
+                on_allocation(ptr, size);
+                return ptr;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void deallocate(void * ptr) noexcept {
+        if (!ptr) return;
+        on_deallocation(ptr);
+        std::free(ptr);
+    }
+}
+
+// libstdc++ implements the array and nothrow versions with these ones
+void * operator new(std::size_t size) { return allocate(size); }
+void * operator new(std::size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+void operator delete(void * ptr) noexcept { deallocate(ptr); }
+void operator delete(void * ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void * ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void * ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+
+test::AllocationStats & test::AllocationStats::operator+=(const AllocationStats & other) {
+    allocations += other.allocations;
+    bytes_allocated += other.bytes_allocated;
+    peak_live_bytes = std::max(peak_live_bytes, other.peak_live_bytes);
+    return *this;
+}
+
+std::string test::AllocationStats::summary() const {
+    const auto to_human = [](double bytes) {
+        char buffer[32];
+        if (bytes < 1024.) {
+            std::sprintf(buffer, "%.0f B", bytes);
+        } else if (bytes < 1024. * 1024.) {
+            std::sprintf(buffer, "%.1f KiB", bytes / 1024.);
+        } else if (bytes < 1024. * 1024. * 1024.) {
+            std::sprintf(buffer, "%.1f MiB", bytes / 1024. / 1024.);
+        } else {
+            std::sprintf(buffer, "%.2f GiB", bytes / 1024. / 1024. / 1024.);
+        }
+        return std::string(buffer);
+    };
+
+    char buffer[128];
+    std::sprintf(buffer, "allocs %9llu  %10s  peak %10s ",
+        static_cast<unsigned long long>(allocations),
+        to_human(static_cast<double>(bytes_allocated)).c_str(),
+        to_human(static_cast<double>(peak_live_bytes)).c_str()
+    );
+    return buffer;
+}
+
+test::AllocationScope::AllocationScope()
+: m_allocations(tl_allocations), m_bytes_allocated(tl_bytes_allocated), m_live_bytes(tl_live_bytes),
+  m_was_tracking(tl_tracking) {
+    tl_peak_live_bytes = tl_live_bytes;
+    tl_tracking = true;
+}
+
+test::AllocationScope::~AllocationScope() {
+    if (!m_stopped) tl_tracking = m_was_tracking;
+}
+
+test::AllocationStats test::AllocationScope::stop() {
+    if (!m_stopped) {
+        tl_tracking = m_was_tracking;
+        m_stopped = true;
+    }
+
+    AllocationStats stats;
+    stats.allocations = tl_allocations - m_allocations;
+    stats.bytes_allocated = tl_bytes_allocated - m_bytes_allocated;
+    stats.peak_live_bytes = static_cast<std::uint64_t>(std::max<std::int64_t>(0, tl_peak_live_bytes - m_live_bytes));
+    return stats;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace test {
+    /** The allocations done by a thread */
+    struct AllocationStats {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes_allocated = 0;
+        /** Maximum, over time, of the bytes allocated and not freed yet */
+        std::uint64_t peak_live_bytes = 0;
+
+        AllocationStats & operator+=(const AllocationStats & other);
+
+        [[nodiscard]] std::string summary() const;
+    };
+
+    /**
+     * Measures the allocations of the calling thread between its construction
+     * and the call to `stop`.
+     *
+     * The global operator new and operator delete are replaced to count the
+     * allocations of each thread. Memory allocated by another thread, like
+     * threads started by a solver, is not attributed to the scope.
+     *
+     * The allocations are only counted while a scope is active on the
+     * thread, so the other allocations only pay for the test of a flag.
+     */
+    class AllocationScope {
+        std::uint64_t m_allocations;
+        std::uint64_t m_bytes_allocated;
+        std::int64_t  m_live_bytes;
+        bool m_was_tracking;
+        bool m_stopped = false;
+
+    public:
+        AllocationScope();
+        ~AllocationScope();
+
+        AllocationScope(const AllocationScope &) = delete;
+        AllocationScope & operator=(const AllocationScope &) = delete;
+
+        /** Stops counting the allocations, and returns the ones done since the construction */
+        [[nodiscard]] AllocationStats stop();
+    };
+}
@@ -0,0 +1,134 @@
+#include "bench_environment.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <malloc.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#define AOC_HAS_PINNING 1
+#else
+#define AOC_HAS_PINNING 0
+#endif
+
+namespace {
+    std::optional<std::string> read_first_line(const std::string & path) {
+        std::ifstream file(path);
+        std::string line;
+        if (!std::getline(file, line)) return std::nullopt;
+        return line;
+    }
+
+    std::string cpu_directory(int cpu) {
+        return "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    }
+
+    test::MachineState & mutable_machine_state() {
+        static test::MachineState state = []() {
+            test::MachineState read;
+
+            int cpu = 0;
+#if AOC_HAS_PINNING
+            cpu = std::max(0, ::sched_getcpu());
+            errno = 0;
+            const int nice = ::getpriority(PRIO_PROCESS, 0);
+            if (errno == 0) read.nice = nice;
+#endif
+
+            read.governor = read_first_line(cpu_directory(cpu) + "/cpufreq/scaling_governor");
+
+            if (const auto smt = read_first_line("/sys/devices/system/cpu/smt/active")) {
+                read.smt = *smt == "1";
+            }
+
+            return read;
+        }();
+
+        return state;
+    }
+}
+
+std::string test::MachineState::summary() const {
+    std::string summary = "cpu=" + (pinned_cpu ? std::to_string(*pinned_cpu) : std::string("any"));
+    summary += " governor=" + governor.value_or("unknown");
+    summary += " smt=" + std::string(!smt ? "unknown" : *smt ? "on" : "off");
+    summary += " nice=" + std::to_string(nice);
+    summary += " mlock=" + std::string(memory_locked ? "yes" : "no");
+    return summary;
+}
+
+const test::MachineState & test::machine_state() {
+    return mutable_machine_state();
+}
+
+#if AOC_HAS_PINNING
+
+void test::pin_for_benchmark(int cpu, std::ostream & warnings) {
+    MachineState & state = mutable_machine_state();
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        warnings << "Unable to pin the process on the CPU " << cpu << ": no such CPU\n";
+    } else {
+        CPU_SET(cpu, &cpus);
+
+        if (::sched_setaffinity(0, sizeof(cpus), &cpus) == 0) {
+            state.pinned_cpu = cpu;
+            state.governor = read_first_line(cpu_directory(cpu) + "/cpufreq/scaling_governor");
+        } else {
+            warnings << "Unable to pin the process on the CPU " << cpu << ": " << std::strerror(errno) << "\n";
+        }
+    }
+
+    // Without CAP_SYS_NICE, only a nice value above the current one is allowed
+    if (::setpriority(PRIO_PROCESS, 0, -20) != 0) {
+        warnings << "Unable to raise the priority (" << std::strerror(errno) << "), run as root for nice -20\n";
+    }
+    errno = 0;
+    const int nice = ::getpriority(PRIO_PROCESS, 0);
+    if (errno == 0) state.nice = nice;
+
+    // Freed memory stays in the heap instead of being given back to the
+    // kernel, so the next runs do not page fault on it again
+    ::mallopt(M_TRIM_THRESHOLD, std::numeric_limits<int>::max());
+    ::mallopt(M_MMAP_MAX, 0);
+
+    // MCL_FUTURE makes every mapping fail once the limit is reached, so the
+    // memory is only locked when there is no limit
+    rlimit limit;
+    const bool unlimited = ::getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur == RLIM_INFINITY;
+    if (!unlimited && ::geteuid() != 0) {
+        warnings << "The memory is not locked, the RLIMIT_MEMLOCK of the process is limited (ulimit -l)\n";
+    } else if (::mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+        state.memory_locked = true;
+    } else {
+        warnings << "Unable to lock the memory: " << std::strerror(errno) << "\n";
+    }
+
+    if (state.governor && *state.governor != "performance") {
+        warnings << "The frequency governor of the CPU is " << *state.governor
+                 << ", the frequency of the CPU may change during the runs (performance is more stable)\n";
+    }
+
+    if (state.pinned_cpu && state.smt.value_or(false)) {
+        const auto siblings = read_first_line(cpu_directory(cpu) + "/topology/thread_siblings_list");
+        if (siblings && *siblings != std::to_string(cpu)) {
+            warnings << "SMT is active, the CPUs " << *siblings
+                     << " share a core and other processes that run on them slow down the benchmark\n";
+        }
+    }
+}
+
+#else
+
+void test::pin_for_benchmark(int cpu, std::ostream & warnings) {
+    warnings << "Pinning the process on the CPU " << cpu << " is only supported on Linux\n";
+}
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <optional>
+#include <ostream>
+#include <string>
+
+namespace test {
+    /** The settings of the machine that change the timings */
+    struct MachineState {
+        /** The only CPU the harness runs on, nullopt if it is not pinned */
+        std::optional<int> pinned_cpu;
+        /** cpufreq governor of the CPU, like "performance" or "powersave" */
+        std::optional<std::string> governor;
+        /** Simultaneous multithreading (hyper-threading) is active */
+        std::optional<bool> smt;
+        /** Nice value of the process */
+        int nice = 0;
+        /** The memory of the process is locked in RAM */
+        bool memory_locked = false;
+
+        /** Like "cpu=3 governor=performance smt=off nice=-20 mlock=yes" */
+        [[nodiscard]] std::string summary() const;
+    };
+
+    /** The state of the machine, read on the first call and updated by `pin_for_benchmark` */
+    const MachineState & machine_state();
+
+    /**
+     * Reduces the noise of the timings: pins the process on `cpu`, raises its
+     * priority, and locks its memory so it is faulted in once and never
+     * swapped. The steps that are not allowed are skipped and reported in
+     * `warnings`, with the settings of the machine that add noise.
+     *
+     * Must be called before starting the threads, which inherit the affinity.
+     */
+    void pin_for_benchmark(int cpu, std::ostream & warnings);
+}
@@ -1,6 +1,13 @@
 #include "configuration.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
+#include <stop_token>
+#include <thread>
 #include "advent_of_code.hpp"
+#include "input_file.h"
+#include "result_cache.h"
 
 std::string InputConfig::to_string() const {
     std::ostringstream stringbuilder;
@@ -46,23 +53,61 @@ InputConfig InputConfig::from_line(std::string_view line, const std::string & pr
     }
 }
 
+namespace {
+    /**
+     * Requests the solver to stop when it runs for longer than the timeout.
+     * Without timeout, the token has no stop state and costs nothing to poll.
+     */
+    class Watchdog {
+        std::stop_source m_source;
+        std::jthread m_thread;
+
+    public:
+        explicit Watchdog(std::optional<std::chrono::milliseconds> timeout)
+        : m_source(timeout ? std::stop_source() : std::stop_source(std::nostopstate)) {
+            if (!timeout) return;
+
+            m_thread = std::jthread([source = m_source, timeout = *timeout](std::stop_token finished) mutable {
+                std::mutex mutex;
+                std::condition_variable_any condition;
+                std::unique_lock lock(mutex);
+                condition.wait_for(lock, finished, timeout, []() { return false; });
+
+                if (!finished.stop_requested()) source.request_stop();
+            });
+        }
+
+        [[nodiscard]] std::stop_token token() const { return m_source.get_token(); }
+
+        /** Stops watching. Returns true if the timeout was reached. */
+        bool stop() {
+            if (m_thread.joinable()) {
+                m_thread.request_stop();
+                m_thread.join();
+            }
+
+            return m_source.stop_requested();
+        }
+    };
+}
+
 static bool config_has_no_test(const InputConfig & config) {
     return config.m_expected_part_1.is_ignore()
         && config.m_expected_part_2.is_ignore();
 }
 
-InputsConfig InputConfig::read_configuration() {
-    const std::string prefix = "inputs/";
+InputsConfig InputConfig::read_configuration(const std::string & directory, int year) {
+    const std::string prefix = directory + "inputs/";
     const std::string path = prefix + "config.txt";
 
     InputsConfig configs;
 
-    std::ifstream file(path);
+    const InputFile file(path);
 
-    std::string line;
-    while (getline_cleaned(file, line)) {
+    for (const std::string_view line : file.lines()) {
         if (line.substr(0, 2) != "//") {
             configs.emplace_back(from_line(line, prefix));
+            configs.back().year = year;
         }
     }
 
@@ -70,3 +115,264 @@ InputsConfig InputConfig::read_configuration() {
 
     return configs;
 }
+
+InputConfig InputConfig::without_expected_values() const {
+    InputConfig copy = *this;
+
+    for (test::Expected * expected : { &copy.m_expected_part_1, &copy.m_expected_part_2 }) {
+        if (expected->type == test::Expected::Type::Known || expected->type == test::Expected::Type::WantedKnown) {
+            expected->type = test::Expected::Type::Wanted;
+            expected->value = "";
+        }
+    }
+
+    return copy;
+}
+
+std::optional<test::RunResult> InputConfig::run(DayEntry entry, const test::RunSettings & settings) const {
+    const InputFile file(filename);
+
+    if (!file.is_open()) {
+        std::cout << "No file " << filename << "\n";
+        return std::nullopt;
+    }
+
+    return run(entry, file.lines(), settings);
+}
+
+std::optional<test::RunResult> InputConfig::run(DayEntry entry, std::span<const std::string_view> lines, const test::RunSettings & settings) const {
+    // Days with the historical signature receive a copy of the lines
+    std::vector<std::string> lines_as_strings;
+    if (entry.strings) {
+        lines_as_strings.assign(lines.begin(), lines.end());
+    }
+
+    DayExtraInfo day_extra_info {
+        .filename           = filename,
+        .can_skip_part_A    = m_expected_part_1.type == test::Expected::Type::Ignore,
+        .part_a_extra_param = m_expected_part_1.extra_parameter,
+        .can_skip_part_B    = m_expected_part_2.type == test::Expected::Type::Ignore,
+        .part_b_extra_param = m_expected_part_2.extra_parameter
+    };
+
+    test::PhaseTimer phase_timer;
+    day_extra_info.phase_timer = &phase_timer;
+    day_extra_info.threads = settings.solver_threads;
+
+    std::optional<test::PerfCounters> perf_counters = settings.count_events ? test::PerfCounters::open() : std::nullopt;
+    std::optional<test::CounterValues> counters;
+    test::AllocationStats allocations;
+    bool is_timed_run = false;
+
+    std::optional<test::SamplingProfiler> profiler;
+    if (settings.profile) {
+        profiler.emplace(entry.strings ? reinterpret_cast<std::uintptr_t>(entry.strings) : reinterpret_cast<std::uintptr_t>(entry.views));
+    }
+
+    const std::optional<std::uint64_t> solver_hash = settings.cache ? settings.cache->solver_hash(year, day) : std::nullopt;
+    bool all_from_cache = true;
+
+    /** The output of a call, and the key under which it is stored once validated if it was computed */
+    struct RunnerCall {
+        Output output;
+        std::optional<test::ResultCache::Key> cache_key;
+    };
+
+    const auto call_runner = [&](std::span<const std::string_view> input, const std::vector<std::string> & input_as_strings) -> RunnerCall {
+        std::optional<test::ResultCache::Key> cache_key;
+        if (solver_hash) {
+            cache_key = test::ResultCache::Key {
+                .year = year, .day = day,
+                .input_hash = test::ResultCache::input_hash(input, day_extra_info),
+                .solver_hash = *solver_hash
+            };
+
+            if (std::optional<Output> cached = settings.cache->get(*cache_key)) {
+                return RunnerCall{ std::move(*cached), std::nullopt };
+            }
+        }
+
+        all_from_cache = false;
+
+        const bool count = perf_counters && is_timed_run;
+        if (count) perf_counters->start();
+
+        const bool sample = profiler && is_timed_run;
+        if (sample) profiler->start();
+
+        std::optional<test::AllocationScope> allocation_scope;
+        if (settings.track_allocations) allocation_scope.emplace();
+        phase_timer.start_run();
+        Output result = entry.strings ? entry.strings(input_as_strings, day_extra_info) : entry.views(input, day_extra_info);
+        phase_timer.stop_run();
+        if (allocation_scope) allocations += allocation_scope->stop();
+
+        if (sample) profiler->stop();
+
+        if (count) {
+            const test::CounterValues values = perf_counters->stop();
+            if (counters) {
+                *counters += values;
+            } else {
+                counters = values;
+            }
+        }
+
+        return RunnerCall{ std::move(result), cache_key };
+    };
+
+    // A wrong output would be reused as if it was right, so only the outputs
+    // whose parts are all Success or Computed are stored
+    const auto store = [&](const RunnerCall & call, bool is_valid) {
+        if (!call.cache_key || !is_valid || day_extra_info.stop_requested()) return;
+        settings.cache->put(*call.cache_key, call.output);
+    };
+
+    using Parts = std::array<std::optional<test::PartResult>, 2>;
+
+    const auto run_once = [&]() -> Parts {
+        if (!m_is_inline) {
+            const RunnerCall call = call_runner(lines, lines_as_strings);
+
+            const Parts parts {
+                test::PartResult::from(call.output.part_a, m_expected_part_1),
+                test::PartResult::from(call.output.part_b, m_expected_part_2)
+            };
+
+            store(call, std::ranges::all_of(parts, [](const std::optional<test::PartResult> & part) {
+                return !part || part->type == test::TestValidation::Success || part->type == test::TestValidation::Computed;
+            }));
+
+            return parts;
+        }
+
+        std::vector<std::string> part_a_messages;
+        std::vector<std::string> part_b_messages;
+        unsigned int valid_a = 0;
+        unsigned int valid_b = 0;
+        unsigned int total_a = 0;
+        unsigned int total_b = 0;
+
+        for (size_t i_line = 0; i_line + 1 < lines.size() ; i_line += 2) {
+            const std::span<const std::string_view> input = lines.subspan(i_line, 1);
+            std::vector<std::string> input_as_strings;
+            if (entry.strings) {
+                input_as_strings.emplace_back(lines[i_line]);
+            }
+            StringSplitter splitter { lines[i_line + 1] };
+            const std::string expect_a = splitter ? splitter() : "";
+            const std::string expect_b = splitter ? splitter() : "";
+
+            day_extra_info.can_skip_part_A = !(expect_a != "" && expect_a != "_");
+            day_extra_info.can_skip_part_B = !(expect_b != "" && expect_b != "_");
+
+            const RunnerCall call = call_runner(input, input_as_strings);
+            const Output & result = call.output;
+
+            if (expect_a != "" && expect_a != "_") {
+                if (expect_a == result.part_a) {
+                    ++valid_a;
+                } else {
+                    const std::string s =
+                        ":: Part A :: Expected <" + expect_a +
+                        "> ; Returned <" + result.part_a + ">" +
+                        "\n" + std::string(lines[i_line]);
+                    part_a_messages.emplace_back(s);
+                }
+                ++total_a;
+            }
+
+            if (expect_b != "" && expect_b != "_") {
+                if (expect_b == result.part_b) {
+                    ++valid_b;
+                } else {
+                    const std::string s =
+                        ":: Part A :: Expected <" + expect_b +
+                        "> ; Returned <" + result.part_b + ">" +
+                        "\n" + std::string(lines[i_line]);
+                    part_b_messages.emplace_back(s);
+                }
+                ++total_b;
+            }
+
+            store(call, (expect_a == "" || expect_a == "_" || expect_a == result.part_a)
+                     && (expect_b == "" || expect_b == "_" || expect_b == result.part_b));
+        }
+
+        return Parts({
+            test::PartResult::from(valid_a, total_a, part_a_messages),
+            test::PartResult::from(valid_b, total_b, part_b_messages)
+        });
+    };
+
+    // Runs the config under the watchdog and measures its duration
+    bool timed_out = false;
+    const auto run_watched = [&]() -> std::pair<Parts, std::chrono::nanoseconds> {
+        Watchdog watchdog(settings.timeout);
+        day_extra_info.stop_token = watchdog.token();
+
+        const auto start = std::chrono::steady_clock::now();
+        Parts parts = run_once();
+        const auto end = std::chrono::steady_clock::now();
+
+        timed_out = watchdog.stop();
+        return { std::move(parts), std::chrono::duration_cast<std::chrono::nanoseconds>(end - start) };
+    };
+
+    std::vector<std::chrono::nanoseconds> samples;
+    std::array<std::vector<std::chrono::nanoseconds>, test::nb_of_phases> phase_samples;
+    Parts parts;
+
+    for (unsigned int i = 0; i != settings.warmup_runs && !timed_out; ++i) {
+        const auto [_, duration] = run_watched();
+        if (timed_out) samples.emplace_back(duration);
+    }
+
+    is_timed_run = true;
+
+    for (unsigned int i = 0; !timed_out && (i == 0 || i < settings.timed_runs); ++i) {
+        phase_timer = test::PhaseTimer();
+        allocations = test::AllocationStats();
+
+        auto [run_parts, duration] = run_watched();
+        parts = std::move(run_parts);
+        samples.emplace_back(duration);
+
+        if (phase_timer.was_marked()) {
+            for (size_t phase = 0; phase != test::nb_of_phases; ++phase) {
+                phase_samples[phase].emplace_back(phase_timer.get(static_cast<test::Phase>(phase)));
+            }
+        }
+    }
+
+    // The result of an interrupted solver is meaningless
+    if (timed_out) {
+        if (!parts[0] && !parts[1]) parts[0] = test::PartResult::timeout();
+
+        for (std::optional<test::PartResult> & part : parts) {
+            if (part) part = test::PartResult::timeout();
+        }
+    }
+
+    test::RunResult result {
+        .parts = parts,
+        .timings = test::TimingDistribution(std::move(samples)),
+        .phases = {},
+        .counters = std::nullopt,
+        .allocations = settings.track_allocations ? std::optional(allocations) : std::nullopt,
+        .cached = all_from_cache,
+        .profile = profiler ? profiler->folded_stacks() : test::FoldedStacks{},
+        .output = {}
+    };
+
+    if (counters) {
+        *counters /= result.timings.samples().size();
+        result.counters = counters;
+    }
+
+    for (size_t phase = 0; phase != test::nb_of_phases; ++phase) {
+        result.phases[phase] = test::TimingDistribution(std::move(phase_samples[phase]));
+    }
+
+    return result;
+}
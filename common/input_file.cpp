@@ -0,0 +1,113 @@
+#include "input_file.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define AOC_HAS_MMAP 1
+#else
+#define AOC_HAS_MMAP 0
+#endif
+
+InputFile::InputFile(const std::string & path) {
+#if AOC_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat status {};
+    const bool has_status = ::fstat(fd, &status) == 0;
+    if (has_status && status.st_size > 0) {
+        void * mapping = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            m_mapping = mapping;
+            m_mapping_size = static_cast<size_t>(status.st_size);
+            m_content = std::string_view(static_cast<const char *>(mapping), m_mapping_size);
+            ::madvise(mapping, m_mapping_size, MADV_SEQUENTIAL);
+        }
+    }
+
+    ::close(fd);
+
+    // Empty files can not be mapped, and special files may refuse to be
+    if (!m_mapping && (!has_status || status.st_size != 0)) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return;
+        m_owned.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        m_content = m_owned;
+    }
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return;
+    m_owned.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    m_content = m_owned;
+#endif
+
+    m_is_open = true;
+    strip_carriage_returns();
+    split_lines();
+}
+
+InputFile::~InputFile() {
+#if AOC_HAS_MMAP
+    if (m_mapping) {
+        ::munmap(m_mapping, m_mapping_size);
+    }
+#endif
+}
+
+void InputFile::strip_carriage_returns() {
+    const char * first_cr = static_cast<const char *>(std::memchr(m_content.data(), '\r', m_content.size()));
+    if (!first_cr) return;
+
+    // memchr and memcpy process whole vectors at a time, so the content is
+    // copied by chunks between two carriage returns
+    std::string stripped;
+    stripped.resize(m_content.size());
+
+    const char * read = m_content.data();
+    const char * const end = m_content.data() + m_content.size();
+    char * write = stripped.data();
+
+    const char * cr = first_cr;
+    while (cr) {
+        const size_t chunk = static_cast<size_t>(cr - read);
+        std::memcpy(write, read, chunk);
+        write += chunk;
+        read = cr + 1;
+        cr = static_cast<const char *>(std::memchr(read, '\r', static_cast<size_t>(end - read)));
+    }
+
+    const size_t tail = static_cast<size_t>(end - read);
+    std::memcpy(write, read, tail);
+    write += tail;
+
+    stripped.resize(static_cast<size_t>(write - stripped.data()));
+    m_owned = std::move(stripped);
+    m_content = m_owned;
+}
+
+void InputFile::split_lines() {
+    // Same lines as std::getline: a final line feed does not start a new line
+    const char * read = m_content.data();
+    const char * const end = m_content.data() + m_content.size();
+
+    while (read != end) {
+        const char * line_feed = static_cast<const char *>(std::memchr(read, '\n', static_cast<size_t>(end - read)));
+
+        if (!line_feed) {
+            m_lines.emplace_back(read, static_cast<size_t>(end - read));
+            break;
+        }
+
+        m_lines.emplace_back(read, static_cast<size_t>(line_feed - read));
+        read = line_feed + 1;
+    }
+}
+
+std::vector<std::string> InputFile::to_strings() const {
+    return std::vector<std::string>(m_lines.begin(), m_lines.end());
+}
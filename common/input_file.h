@@ -0,0 +1,40 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * The content of an input file, loaded in a single buffer and split into
+ * lines without copying them.
+ *
+ * The file is memory mapped when the platform allows it. If the file
+ * contains carriage returns, they are all removed in one pass over the
+ * content, which is then copied once into an owned buffer.
+ */
+class InputFile {
+    bool m_is_open = false;
+    void * m_mapping = nullptr;
+    size_t m_mapping_size = 0;
+    std::string m_owned;
+    std::string_view m_content;
+    std::vector<std::string_view> m_lines;
+
+    void strip_carriage_returns();
+    void split_lines();
+
+public:
+    /** Loads the file. Use `is_open` to know if it could be read. */
+    explicit InputFile(const std::string & path);
+    InputFile(const InputFile &) = delete;
+    InputFile & operator=(const InputFile &) = delete;
+    ~InputFile();
+
+    [[nodiscard]] bool is_open() const noexcept { return m_is_open; }
+    [[nodiscard]] std::string_view content() const noexcept { return m_content; }
+    [[nodiscard]] std::span<const std::string_view> lines() const noexcept { return m_lines; }
+
+    /** Copies the lines in the format used by the `std::vector<std::string>` entry points */
+    [[nodiscard]] std::vector<std::string> to_strings() const;
+};
@@ -0,0 +1,275 @@
+#include "int_scanner.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BJ_INT_SCANNER_X86 1
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace bj {
+    namespace {
+        // Blocks of 16 and 32 bytes. The comparisons of the vector extensions
+        // are applied byte by byte, so the classification of the bytes is
+        // written once, and compiled with the instructions of the function
+        // in which it is inlined.
+        typedef char Bytes16 __attribute__((vector_size(16)));
+        typedef char Bytes32 __attribute__((vector_size(32)));
+
+        /** Bit i is set if bytes[i] is 0xFF, for a vector of 0x00 and 0xFF */
+        [[gnu::always_inline]] inline std::uint64_t to_bits(const Bytes16 & bytes) {
+#ifdef __SSE2__
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(reinterpret_cast<__m128i>(bytes)));
+#else
+            std::uint64_t bits = 0;
+            for (std::size_t i = 0; i != 16; ++i) {
+                bits |= std::uint64_t(bytes[i] != 0) << i;
+            }
+            return bits;
+#endif
+        }
+
+        [[gnu::always_inline]] inline std::uint64_t to_bits(const Bytes32 & bytes) {
+            Bytes16 low;
+            Bytes16 high;
+            std::memcpy(&low, &bytes, 16);
+            std::memcpy(&high, reinterpret_cast<const char *>(&bytes) + 16, 16);
+            return to_bits(low) | (to_bits(high) << 16);
+        }
+
+        /** The positions of the digits and of the '\n' in a block */
+        struct Masks {
+            std::uint64_t digits;
+            std::uint64_t newlines;
+        };
+
+        template<typename Bytes>
+        [[gnu::always_inline]] inline Masks classify(const char * block) {
+            Bytes bytes;
+            std::memcpy(&bytes, block, sizeof(Bytes));
+
+            // Signed comparisons: the bytes above 0x7F are not digits either
+            const Bytes digits = (bytes >= '0') & (bytes <= '9');
+            const Bytes newlines = bytes == '\n';
+            return Masks{ to_bits(digits), to_bits(newlines) };
+        }
+
+        /** The value of the `length` (1 to 8) digits at `digits`, that can be read 8 bytes at a time */
+        [[gnu::always_inline]] inline std::uint64_t parse_up_to_eight(const char * digits, std::size_t length) {
+            std::uint64_t chunk;
+            std::memcpy(&chunk, digits, 8);
+
+            // The bytes after the digits may borrow, but only from the
+            // bytes after them, that are shifted out. The first digit is the
+            // lowest byte, so the missing digits become leading zeros.
+            chunk -= 0x3030303030303030;
+            chunk <<= (8 - length) * 8;
+
+            chunk = (chunk * 10) + (chunk >> 8);
+            chunk = (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32)))
+                  + (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+            return chunk;
+        }
+
+        constexpr std::uint64_t powers_of_ten[9] = {
+            1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+        };
+
+        /** The number being read, whose digits may be in several blocks */
+        struct Number {
+            std::uint64_t value = 0;
+            bool negative = false;
+            bool active = false;
+
+            [[gnu::always_inline]] void start(bool is_negative) {
+                value = 0;
+                negative = is_negative;
+                active = true;
+            }
+
+            [[gnu::always_inline]] void append(const char * digits, std::size_t length) {
+                while (length > 8) {
+                    value = value * powers_of_ten[8] + parse_up_to_eight(digits, 8);
+                    digits += 8;
+                    length -= 8;
+                }
+
+                value = value * powers_of_ten[length] + parse_up_to_eight(digits, length);
+            }
+
+            [[gnu::always_inline]] std::int64_t finish() {
+                active = false;
+                const std::int64_t signed_value = static_cast<std::int64_t>(value);
+                return negative ? -signed_value : signed_value;
+            }
+        };
+
+        /** Writes the numbers in a buffer of the caller, and counts them */
+        template<typename T>
+        struct SpanSink {
+            static constexpr bool reads_lines = false;
+
+            T * out;
+            std::size_t capacity;
+            std::size_t count = 0;
+
+            void value(std::int64_t value) {
+                if (count < capacity) out[count] = static_cast<T>(value);
+                ++count;
+            }
+
+            void newline() {}
+        };
+
+        struct LinesSink {
+            static constexpr bool reads_lines = true;
+
+            std::vector<std::int64_t> & values;
+            std::vector<std::uint32_t> & line_starts;
+
+            void value(std::int64_t value) { values.push_back(value); }
+            void newline() { line_starts.push_back(static_cast<std::uint32_t>(values.size())); }
+        };
+
+        template<typename Bytes, typename Sink>
+        [[gnu::always_inline]] inline void scan_blocks(std::string_view text, bool read_signs, Sink & sink) {
+            constexpr std::size_t width = sizeof(Bytes);
+
+            const char * const end = text.data() + text.size();
+            Number number;
+            char before_block = '\0';
+
+            // The last blocks are copied with a padding of zeros, so the 8
+            // bytes read by parse_up_to_eight are always in the buffer
+            alignas(32) char padded[width + 8];
+
+            for (const char * block = text.data(); block < end; block += width) {
+                const char * bytes = block;
+                if (static_cast<std::size_t>(end - block) < width + 8) {
+                    std::memset(padded, 0, sizeof(padded));
+                    std::memcpy(padded, block, std::min<std::size_t>(width, end - block));
+                    bytes = padded;
+                }
+
+                const Masks masks = classify<Bytes>(bytes);
+                const std::uint64_t digits = masks.digits;
+                const std::uint64_t newlines = Sink::reads_lines ? masks.newlines : 0;
+
+                // The end of the number of the previous block
+                const std::uint64_t continued = number.active ? 1 : 0;
+                if (number.active) {
+                    const std::size_t length = std::countr_zero(~digits);
+                    if (length != 0) number.append(bytes, length);
+                    if (length != width) sink.value(number.finish());
+                }
+
+                const std::uint64_t starts = digits & ~((digits << 1) | continued);
+
+                for (std::uint64_t events = starts | newlines; events != 0; events &= events - 1) {
+                    const std::size_t position = std::countr_zero(events);
+
+                    if ((newlines >> position) & 1) {
+                        sink.newline();
+                        continue;
+                    }
+
+                    const char sign = position == 0 ? before_block : bytes[position - 1];
+                    const std::size_t length = std::countr_zero(~(digits >> position));
+
+                    number.start(read_signs && sign == '-');
+                    number.append(bytes + position, length);
+                    if (position + length != width) sink.value(number.finish());
+                }
+
+                before_block = bytes[width - 1];
+            }
+
+            if (number.active) sink.value(number.finish());
+        }
+
+        template<typename Sink>
+        void scan_16(std::string_view text, bool read_signs, Sink & sink) {
+            scan_blocks<Bytes16>(text, read_signs, sink);
+        }
+
+#ifdef BJ_INT_SCANNER_X86
+        template<typename Sink>
+        __attribute__((target("avx2")))
+        void scan_32(std::string_view text, bool read_signs, Sink & sink) {
+            scan_blocks<Bytes32>(text, read_signs, sink);
+        }
+
+        bool has_avx2() {
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        }
+#endif
+
+        template<typename Sink>
+        void scan(std::string_view text, bool read_signs, Sink & sink) {
+#ifdef BJ_INT_SCANNER_X86
+            if (has_avx2()) {
+                scan_32(text, read_signs, sink);
+                return;
+            }
+#endif
+            scan_16(text, read_signs, sink);
+        }
+    }
+
+    std::size_t scan_ints(std::string_view text, std::span<int> out, bool read_signs) {
+        SpanSink<int> sink{ out.data(), out.size() };
+        scan(text, read_signs, sink);
+        return sink.count;
+    }
+
+    std::size_t scan_ints(std::string_view text, std::span<std::int64_t> out, bool read_signs) {
+        SpanSink<std::int64_t> sink{ out.data(), out.size() };
+        scan(text, read_signs, sink);
+        return sink.count;
+    }
+
+    const char * int_scanner_kernel_name() {
+#ifdef BJ_INT_SCANNER_X86
+        if (has_avx2()) return "avx2";
+#endif
+#ifdef __SSE2__
+        return "sse2";
+#else
+        return "generic";
+#endif
+    }
+
+    IntsByLine::IntsByLine(std::string_view text, bool read_signs) {
+        m_values.reserve(text.size() / 4);
+
+        LinesSink sink{ m_values, m_line_starts };
+        scan(text, read_signs, sink);
+
+        if (!text.empty() && text.back() != '\n') sink.newline();
+    }
+
+    IntsByLine::IntsByLine(std::span<const std::string> lines, bool read_signs) {
+        m_line_starts.reserve(lines.size() + 1);
+
+        LinesSink sink{ m_values, m_line_starts };
+        for (const std::string & line : lines) {
+            scan(line, read_signs, sink);
+            sink.newline();
+        }
+    }
+
+    IntsByLine::IntsByLine(std::span<const std::string_view> lines, bool read_signs) {
+        m_line_starts.reserve(lines.size() + 1);
+
+        LinesSink sink{ m_values, m_line_starts };
+        for (const std::string_view line : lines) {
+            scan(line, read_signs, sink);
+            sink.newline();
+        }
+    }
+}
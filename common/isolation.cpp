@@ -0,0 +1,382 @@
+#include "isolation.h"
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// The format is a list of tokens separated by spaces. Strings are prefixed
+// by their size, optional values are written as '-' when they are absent.
+namespace {
+    void write_string(std::ostream & stream, const std::string & str) {
+        stream << str.size() << ':' << str << ' ';
+    }
+
+    bool read_string(std::istream & stream, std::string & str) {
+        size_t size;
+        if (!(stream >> size) || stream.get() != ':') return false;
+
+        str.assign(size, '\0');
+        return static_cast<bool>(stream.read(str.data(), static_cast<std::streamsize>(size)));
+    }
+
+    void write_distribution(std::ostream & stream, const test::TimingDistribution & distribution) {
+        stream << distribution.samples().size() << ' ';
+        for (const std::chrono::nanoseconds sample : distribution.samples()) {
+            stream << sample.count() << ' ';
+        }
+    }
+
+    bool read_distribution(std::istream & stream, test::TimingDistribution & distribution) {
+        size_t size;
+        if (!(stream >> size)) return false;
+
+        std::vector<std::chrono::nanoseconds> samples;
+        for (size_t i = 0; i != size; ++i) {
+            long long int count;
+            if (!(stream >> count)) return false;
+            samples.emplace_back(count);
+        }
+
+        distribution = test::TimingDistribution(std::move(samples));
+        return true;
+    }
+
+    // Reads '-' as nullopt, or a value
+    template<typename T>
+    bool read_optional(std::istream & stream, std::optional<T> & value) {
+        char c;
+        if (!(stream >> c)) return false;
+
+        if (c == '-') {
+            value = std::nullopt;
+            return true;
+        }
+
+        stream.unget();
+        T read;
+        if (!(stream >> read)) return false;
+        value = read;
+        return true;
+    }
+}
+
+void test::write_run_result(std::ostream & stream, const std::optional<RunResult> & result) {
+    if (!result) {
+        stream << "- ";
+        return;
+    }
+
+    stream << "R ";
+
+    for (const std::optional<PartResult> & part : result->parts) {
+        if (!part) {
+            stream << "- ";
+            continue;
+        }
+
+        stream << "P " << static_cast<int>(part->type) << ' ';
+        write_string(stream, part->computed);
+        write_string(stream, part->expected);
+    }
+
+    write_distribution(stream, result->timings);
+    for (const TimingDistribution & phase : result->phases) {
+        write_distribution(stream, phase);
+    }
+
+    if (!result->counters) {
+        stream << "- ";
+    } else {
+        stream << "C ";
+        for (const std::optional<std::uint64_t> & value : result->counters->values) {
+            if (value) {
+                stream << *value << ' ';
+            } else {
+                stream << "- ";
+            }
+        }
+    }
+
+    if (!result->allocations) {
+        stream << "- ";
+    } else {
+        stream << "A " << result->allocations->allocations << ' '
+               << result->allocations->bytes_allocated << ' '
+               << result->allocations->peak_live_bytes << ' ';
+    }
+
+    stream << result->cached << ' ';
+
+    stream << result->profile.size() << ' ';
+    for (const auto & [stack, count] : result->profile) {
+        write_string(stream, stack);
+        stream << count << ' ';
+    }
+
+    write_string(stream, result->output);
+}
+
+bool test::read_run_result(std::istream & stream, std::optional<RunResult> & result) {
+    char tag;
+    if (!(stream >> tag)) return false;
+
+    if (tag == '-') {
+        result = std::nullopt;
+        return true;
+    } else if (tag != 'R') {
+        return false;
+    }
+
+    RunResult read;
+
+    for (std::optional<PartResult> & part : read.parts) {
+        if (!(stream >> tag)) return false;
+        if (tag == '-') continue;
+        if (tag != 'P') return false;
+
+        int type;
+        if (!(stream >> type) || type < 0 || type > static_cast<int>(TestValidation::Crash)) return false;
+
+        PartResult read_part;
+        read_part.type = static_cast<TestValidation>(type);
+        if (!(stream >> std::ws) || !read_string(stream, read_part.computed)) return false;
+        if (!(stream >> std::ws) || !read_string(stream, read_part.expected)) return false;
+        part = std::move(read_part);
+    }
+
+    if (!read_distribution(stream, read.timings)) return false;
+    for (TimingDistribution & phase : read.phases) {
+        if (!read_distribution(stream, phase)) return false;
+    }
+
+    if (!(stream >> tag)) return false;
+    if (tag == 'C') {
+        CounterValues counters;
+        for (std::optional<std::uint64_t> & value : counters.values) {
+            if (!read_optional(stream, value)) return false;
+        }
+        read.counters = counters;
+    } else if (tag != '-') {
+        return false;
+    }
+
+    if (!(stream >> tag)) return false;
+    if (tag == 'A') {
+        AllocationStats allocations;
+        if (!(stream >> allocations.allocations >> allocations.bytes_allocated >> allocations.peak_live_bytes)) return false;
+        read.allocations = allocations;
+    } else if (tag != '-') {
+        return false;
+    }
+
+    if (!(stream >> read.cached)) return false;
+
+    size_t stacks;
+    if (!(stream >> stacks)) return false;
+    for (size_t i = 0; i != stacks; ++i) {
+        std::string stack;
+        std::uint64_t count;
+        if (!(stream >> std::ws) || !read_string(stream, stack) || !(stream >> count)) return false;
+        read.profile.emplace(std::move(stack), count);
+    }
+
+    if (!(stream >> std::ws) || !read_string(stream, read.output)) return false;
+
+    result = std::move(read);
+    return true;
+}
+
+namespace {
+    test::RunResult crashed(std::string reason, std::chrono::nanoseconds duration) {
+        test::RunResult result;
+        result.parts[0] = test::PartResult::crash(std::move(reason));
+        result.timings = test::TimingDistribution({ duration });
+        return result;
+    }
+
+    bool write_all(int fd, std::string_view bytes) {
+        while (!bytes.empty()) {
+            const ssize_t written = ::write(fd, bytes.data(), bytes.size());
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            bytes.remove_prefix(static_cast<size_t>(written));
+        }
+
+        return true;
+    }
+
+    // The child writes its result on this file descriptor, so what the solver
+    // writes on the standard output can not be mixed with it
+    constexpr int result_fd = 3;
+}
+
+std::optional<test::RunResult> test::run_isolated(
+    const std::vector<std::string> & arguments,
+    std::optional<std::chrono::milliseconds> deadline
+) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto elapsed = [&]() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    };
+
+    // Close on exec, so the other children do not inherit the pipe: the
+    // parent would not see its end until they all exit
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0) {
+        return crashed(std::string("pipe: ") + std::strerror(errno), elapsed());
+    }
+
+    // dup2 on the same descriptor would keep it closed on exec
+    if (fds[1] == result_fd) {
+        const int moved = ::fcntl(fds[1], F_DUPFD_CLOEXEC, result_fd + 1);
+        ::close(fds[1]);
+        fds[1] = moved;
+        if (moved < 0) {
+            ::close(fds[0]);
+            return crashed(std::string("fcntl: ") + std::strerror(errno), elapsed());
+        }
+    }
+
+    posix_spawn_file_actions_t actions;
+    ::posix_spawn_file_actions_init(&actions);
+    ::posix_spawn_file_actions_adddup2(&actions, fds[1], result_fd);
+
+    std::vector<char *> argv;
+    for (const std::string & argument : arguments) argv.emplace_back(const_cast<char *>(argument.c_str()));
+    argv.emplace_back(nullptr);
+
+    pid_t pid;
+    const int error = ::posix_spawn(&pid, "/proc/self/exe", &actions, nullptr, argv.data(), environ);
+    ::posix_spawn_file_actions_destroy(&actions);
+    ::close(fds[1]);
+
+    if (error != 0) {
+        ::close(fds[0]);
+        return crashed(std::string("posix_spawn: ") + std::strerror(error), elapsed());
+    }
+
+    std::string received;
+    bool killed = false;
+
+    while (true) {
+        int wait_ms = -1;
+        if (deadline) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(*deadline - elapsed());
+            wait_ms = static_cast<int>(std::max<long long int>(0, remaining.count()));
+        }
+
+        pollfd poll_fd { .fd = fds[0], .events = POLLIN, .revents = 0 };
+        const int ready = ::poll(&poll_fd, 1, wait_ms);
+        if (ready < 0 && errno == EINTR) continue;
+
+        if (ready == 0) {
+            ::kill(pid, SIGKILL);
+            killed = true;
+            break;
+        }
+
+        char buffer[4096];
+        const ssize_t size = ::read(fds[0], buffer, sizeof(buffer));
+        if (size < 0 && errno == EINTR) continue;
+        if (size <= 0) break;
+        received.append(buffer, static_cast<size_t>(size));
+    }
+
+    ::close(fds[0]);
+
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+
+    if (killed) {
+        RunResult result;
+        result.parts[0] = PartResult::timeout();
+        result.timings = TimingDistribution({ elapsed() });
+        return result;
+    }
+
+    if (WIFSIGNALED(status)) {
+        return crashed(::strsignal(WTERMSIG(status)), elapsed());
+    }
+
+    std::istringstream stream(received);
+    std::optional<RunResult> result;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS || !read_run_result(stream, result)) {
+        return crashed("exit status " + std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : -1), elapsed());
+    }
+
+    return result;
+}
+
+void test::run_isolated_child(const std::function<std::optional<RunResult>()> & run) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::optional<RunResult> result;
+    try {
+        result = run();
+    } catch (const std::exception & exception) {
+        result = crashed(exception.what(), std::chrono::steady_clock::now() - start);
+    } catch (...) {
+        result = crashed("unknown exception", std::chrono::steady_clock::now() - start);
+    }
+
+    std::ostringstream stream;
+    write_run_result(stream, result);
+
+    std::cout.flush();
+    std::exit(write_all(result_fd, stream.str()) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+std::string test::ShardFile::path(const std::string & directory, unsigned int index, unsigned int count) {
+    return (std::filesystem::path(directory) / (std::to_string(index) + "-of-" + std::to_string(count))).string();
+}
+
+// One line per config: its position, its filename and its result
+bool test::ShardFile::write(const std::string & directory, unsigned int index, unsigned int count, const Results & results) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    std::ofstream file(path(directory, index, count), std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    for (const auto & [position, config] : results) {
+        file << position << ' ';
+        write_string(file, config.first);
+        write_run_result(file, config.second);
+        file << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
+
+std::optional<test::ShardFile::Results> test::ShardFile::read(const std::string & directory, unsigned int index, unsigned int count) {
+    std::ifstream file(path(directory, index, count), std::ios::binary);
+    if (!file) return std::nullopt;
+
+    Results results;
+
+    size_t position;
+    while (file >> position) {
+        std::string filename;
+        std::optional<RunResult> result;
+        if (!(file >> std::ws) || !read_string(file, filename) || !read_run_result(file, result)) {
+            return std::nullopt;
+        }
+
+        results.emplace(position, std::pair(std::move(filename), std::move(result)));
+    }
+
+    return results;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "advent_of_code.hpp"
+#include <chrono>
+#include <functional>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace test {
+    /** Writes a result in a text format, to send it to another process */
+    void write_run_result(std::ostream & stream, const std::optional<RunResult> & result);
+    /** Reads a result written by `write_run_result`. Returns false if the stream is truncated or malformed. */
+    bool read_run_result(std::istream & stream, std::optional<RunResult> & result);
+
+    /**
+     * Starts a new process of the current executable with the given arguments,
+     * from the program name, and returns the result it sends back through a
+     * pipe with `run_isolated_child`.
+     *
+     * The child is a new process instead of a fork of this one, so it does
+     * not inherit the locks held by the threads of the harness, like the ones
+     * of malloc and stdio.
+     *
+     * A signal that kills the child, an exception thrown in the child or an
+     * unreadable result is reported as a crash. If the child runs for longer
+     * than the deadline, it is killed and reported as a timeout.
+     */
+    std::optional<RunResult> run_isolated(
+        const std::vector<std::string> & arguments,
+        std::optional<std::chrono::milliseconds> deadline
+    );
+
+    /** In the child started by `run_isolated`, calls `run` and sends its result to the parent, then exits */
+    [[noreturn]] void run_isolated_child(const std::function<std::optional<RunResult>()> & run);
+
+    /**
+     * The results of the shard `index` (from 1 to `count`) of a run split with
+     * `--shard index/count`. A config goes to the shard `i % count + 1`, where
+     * `i` is its position in the list of configs run by every shard.
+     */
+    struct ShardFile {
+        /** Position of the config in the full list -> filename of the config, result */
+        using Results = std::map<size_t, std::pair<std::string, std::optional<RunResult>>>;
+
+        static std::string path(const std::string & directory, unsigned int index, unsigned int count);
+
+        static bool write(const std::string & directory, unsigned int index, unsigned int count, const Results & results);
+        static std::optional<Results> read(const std::string & directory, unsigned int index, unsigned int count);
+    };
+}
@@ -0,0 +1,170 @@
+#include "options.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+    [[noreturn]] void usage_error(const char * program, const std::string & message) {
+        std::cerr << message << "\n"
+                  << "Usage: " << program << " [day] [-j N] [--bench N [--warmup N] [--pin CPU]] [--timeout S] [--cached] [--isolate] [--shard I/N | --merge-shards N] [--scale [--scale-factors LIST]] [--counters] [--allocations] [--profile] [--format table|json|csv] [--record] [--compare REV [--threshold X]] [--history FILE]\n"
+                  << "  day          Day to run, 0 for all days, last day if omitted\n"
+                  << "  -j N         Run at most N configs at the same time (default: number of cores, 1 with --bench)\n"
+                  << "  --bench N    Run each config N times and report the timing distribution\n"
+                  << "  --warmup N   Untimed runs before the timed ones with --bench (default: 2)\n"
+                  << "  --pin CPU    Run on the given CPU only, with a higher priority and locked memory when allowed\n"
+                  << "  --timeout S  Ask the solvers that run for more than S seconds to stop, and report them as TIMEOUT\n"
+                  << "  --cached     Reuse the outputs stored in .aoc_cache when neither the input nor the objects of the day changed, and store the new valid ones\n"
+                  << "  --isolate    Run each config in a child process, and report the crashes instead of stopping\n"
+                  << "  --shard I/N  Only run the I-th of N parts of the configs, and store their results in .aoc_shards\n"
+                  << "  --merge-shards N  Report the results stored by the N shards, without running the configs\n"
+                  << "  --scale      Run the solvers on inputs generated 1, 4 and 16 times larger and fit the complexity exponent\n"
+                  << "  --scale-factors LIST  With --scale, comma separated sizes of the inputs (default: 1,4,16)\n"
+                  << "  --counters   Report IPC, cache and branch misses and page faults (Linux perf events)\n"
+                  << "  --allocations  Report the number of allocations, the allocated bytes and the peak of live bytes\n"
+                  << "  --profile    Sample the call stacks of the solvers, and write them in profiles/ as folded stacks\n"
+                  << "  --format F   Write the results as table (default), json or csv\n"
+                  << "  --record     Append the timings to bench_history.jsonl, tagged with the current commit\n"
+                  << "  --compare R  Compare the timings with the ones recorded for the git revision R\n"
+                  << "  --threshold X  With --compare, report the configs more than X% slower (default: 10)\n"
+                  << "  --history F  Record and compare the timings in the file F instead of bench_history.jsonl\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    unsigned int to_unsigned(const char * program, std::string_view option, const char * value, bool allow_zero = false) {
+        if (!value) usage_error(program, "Missing value for " + std::string(option));
+
+        try {
+            const int parsed = std::stoi(value);
+            if (parsed < 0 || (parsed == 0 && !allow_zero)) throw std::out_of_range(value);
+            return static_cast<unsigned int>(parsed);
+        } catch (const std::exception &) {
+            usage_error(program, "Bad value for " + std::string(option) + ": " + value);
+        }
+    }
+}
+
+test::HarnessOptions test::HarnessOptions::parse(int argc, const char * argv[]) {
+    HarnessOptions options;
+    std::optional<unsigned int> jobs;
+
+    const auto next_value = [&](int & i) { ++i; return i < argc ? argv[i] : nullptr; };
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "-j") {
+            jobs = to_unsigned(argv[0], arg, next_value(i));
+        } else if (arg.starts_with("-j")) {
+            jobs = to_unsigned(argv[0], "-j", argv[i] + 2);
+        } else if (arg == "--bench") {
+            options.bench_runs = to_unsigned(argv[0], arg, next_value(i));
+        } else if (arg == "--warmup") {
+            options.warmup_runs = to_unsigned(argv[0], arg, next_value(i), true);
+        } else if (arg == "--pin") {
+            options.pin_cpu = static_cast<int>(to_unsigned(argv[0], arg, next_value(i), true));
+        } else if (arg == "--format") {
+            const char * value = next_value(i);
+            const std::string_view format = value ? value : "";
+            if (format == "table") {
+                options.format = OutputFormat::Table;
+            } else if (format == "json") {
+                options.format = OutputFormat::Json;
+            } else if (format == "csv") {
+                options.format = OutputFormat::Csv;
+            } else {
+                usage_error(argv[0], "Unknown format " + std::string(format));
+            }
+        } else if (arg == "--timeout") {
+            const char * value = next_value(i);
+            try {
+                const double seconds = std::stod(value ? value : "");
+                if (seconds <= 0.) throw std::out_of_range(value);
+                options.timeout = std::chrono::milliseconds(static_cast<long long int>(seconds * 1000.));
+            } catch (const std::exception &) {
+                usage_error(argv[0], "Bad value for --timeout");
+            }
+        } else if (arg == "--cached") {
+            options.cached = true;
+        } else if (arg == "--isolate") {
+            options.isolate = true;
+        } else if (arg == "--isolated-child") {
+            // Added by --isolate to the arguments of its children
+            options.isolated_child = to_unsigned(argv[0], arg, next_value(i), true);
+        } else if (arg == "--shard") {
+            const char * value = next_value(i);
+            const std::string_view shard = value ? value : "";
+            const size_t slash = shard.find('/');
+            if (slash == std::string_view::npos) usage_error(argv[0], "Bad value for --shard: " + std::string(shard));
+
+            const unsigned int index = to_unsigned(argv[0], arg, std::string(shard.substr(0, slash)).c_str());
+            const unsigned int count = to_unsigned(argv[0], arg, std::string(shard.substr(slash + 1)).c_str());
+            if (index > count) usage_error(argv[0], "Bad value for --shard: " + std::string(shard));
+
+            options.shard = std::pair(index, count);
+        } else if (arg == "--merge-shards") {
+            options.merge_shards = to_unsigned(argv[0], arg, next_value(i));
+        } else if (arg == "--scale") {
+            options.scale = true;
+        } else if (arg == "--scale-factors") {
+            const char * value = next_value(i);
+            if (!value) usage_error(argv[0], "Missing value for --scale-factors");
+
+            options.scale_factors.clear();
+            std::string_view list = value;
+            while (!list.empty()) {
+                const size_t comma = std::min(list.find(','), list.size());
+                options.scale_factors.emplace_back(to_unsigned(argv[0], arg, std::string(list.substr(0, comma)).c_str()));
+                list.remove_prefix(std::min(comma + 1, list.size()));
+            }
+
+            if (options.scale_factors.empty()) usage_error(argv[0], "Bad value for --scale-factors");
+        } else if (arg == "--counters") {
+            options.counters = true;
+        } else if (arg == "--allocations") {
+            options.allocations = true;
+        } else if (arg == "--profile") {
+            options.profile = true;
+        } else if (arg == "--record") {
+            options.record = true;
+        } else if (arg == "--history") {
+            const char * value = next_value(i);
+            if (!value) usage_error(argv[0], "Missing value for --history");
+            options.history_path = value;
+        } else if (arg == "--compare") {
+            const char * value = next_value(i);
+            if (!value) usage_error(argv[0], "Missing value for --compare");
+            options.compare_with = value;
+        } else if (arg == "--threshold") {
+            const char * value = next_value(i);
+            try {
+                options.regression_threshold = std::stod(value ? value : "");
+            } catch (const std::exception &) {
+                usage_error(argv[0], "Bad value for --threshold");
+            }
+        } else if (!arg.empty() && arg[0] >= '0' && arg[0] <= '9') {
+            options.day = std::stoi(argv[i]);
+        } else {
+            usage_error(argv[0], "Unknown argument " + std::string(arg));
+        }
+    }
+
+    if (options.shard && options.merge_shards) {
+        usage_error(argv[0], "--shard and --merge-shards can not be used together");
+    }
+
+    // Benchmarks are run one at a time unless asked otherwise, to not have
+    // the configs compete for the caches and the memory bandwidth
+    if (jobs) {
+        options.jobs = *jobs;
+    } else if (options.is_bench() || options.pin_cpu) {
+        options.jobs = 1;
+    } else {
+        options.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    return options;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace test {
+    enum class OutputFormat { Table, Json, Csv };
+
+    /** Options of the harness, read from the command line */
+    struct HarnessOptions {
+        /** Day to run. 0 = all days, nullopt = last day of the configuration */
+        std::optional<int> day = std::nullopt;
+        /** Maximum number of configs run at the same time */
+        unsigned int jobs = 1;
+        /** Number of timed runs of each config in benchmark mode, nullopt = not benchmarking */
+        std::optional<unsigned int> bench_runs = std::nullopt;
+        /** Number of untimed runs of each config before the timed ones in benchmark mode */
+        unsigned int warmup_runs = 2;
+
+        /** Duration after which a solver is asked to stop, nullopt = no limit */
+        std::optional<std::chrono::milliseconds> timeout = std::nullopt;
+
+        /** Reuse the outputs stored in the result cache */
+        bool cached = false;
+
+        /** Run each config in a child process, so a crash only fails its config */
+        bool isolate = false;
+        /** Set in the children of --isolate: position of the config to run in the list of all the configs */
+        std::optional<unsigned int> isolated_child = std::nullopt;
+        /** Only run the configs of the shard (index from 1 to count, count) and store their results */
+        std::optional<std::pair<unsigned int, unsigned int>> shard = std::nullopt;
+        /** Report the results stored by the given number of shards instead of running the configs */
+        std::optional<unsigned int> merge_shards = std::nullopt;
+
+        /** Run the solvers on generated inputs larger than the real one and estimate their complexity */
+        bool scale = false;
+        /** Sizes of the generated inputs, relative to the real input */
+        std::vector<unsigned int> scale_factors = { 1, 4, 16 };
+
+        /** CPU on which the process is pinned, with a higher priority and locked memory */
+        std::optional<int> pin_cpu = std::nullopt;
+
+        /** Read the hardware performance counters of each run */
+        bool counters = false;
+        /** Sample the call stacks of the solvers and write them in profiles/ */
+        bool profile = false;
+        /** Show the allocations of each config in the table */
+        bool allocations = false;
+        /** How the results are written on the standard output */
+        OutputFormat format = OutputFormat::Table;
+        /** Append the timings to the history file */
+        bool record = false;
+        /** The history file of --record and --compare */
+        std::string history_path = "bench_history.jsonl";
+        /** Git revision whose recorded timings are compared with the current run */
+        std::optional<std::string> compare_with = std::nullopt;
+        /** Slowdown, in percent, above which a config is reported as slower */
+        double regression_threshold = 10.;
+
+        [[nodiscard]] bool is_bench() const noexcept { return bench_runs.has_value(); }
+
+        static HarnessOptions parse(int argc, const char * argv[]);
+    };
+}
@@ -0,0 +1,54 @@
+#include "output_capture.h"
+#include <iostream>
+#include <utility>
+
+namespace {
+    thread_local std::string * captured_output = nullptr;
+}
+
+test::CapturedStandardStreams::Buffer::int_type test::CapturedStandardStreams::Buffer::overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+
+    if (captured_output) {
+        captured_output->push_back(traits_type::to_char_type(c));
+        return c;
+    }
+
+    return m_original->sputc(traits_type::to_char_type(c));
+}
+
+std::streamsize test::CapturedStandardStreams::Buffer::xsputn(const char * s, std::streamsize count) {
+    if (captured_output) {
+        captured_output->append(s, static_cast<size_t>(count));
+        return count;
+    }
+
+    return m_original->sputn(s, count);
+}
+
+int test::CapturedStandardStreams::Buffer::sync() {
+    return captured_output ? 0 : m_original->pubsync();
+}
+
+test::CapturedStandardStreams::CapturedStandardStreams()
+: m_cout(std::cout.rdbuf()), m_cerr(std::cerr.rdbuf()) {
+    std::cout.rdbuf(&m_cout);
+    std::cerr.rdbuf(&m_cerr);
+}
+
+test::CapturedStandardStreams::~CapturedStandardStreams() {
+    std::cout.rdbuf(m_cout.original());
+    std::cerr.rdbuf(m_cerr.original());
+}
+
+test::OutputCapture::OutputCapture() : m_previous(captured_output) {
+    captured_output = &m_output;
+}
+
+test::OutputCapture::~OutputCapture() {
+    captured_output = m_previous;
+}
+
+std::string test::OutputCapture::take() {
+    return std::exchange(m_output, std::string());
+}
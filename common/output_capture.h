@@ -0,0 +1,62 @@
+#pragma once
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace test {
+    /**
+     * Replaces the buffers of std::cout and std::cerr, so the text written by
+     * a thread in an `OutputCapture` is kept aside instead of being written.
+     * The other threads still write to the terminal.
+     *
+     * The configs run in parallel, so their output is printed with their row
+     * of the table instead of in the middle of the rows of the other configs.
+     */
+    class CapturedStandardStreams {
+        class Buffer : public std::streambuf {
+            std::streambuf * m_original;
+
+        public:
+            explicit Buffer(std::streambuf * original) : m_original(original) {}
+
+            [[nodiscard]] std::streambuf * original() const noexcept { return m_original; }
+
+        protected:
+            // No put area: every character goes through these, so the thread
+            // that writes it decides where it goes
+            int_type overflow(int_type c) override;
+            std::streamsize xsputn(const char * s, std::streamsize count) override;
+            int sync() override;
+        };
+
+        Buffer m_cout;
+        Buffer m_cerr;
+
+    public:
+        CapturedStandardStreams();
+        ~CapturedStandardStreams();
+
+        CapturedStandardStreams(const CapturedStandardStreams &) = delete;
+        CapturedStandardStreams & operator=(const CapturedStandardStreams &) = delete;
+    };
+
+    /**
+     * Keeps the text written on std::cout and std::cerr by the current thread
+     * while it exists, if a `CapturedStandardStreams` is installed.
+     */
+    class OutputCapture {
+        std::string m_output;
+        std::string * m_previous;
+
+    public:
+        OutputCapture();
+        ~OutputCapture();
+
+        OutputCapture(const OutputCapture &) = delete;
+        OutputCapture & operator=(const OutputCapture &) = delete;
+
+        /** The text written since the capture started, or since the last call */
+        [[nodiscard]] std::string take();
+    };
+}
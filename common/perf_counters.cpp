@@ -0,0 +1,186 @@
+#include "perf_counters.h"
+#include <cstdio>
+#include <utility>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define AOC_HAS_PERF_EVENTS 1
+#else
+#define AOC_HAS_PERF_EVENTS 0
+#endif
+
+std::optional<double> test::CounterValues::ipc() const {
+    const auto cycles = get(PerfEvent::Cycles);
+    const auto instructions = get(PerfEvent::Instructions);
+    if (!cycles || !instructions || *cycles == 0) return std::nullopt;
+    return static_cast<double>(*instructions) / static_cast<double>(*cycles);
+}
+
+std::optional<double> test::CounterValues::per_kilo_instruction(PerfEvent event) const {
+    const auto count = get(event);
+    const auto instructions = get(PerfEvent::Instructions);
+    if (!count || !instructions || *instructions == 0) return std::nullopt;
+    return 1000. * static_cast<double>(*count) / static_cast<double>(*instructions);
+}
+
+test::CounterValues & test::CounterValues::operator/=(std::uint64_t divisor) {
+    if (divisor == 0) return *this;
+
+    for (auto & value : values) {
+        if (value) *value /= divisor;
+    }
+
+    return *this;
+}
+
+test::CounterValues & test::CounterValues::operator+=(const CounterValues & other) {
+    for (size_t i = 0; i != nb_of_perf_events; ++i) {
+        if (values[i] && other.values[i]) {
+            *values[i] += *other.values[i];
+        } else {
+            values[i] = std::nullopt;
+        }
+    }
+
+    return *this;
+}
+
+std::string test::CounterValues::summary() const {
+    std::string retval;
+    char buffer[64];
+
+    if (const auto value = ipc()) {
+        std::sprintf(buffer, "IPC %4.2f ", *value);
+        retval += buffer;
+    }
+
+    if (const auto value = per_kilo_instruction(PerfEvent::CacheMisses)) {
+        std::sprintf(buffer, "cache-MPKI %6.2f ", *value);
+        retval += buffer;
+    }
+
+    if (const auto value = per_kilo_instruction(PerfEvent::BranchMisses)) {
+        std::sprintf(buffer, "br-MPKI %6.2f ", *value);
+        retval += buffer;
+    }
+
+    if (const auto value = get(PerfEvent::PageFaults)) {
+        std::sprintf(buffer, "faults %8llu ", static_cast<unsigned long long>(*value));
+        retval += buffer;
+    }
+
+    return retval;
+}
+
+test::PerfCounters::PerfCounters() {
+    m_fds.fill(-1);
+}
+
+test::PerfCounters::PerfCounters(PerfCounters && other) noexcept : m_fds(other.m_fds) {
+    other.m_fds.fill(-1);
+}
+
+test::PerfCounters::~PerfCounters() {
+#if AOC_HAS_PERF_EVENTS
+    for (const int fd : m_fds) {
+        if (fd >= 0) ::close(fd);
+    }
+#endif
+}
+
+#if AOC_HAS_PERF_EVENTS
+namespace {
+    std::pair<std::uint32_t, std::uint64_t> to_perf_type(test::PerfEvent event) {
+        switch (event) {
+            case test::PerfEvent::Cycles:       return { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES };
+            case test::PerfEvent::Instructions: return { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS };
+            case test::PerfEvent::CacheMisses:  return { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES };
+            case test::PerfEvent::BranchMisses: return { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES };
+            case test::PerfEvent::PageFaults:   return { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS };
+        }
+        return { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS };
+    }
+
+    int open_counter(test::PerfEvent event) {
+        const auto [type, config] = to_perf_type(event);
+
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        // Page faults are handled by the kernel, so they would never be counted
+        attr.exclude_kernel = type == PERF_TYPE_HARDWARE ? 1 : 0;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // Counts the calling thread, on any CPU
+        return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+}
+#endif
+
+std::optional<test::PerfCounters> test::PerfCounters::open() {
+#if AOC_HAS_PERF_EVENTS
+    PerfCounters counters;
+    bool has_one = false;
+
+    for (size_t i = 0; i != nb_of_perf_events; ++i) {
+        counters.m_fds[i] = open_counter(static_cast<PerfEvent>(i));
+        has_one |= counters.m_fds[i] >= 0;
+    }
+
+    if (!has_one) return std::nullopt;
+    return counters;
+#else
+    return std::nullopt;
+#endif
+}
+
+bool test::PerfCounters::has(PerfEvent event) const {
+    return m_fds[static_cast<size_t>(event)] >= 0;
+}
+
+void test::PerfCounters::start() {
+#if AOC_HAS_PERF_EVENTS
+    for (const int fd : m_fds) {
+        if (fd < 0) continue;
+        ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+test::CounterValues test::PerfCounters::stop() {
+    CounterValues result;
+
+#if AOC_HAS_PERF_EVENTS
+    for (const int fd : m_fds) {
+        if (fd >= 0) ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    for (size_t i = 0; i != nb_of_perf_events; ++i) {
+        if (m_fds[i] < 0) continue;
+
+        std::uint64_t data[3] = { 0, 0, 0 }; // value, time enabled, time running
+        if (::read(m_fds[i], data, sizeof(data)) != sizeof(data)) continue;
+
+        // The kernel multiplexes the counters when there are not enough of
+        // them, in which case the value is extrapolated
+        if (data[2] == 0) {
+            result.values[i] = data[1] == 0 ? std::optional<std::uint64_t>(data[0]) : std::nullopt;
+        } else if (data[2] < data[1]) {
+            result.values[i] = static_cast<std::uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+        } else {
+            result.values[i] = data[0];
+        }
+    }
+#endif
+
+    return result;
+}
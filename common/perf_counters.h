@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace test {
+    /** Hardware and software events counted during a run */
+    enum class PerfEvent { Cycles, Instructions, CacheMisses, BranchMisses, PageFaults };
+    inline constexpr size_t nb_of_perf_events = 5;
+
+    /** The values of the counters. Events that the kernel refused to count are nullopt. */
+    struct CounterValues {
+        std::array<std::optional<std::uint64_t>, nb_of_perf_events> values;
+
+        [[nodiscard]] std::optional<std::uint64_t> get(PerfEvent event) const {
+            return values[static_cast<size_t>(event)];
+        }
+
+        /** Instructions per cycle */
+        [[nodiscard]] std::optional<double> ipc() const;
+        /** Number of events per thousand instructions */
+        [[nodiscard]] std::optional<double> per_kilo_instruction(PerfEvent event) const;
+
+        /** Divides every value, to average the counters of several runs */
+        CounterValues & operator/=(std::uint64_t divisor);
+        CounterValues & operator+=(const CounterValues & other);
+
+        /** A short human readable summary: IPC, misses per kilo-instruction and page faults */
+        [[nodiscard]] std::string summary() const;
+    };
+
+    /**
+     * Counters opened with perf_event_open for the calling thread.
+     *
+     * Only available on Linux, and when the kernel lets the user read the
+     * counters (see /proc/sys/kernel/perf_event_paranoid).
+     */
+    class PerfCounters {
+        std::array<int, nb_of_perf_events> m_fds;
+
+        PerfCounters();
+
+    public:
+        /** Opens the counters, or returns nullopt if none of them can be opened */
+        static std::optional<PerfCounters> open();
+
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters & operator=(const PerfCounters &) = delete;
+        PerfCounters(PerfCounters && other) noexcept;
+        PerfCounters & operator=(PerfCounters &&) = delete;
+        ~PerfCounters();
+
+        [[nodiscard]] bool has(PerfEvent event) const;
+
+        void start();
+        CounterValues stop();
+    };
+}
@@ -0,0 +1,396 @@
+#include "report.h"
+#include "bench_environment.h"
+#include "colors.h"
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifndef AOC_BUILD_PROFILE
+#define AOC_BUILD_PROFILE "unknown"
+#endif
+
+const char * const test::build_profile = AOC_BUILD_PROFILE;
+
+namespace {
+    std::string json_escape(std::string_view str) {
+        std::string escaped;
+        escaped.reserve(str.size() + 2);
+        escaped += '"';
+
+        for (const char c : str) {
+            switch (c) {
+                case '"':  escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n";  break;
+                case '\t': escaped += "\\t";  break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buffer[8];
+                        std::sprintf(buffer, "\\u%04x", c);
+                        escaped += buffer;
+                    } else {
+                        escaped += c;
+                    }
+            }
+        }
+
+        escaped += '"';
+        return escaped;
+    }
+
+    std::string csv_escape(std::string_view str) {
+        if (str.find_first_of(",\"\n") == std::string_view::npos) return std::string(str);
+
+        std::string escaped = "\"";
+        for (const char c : str) {
+            if (c == '"') escaped += '"';
+            escaped += c;
+        }
+        escaped += '"';
+        return escaped;
+    }
+
+    const char * to_string(test::TestValidation validation) {
+        switch (validation) {
+            case test::TestValidation::Success:  return "success";
+            case test::TestValidation::Fail:     return "fail";
+            case test::TestValidation::Computed: return "computed";
+            case test::TestValidation::Timeout:  return "timeout";
+            case test::TestValidation::Crash:    return "crash";
+        }
+        return "unknown";
+    }
+
+    const char * status_of(const test::ReportEntry & entry) {
+        if (!entry.result) return "no handler";
+        return to_string(entry.result->get_overall());
+    }
+
+    void write_distribution(std::ostream & stream, const test::TimingDistribution & timings) {
+        stream << "{\"runs\":" << timings.samples().size()
+               << ",\"min_ns\":" << timings.min().count()
+               << ",\"median_ns\":" << timings.median().count()
+               << ",\"p90_ns\":" << timings.p90().count()
+               << ",\"stddev_ns\":" << timings.stddev().count()
+               << ",\"samples_ns\":[";
+
+        into_stream(stream, timings.samples(), ",", [](std::ostream & s, std::chrono::nanoseconds sample) {
+            s << sample.count();
+        });
+
+        stream << "]}";
+    }
+
+    void write_counters(std::ostream & stream, const test::CounterValues & counters) {
+        static constexpr std::array<const char *, test::nb_of_perf_events> names {
+            "cycles", "instructions", "cache_misses", "branch_misses", "page_faults"
+        };
+
+        stream << ",\"counters\":{";
+
+        bool first = true;
+        for (size_t i = 0; i != test::nb_of_perf_events; ++i) {
+            if (!counters.values[i]) continue;
+            stream << (first ? "" : ",") << '"' << names[i] << "\":" << *counters.values[i];
+            first = false;
+        }
+
+        if (const auto ipc = counters.ipc()) {
+            stream << (first ? "" : ",") << "\"ipc\":" << *ipc;
+        }
+
+        stream << "}";
+    }
+
+    /** Reads the values of an object written by BenchHistory::append. Nested values are not supported. */
+    std::map<std::string, std::string> parse_flat_json_object(std::string_view line) {
+        std::map<std::string, std::string> values;
+
+        size_t i = 0;
+        const auto skip_spaces = [&]() { while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) ++i; };
+        const auto read_string = [&]() {
+            std::string str;
+            ++i; // opening quote
+            while (i < line.size() && line[i] != '"') {
+                if (line[i] == '\\' && i + 1 < line.size()) ++i;
+                str += line[i];
+                ++i;
+            }
+            ++i; // closing quote
+            return str;
+        };
+
+        skip_spaces();
+        if (i == line.size() || line[i] != '{') return values;
+        ++i;
+
+        while (i < line.size()) {
+            skip_spaces();
+            if (i == line.size() || line[i] != '"') break;
+            const std::string key = read_string();
+
+            skip_spaces();
+            if (i == line.size() || line[i] != ':') break;
+            ++i;
+            skip_spaces();
+
+            if (i < line.size() && line[i] == '"') {
+                values[key] = read_string();
+            } else {
+                const size_t from = i;
+                while (i < line.size() && line[i] != ',' && line[i] != '}') ++i;
+                values[key] = std::string(line.substr(from, i - from));
+            }
+
+            skip_spaces();
+            if (i < line.size() && line[i] == ',') ++i;
+        }
+
+        return values;
+    }
+}
+
+void test::write_json(std::ostream & stream, const std::vector<ReportEntry> & entries) {
+    stream << "[\n";
+
+    for (size_t i = 0; i != entries.size(); ++i) {
+        const ReportEntry & entry = entries[i];
+
+        stream << "  {";
+        if (entry.config->year != 0) stream << "\"year\":" << entry.config->year << ",";
+        stream << "\"day\":" << entry.config->day
+               << ",\"file\":" << json_escape(entry.config->filename)
+               << ",\"status\":" << json_escape(status_of(entry))
+               << ",\"profile\":" << json_escape(build_profile);
+
+        const MachineState & machine = machine_state();
+        stream << ",\"machine\":{\"cpu\":" << (machine.pinned_cpu ? std::to_string(*machine.pinned_cpu) : "null")
+               << ",\"governor\":" << (machine.governor ? json_escape(*machine.governor) : "null")
+               << ",\"smt\":" << (!machine.smt ? "null" : *machine.smt ? "true" : "false")
+               << ",\"nice\":" << machine.nice
+               << ",\"memory_locked\":" << (machine.memory_locked ? "true" : "false") << "}";
+
+        if (entry.result && entry.result->cached) stream << ",\"cached\":true";
+
+        if (entry.result) {
+            stream << ",\"parts\":[";
+            into_stream(stream, entry.result->parts, ",", [](std::ostream & s, const std::optional<PartResult> & part) {
+                if (!part) {
+                    s << "null";
+                } else {
+                    s << "{\"computed\":" << json_escape(part->computed)
+                      << ",\"expected\":" << json_escape(part->expected)
+                      << ",\"validation\":" << json_escape(to_string(part->type)) << "}";
+                }
+            });
+            stream << "],\"timings\":";
+            write_distribution(stream, entry.result->timings);
+
+            if (entry.result->counters) {
+                write_counters(stream, *entry.result->counters);
+            }
+
+            if (const std::optional<AllocationStats> & allocations = entry.result->allocations) {
+                stream << ",\"allocations\":{\"count\":" << allocations->allocations
+                       << ",\"bytes\":" << allocations->bytes_allocated
+                       << ",\"peak_live_bytes\":" << allocations->peak_live_bytes << "}";
+            }
+
+            if (!entry.result->phases[0].empty()) {
+                stream << ",\"phases\":{\"parse\":";
+                write_distribution(stream, entry.result->phases[static_cast<size_t>(Phase::Parse)]);
+                stream << ",\"part_a\":";
+                write_distribution(stream, entry.result->phases[static_cast<size_t>(Phase::PartA)]);
+                stream << ",\"part_b\":";
+                write_distribution(stream, entry.result->phases[static_cast<size_t>(Phase::PartB)]);
+                stream << "}";
+            }
+        }
+
+        stream << "}" << (i + 1 == entries.size() ? "\n" : ",\n");
+    }
+
+    stream << "]\n";
+}
+
+void test::write_csv(std::ostream & stream, const std::vector<ReportEntry> & entries) {
+    stream << "day,file,status,part_a,part_a_validation,part_b,part_b_validation,runs,min_ns,median_ns,p90_ns,stddev_ns\n";
+
+    for (const ReportEntry & entry : entries) {
+        stream << entry.config->day << ','
+               << csv_escape(entry.config->filename) << ','
+               << csv_escape(status_of(entry));
+
+        if (!entry.result) {
+            stream << ",,,,,,,,,\n";
+            continue;
+        }
+
+        for (const std::optional<PartResult> & part : entry.result->parts) {
+            if (part) {
+                stream << ',' << csv_escape(part->computed) << ',' << to_string(part->type);
+            } else {
+                stream << ",,";
+            }
+        }
+
+        const TimingDistribution & timings = entry.result->timings;
+        stream << ',' << timings.samples().size()
+               << ',' << timings.min().count()
+               << ',' << timings.median().count()
+               << ',' << timings.p90().count()
+               << ',' << timings.stddev().count()
+               << '\n';
+    }
+}
+
+static std::optional<std::string> run_command(const std::string & command) {
+    FILE * pipe = ::popen(command.c_str(), "r");
+    if (!pipe) return std::nullopt;
+
+    std::array<char, 128> buffer;
+    std::string output;
+    while (std::fgets(buffer.data(), buffer.size(), pipe)) {
+        output += buffer.data();
+    }
+
+    if (::pclose(pipe) != 0) return std::nullopt;
+    return output;
+}
+
+bool test::git_is_dirty() {
+    const auto output = run_command("git status --porcelain --untracked-files=no 2>/dev/null");
+    return output && !output->empty();
+}
+
+std::optional<std::string> test::git_rev_parse(const std::string & revision) {
+    // Revisions come from the command line, only let through what git accepts in a ref
+    for (const char c : revision) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && std::string_view("~^@{}/._-").find(c) == std::string_view::npos) {
+            return std::nullopt;
+        }
+    }
+
+    auto output = run_command("git rev-parse --verify --quiet " + revision + "^{commit} 2>/dev/null");
+    if (!output) return std::nullopt;
+
+    while (!output->empty() && (output->back() == '\n' || output->back() == '\r')) output->pop_back();
+    if (output->empty()) return std::nullopt;
+    return output;
+}
+
+void test::BenchHistory::append(const std::string & commit, bool dirty, const std::vector<ReportEntry> & entries) const {
+    std::ofstream file(m_path, std::ios::app);
+
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+
+    for (const ReportEntry & entry : entries) {
+        if (!entry.result || entry.result->cached) continue;
+
+        const TimingDistribution & timings = entry.result->timings;
+
+        file << "{\"commit\":" << json_escape(commit)
+             << ",\"dirty\":" << (dirty ? "true" : "false")
+             << ",\"timestamp\":" << timestamp
+             << ",\"profile\":" << json_escape(build_profile)
+             << ",\"machine\":" << json_escape(machine_state().summary())
+             << ",\"day\":" << entry.config->day
+             << ",\"file\":" << json_escape(entry.config->filename)
+             << ",\"status\":" << json_escape(status_of(entry))
+             << ",\"runs\":" << timings.samples().size()
+             << ",\"min_ns\":" << timings.min().count()
+             << ",\"median_ns\":" << timings.median().count()
+             << ",\"p90_ns\":" << timings.p90().count()
+             << ",\"stddev_ns\":" << timings.stddev().count()
+             << "}\n";
+    }
+}
+
+std::map<std::pair<int, std::string>, long long int> test::BenchHistory::medians_of(const std::string & commit) const {
+    std::map<std::pair<int, std::string>, long long int> medians;
+
+    std::ifstream file(m_path);
+    std::string line;
+    while (std::getline(file, line)) {
+        const auto values = parse_flat_json_object(line);
+
+        const auto commit_it = values.find("commit");
+        if (commit_it == values.end() || commit_it->second != commit) continue;
+
+        // Records written before the profiles existed have no profile
+        const auto profile_it = values.find("profile");
+        if (profile_it != values.end() && profile_it->second != build_profile) continue;
+
+        const auto day_it    = values.find("day");
+        const auto file_it   = values.find("file");
+        const auto median_it = values.find("median_ns");
+        if (day_it == values.end() || file_it == values.end() || median_it == values.end()) continue;
+
+        // Later lines are more recent runs of the same commit
+        medians[std::pair(std::stoi(day_it->second), file_it->second)] = std::stoll(median_it->second);
+    }
+
+    return medians;
+}
+
+unsigned int test::compare_with_baseline(
+    std::ostream & stream,
+    const std::vector<ReportEntry> & entries,
+    const std::map<std::pair<int, std::string>, long long int> & baseline,
+    double threshold_percent
+) {
+    unsigned int regressions = 0;
+    char buffer[512];
+
+    for (const ReportEntry & entry : entries) {
+        if (!entry.result || entry.result->cached) continue;
+
+        const auto it = baseline.find(std::pair(entry.config->day, entry.config->filename));
+        if (it == baseline.end() || it->second <= 0) continue;
+
+        const auto before = std::chrono::nanoseconds(it->second);
+        const auto after  = entry.result->timings.median();
+        const double change = 100. * (static_cast<double>(after.count()) - before.count()) / before.count();
+        const bool is_regression = change > threshold_percent;
+
+        if (is_regression) ++regressions;
+
+        std::sprintf(buffer, "%s-- Day %02d %-30s %9s -> %9s  %+7.1f%%%s" RST "\n",
+            is_regression ? KRED : change < -threshold_percent ? KGRN : "",
+            entry.config->day, entry.config->filename.c_str(),
+            format_duration(before).c_str(), format_duration(after).c_str(),
+            change,
+            is_regression ? "  SLOWER" : ""
+        );
+        stream << buffer;
+    }
+
+    return regressions;
+}
+
+std::optional<std::string> test::BenchHistory::machine_of(const std::string & commit) const {
+    std::optional<std::string> machine;
+
+    std::ifstream file(m_path);
+    std::string line;
+    while (std::getline(file, line)) {
+        const auto values = parse_flat_json_object(line);
+
+        const auto commit_it = values.find("commit");
+        if (commit_it == values.end() || commit_it->second != commit) continue;
+
+        const auto profile_it = values.find("profile");
+        if (profile_it != values.end() && profile_it->second != build_profile) continue;
+
+        // Records written before the machine was recorded have none
+        const auto machine_it = values.find("machine");
+        if (machine_it != values.end()) machine = machine_it->second;
+    }
+
+    return machine;
+}
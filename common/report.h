@@ -0,0 +1,64 @@
+#pragma once
+
+#include "advent_of_code.hpp"
+#include "configuration.h"
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace test {
+    /** The build profile of the executable (release, debug, pgo) given by the Makefile */
+    extern const char * const build_profile;
+
+    /** The result of a config, as exported or stored in the history */
+    struct ReportEntry {
+        const InputConfig * config;
+        std::optional<RunResult> result;
+    };
+
+    /** Writes the results as a JSON array, one object per config */
+    void write_json(std::ostream & stream, const std::vector<ReportEntry> & entries);
+    /** Writes the results as CSV, one line per config */
+    void write_csv(std::ostream & stream, const std::vector<ReportEntry> & entries);
+
+    /** Returns the full hash of a git revision, or nullopt if git is not able to resolve it */
+    std::optional<std::string> git_rev_parse(const std::string & revision);
+    /** True if the tracked files differ from the checked out commit */
+    bool git_is_dirty();
+
+    /**
+     * Timings of previous runs, stored in an append-only file with one JSON
+     * object per line and per config, tagged with the commit that was run.
+     */
+    class BenchHistory {
+        std::string m_path;
+
+    public:
+        explicit BenchHistory(std::string path) : m_path(std::move(path)) {}
+
+        /** Appends the timings of the given results */
+        void append(const std::string & commit, bool dirty, const std::vector<ReportEntry> & entries) const;
+
+        /**
+         * Median duration in ns of each (day, file) for the last run of the
+         * given commit, built with the same profile as this executable
+         */
+        [[nodiscard]] std::map<std::pair<int, std::string>, long long int> medians_of(const std::string & commit) const;
+
+        /** The `MachineState::summary` of the last run of the given commit with the same profile */
+        [[nodiscard]] std::optional<std::string> machine_of(const std::string & commit) const;
+    };
+
+    /**
+     * Prints the configs whose median duration is more than threshold_percent
+     * slower than the baseline. Returns the number of such configs.
+     */
+    unsigned int compare_with_baseline(
+        std::ostream & stream,
+        const std::vector<ReportEntry> & entries,
+        const std::map<std::pair<int, std::string>, long long int> & baseline,
+        double threshold_percent
+    );
+}
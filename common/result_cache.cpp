@@ -0,0 +1,161 @@
+#include "result_cache.h"
+#include "advent_of_code.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+
+test::ContentHash & test::ContentHash::add(std::string_view bytes) {
+    for (const char c : bytes) {
+        m_value ^= static_cast<unsigned char>(c);
+        m_value *= 0x100000001b3ULL;
+    }
+
+    return *this;
+}
+
+test::ContentHash & test::ContentHash::add(std::uint64_t value) {
+    for (int i = 0; i != 8; ++i) {
+        m_value ^= (value >> (i * 8)) & 0xFF;
+        m_value *= 0x100000001b3ULL;
+    }
+
+    return *this;
+}
+
+/** dayXX.o, dayXX_Name.o, or dayXX_YY_ZZ.o when a file solves several days */
+static bool is_object_of_day(std::string_view stem, int day) {
+    if (!stem.starts_with("day")) return false;
+    stem.remove_prefix(3);
+
+    while (!stem.empty()) {
+        const size_t end = std::min(stem.find('_'), stem.size());
+        const std::string_view token = stem.substr(0, end);
+        if (token.empty() || !std::all_of(token.begin(), token.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            return false;
+        }
+
+        if (std::stoi(std::string(token)) == day) return true;
+
+        stem.remove_prefix(std::min(end + 1, stem.size()));
+    }
+
+    return false;
+}
+
+/** The folder of the year at the start of the paths of the multi year driver, like 2016/src/day13.o */
+static std::optional<int> year_of_object(std::string_view path) {
+    if (path.size() < 5 || path[4] != '/') return std::nullopt;
+    if (!std::all_of(path.begin(), path.begin() + 4, [](char c) { return c >= '0' && c <= '9'; })) return std::nullopt;
+    return std::stoi(std::string(path.substr(0, 4)));
+}
+
+test::ResultCache::ResultCache(std::string directory) : m_directory(std::move(directory)) {}
+
+std::optional<std::uint64_t> test::ResultCache::solver_hash(int year, int day) const {
+    std::lock_guard lock(m_mutex);
+
+    const auto it = m_solver_hashes.find(std::pair(year, day));
+    if (it != m_solver_hashes.end()) return it->second;
+
+    ContentHash content;
+    bool has_day_object = false;
+
+    if (aoc_object_hashes) {
+        for (const ObjectHash & object : aoc_object_hashes()) {
+            std::string_view path = object.path;
+
+            // The objects of the other years and of the other days are not
+            // linked with the solver
+            if (const std::optional<int> object_year = year_of_object(path)) {
+                if (*object_year != year) continue;
+                path.remove_prefix(5);
+            }
+
+            if (path.starts_with("src/") && path.ends_with(".o")) {
+                const std::string_view stem = path.substr(4, path.size() - 6);
+                if (is_object_of_day(stem, day)) {
+                    has_day_object = true;
+                } else if (stem.starts_with("day")) {
+                    continue;
+                }
+            }
+
+            content.add(object.path).add(object.hash);
+        }
+    }
+
+    const std::optional<std::uint64_t> hash = has_day_object ? std::optional(content.value()) : std::nullopt;
+    m_solver_hashes.emplace(std::pair(year, day), hash);
+    return hash;
+}
+
+std::uint64_t test::ResultCache::input_hash(std::span<const std::string_view> lines, const DayExtraInfo & dei) {
+    ContentHash hash;
+
+    for (const std::string_view line : lines) {
+        hash.add(line).add("\n");
+    }
+
+    hash.add(static_cast<std::uint64_t>(dei.can_skip_part_A))
+        .add(static_cast<std::uint64_t>(dei.part_a_extra_param))
+        .add(static_cast<std::uint64_t>(dei.can_skip_part_B))
+        .add(static_cast<std::uint64_t>(dei.part_b_extra_param));
+
+    return hash.value();
+}
+
+std::string test::ResultCache::path_of(const Key & key) const {
+    char name[96];
+    std::snprintf(name, sizeof(name), "%04d-%02d-%016llx-%016llx",
+        key.year, key.day,
+        static_cast<unsigned long long>(key.input_hash),
+        static_cast<unsigned long long>(key.solver_hash)
+    );
+
+    return (std::filesystem::path(m_directory) / name).string();
+}
+
+// The file contains the size of each part on its own line, followed by the part
+std::optional<Output> test::ResultCache::get(const Key & key) const {
+    std::ifstream file(path_of(key), std::ios::binary);
+    if (!file) return std::nullopt;
+
+    const auto read_part = [&]() -> std::optional<std::string> {
+        size_t size;
+        if (!(file >> size) || file.get() != '\n') return std::nullopt;
+
+        std::string part(size, '\0');
+        if (!file.read(part.data(), static_cast<std::streamsize>(size))) return std::nullopt;
+        return part;
+    };
+
+    std::optional<std::string> part_a = read_part();
+    std::optional<std::string> part_b = read_part();
+    if (!part_a || !part_b) return std::nullopt;
+
+    return Output(std::move(*part_a), std::move(*part_b));
+}
+
+void test::ResultCache::put(const Key & key, const Output & output) const {
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+
+    // Written then renamed, so a concurrent reader never sees a partial file
+    const std::string path = path_of(key);
+    const std::string temporary = path + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+
+        file << output.part_a.size() << '\n' << output.part_a
+             << output.part_b.size() << '\n' << output.part_b;
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error) std::filesystem::remove(temporary, error);
+}
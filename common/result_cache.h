@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+struct Output;
+struct DayExtraInfo;
+
+namespace test {
+    /** An object file given to the link, and the hash of its content */
+    struct ObjectHash {
+        std::string_view path;
+        std::uint64_t hash;
+    };
+}
+
+/**
+ * The objects of the executable, relative to the object directory, sorted by
+ * path. They are hashed by the Makefile before the link, so the link time
+ * optimization does not change them. Weak: the executables built without the
+ * table, like the benchmarks, cache nothing.
+ */
+std::span<const test::ObjectHash> aoc_object_hashes() __attribute__((weak));
+
+namespace test {
+    /** 64 bits FNV-1a hash, to detect changes, not for security */
+    class ContentHash {
+        std::uint64_t m_value = 0xcbf29ce484222325ULL;
+
+    public:
+        ContentHash & add(std::string_view bytes);
+        ContentHash & add(std::uint64_t value);
+
+        [[nodiscard]] std::uint64_t value() const noexcept { return m_value; }
+    };
+
+    /**
+     * Outputs of the solvers, stored in one file per call in a directory.
+     *
+     * An output is identified by the day, the input given to the solver and
+     * the objects of the solver: the objects of the day, and every object
+     * that is not the one of another day (common/, util/, main.o...).
+     * Changing a day only invalidates its outputs. Nothing is cached when
+     * the object of the day is not found.
+     */
+    class ResultCache {
+    public:
+        struct Key {
+            int year;
+            int day;
+            std::uint64_t input_hash;
+            std::uint64_t solver_hash;
+        };
+
+    private:
+        std::string m_directory;
+
+        mutable std::mutex m_mutex;
+        mutable std::map<std::pair<int, int>, std::optional<std::uint64_t>> m_solver_hashes;
+
+        [[nodiscard]] std::string path_of(const Key & key) const;
+
+    public:
+        explicit ResultCache(std::string directory);
+
+        /** Hash of the objects of the solver of the day, year being 0 in the executable of a year. nullopt if they are not found */
+        [[nodiscard]] std::optional<std::uint64_t> solver_hash(int year, int day) const;
+
+        /** Hash of the lines given to the solver and the parameters of the call */
+        [[nodiscard]] static std::uint64_t input_hash(std::span<const std::string_view> lines, const DayExtraInfo & dei);
+
+        [[nodiscard]] std::optional<Output> get(const Key & key) const;
+        void put(const Key & key, const Output & output) const;
+    };
+}
@@ -0,0 +1,347 @@
+#include "sampling_profiler.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <elf.h>
+#include <execinfo.h>
+#include <link.h>
+#include <unistd.h>
+#define AOC_HAS_SAMPLING_PROFILER 1
+#else
+#define AOC_HAS_SAMPLING_PROFILER 0
+#endif
+
+namespace {
+    constexpr size_t max_frames = 64;
+    constexpr size_t max_samples = 1 << 15;
+    constexpr long sampling_period_ns = 1'000'000;
+
+    // The handler and the signal trampoline
+    constexpr size_t skipped_frames = 2;
+
+    struct Sample {
+        int depth;
+        std::array<void *, max_frames> frames;
+    };
+}
+
+struct test::SamplingProfiler::Buffer {
+    std::vector<Sample> samples = std::vector<Sample>(max_samples);
+    /** Only modified by the signal handler, which runs on the profiled thread */
+    size_t size = 0;
+    std::uint64_t dropped = 0;
+
+#if AOC_HAS_SAMPLING_PROFILER
+    timer_t timer {};
+    bool has_timer = false;
+#endif
+};
+
+void test::add_stacks(FoldedStacks & total, const FoldedStacks & stacks) {
+    for (const auto & [stack, count] : stacks) {
+        total[stack] += count;
+    }
+}
+
+void test::write_folded_stacks(std::ostream & stream, const FoldedStacks & stacks) {
+    for (const auto & [stack, count] : stacks) {
+        stream << stack << ' ' << count << '\n';
+    }
+}
+
+#if AOC_HAS_SAMPLING_PROFILER
+
+namespace {
+    // The buffer of the profiler that is running on this thread
+    thread_local test::SamplingProfiler::Buffer * volatile current_buffer = nullptr;
+
+    void on_sigprof(int, siginfo_t *, void *) {
+        test::SamplingProfiler::Buffer * const buffer = current_buffer;
+        if (!buffer) return;
+
+        const int saved_errno = errno;
+
+        if (buffer->size == buffer->samples.size()) {
+            ++buffer->dropped;
+        } else {
+            Sample & sample = buffer->samples[buffer->size];
+            sample.depth = ::backtrace(sample.frames.data(), static_cast<int>(max_frames));
+            ++buffer->size;
+        }
+
+        errno = saved_errno;
+    }
+
+    bool install_handler() {
+        static const bool installed = []() {
+            // backtrace loads libgcc on its first call, which can not be done in a signal handler
+            void * warm_up[1];
+            ::backtrace(warm_up, 1);
+
+            struct sigaction action {};
+            action.sa_sigaction = &on_sigprof;
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+            return ::sigaction(SIGPROF, &action, nullptr) == 0;
+        }();
+
+        return installed;
+    }
+
+    /** The functions of the executable, read from its ELF symbol table */
+    class Symbolizer {
+        struct Symbol {
+            std::uintptr_t start;
+            std::uintptr_t size;
+            std::string name;
+        };
+
+        std::vector<Symbol> m_symbols;
+
+        mutable std::mutex m_mutex;
+        mutable std::unordered_map<std::uintptr_t, std::string> m_outside_names;
+
+        static std::string demangle(const char * name) {
+            int status = 0;
+            char * demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+            if (status != 0 || !demangled) return name;
+
+            std::string result = demangled;
+            std::free(demangled);
+            return result;
+        }
+
+        static std::uintptr_t load_bias() {
+            std::uintptr_t bias = 0;
+
+            // The first object is the executable
+            ::dl_iterate_phdr([](dl_phdr_info * info, size_t, void * data) {
+                *static_cast<std::uintptr_t *>(data) = info->dlpi_addr;
+                return 1;
+            }, &bias);
+
+            return bias;
+        }
+
+        void read_symbol_table() {
+            std::ifstream file("/proc/self/exe", std::ios::binary);
+            const std::string elf { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+            if (elf.size() < sizeof(Elf64_Ehdr) || std::memcmp(elf.data(), ELFMAG, SELFMAG) != 0) return;
+
+            Elf64_Ehdr header;
+            std::memcpy(&header, elf.data(), sizeof(header));
+            if (header.e_ident[EI_CLASS] != ELFCLASS64) return;
+            if (header.e_shoff + header.e_shnum * sizeof(Elf64_Shdr) > elf.size()) return;
+
+            std::vector<Elf64_Shdr> sections(header.e_shnum);
+            std::memcpy(sections.data(), elf.data() + header.e_shoff, header.e_shnum * sizeof(Elf64_Shdr));
+
+            // .symtab has every function, .dynsym only the exported ones of a stripped executable
+            const auto find_table = [&](Elf64_Word type) {
+                return std::find_if(sections.begin(), sections.end(), [&](const Elf64_Shdr & section) {
+                    return section.sh_type == type;
+                });
+            };
+
+            auto table = find_table(SHT_SYMTAB);
+            if (table == sections.end()) table = find_table(SHT_DYNSYM);
+            if (table == sections.end() || table->sh_link >= sections.size()) return;
+
+            const Elf64_Shdr & strings = sections[table->sh_link];
+            if (table->sh_offset + table->sh_size > elf.size() || strings.sh_offset + strings.sh_size > elf.size()) return;
+
+            const std::uintptr_t bias = load_bias();
+
+            for (size_t offset = 0; offset + sizeof(Elf64_Sym) <= table->sh_size; offset += sizeof(Elf64_Sym)) {
+                Elf64_Sym symbol;
+                std::memcpy(&symbol, elf.data() + table->sh_offset + offset, sizeof(symbol));
+
+                if (ELF64_ST_TYPE(symbol.st_info) != STT_FUNC || symbol.st_value == 0) continue;
+                if (symbol.st_name >= strings.sh_size) continue;
+
+                m_symbols.emplace_back(Symbol {
+                    .start = static_cast<std::uintptr_t>(symbol.st_value) + bias,
+                    .size = static_cast<std::uintptr_t>(symbol.st_size),
+                    .name = demangle(elf.data() + strings.sh_offset + symbol.st_name)
+                });
+            }
+
+            std::sort(m_symbols.begin(), m_symbols.end(),
+                [](const Symbol & lhs, const Symbol & rhs) { return lhs.start < rhs.start; }
+            );
+        }
+
+    public:
+        Symbolizer() { read_symbol_table(); }
+
+        static const Symbolizer & instance() {
+            static const Symbolizer symbolizer;
+            return symbolizer;
+        }
+
+        /** The symbol of the executable that contains the address, nullptr if there is none */
+        [[nodiscard]] const Symbol * find(std::uintptr_t address) const {
+            auto it = std::upper_bound(m_symbols.begin(), m_symbols.end(), address,
+                [](std::uintptr_t lhs, const Symbol & rhs) { return lhs < rhs.start; }
+            );
+            if (it == m_symbols.begin()) return nullptr;
+            --it;
+
+            // Symbols without size, like _fini, do not tell where they end
+            if (address >= it->start + std::max<std::uintptr_t>(it->size, 1)) return nullptr;
+            return &*it;
+        }
+
+        /** The address of the function that contains the address, 0 if unknown */
+        [[nodiscard]] std::uintptr_t start_of(std::uintptr_t address) const {
+            const Symbol * symbol = find(address);
+            return symbol ? symbol->start : 0;
+        }
+
+        /** Functions outside of the executable are found in the shared libraries */
+        [[nodiscard]] std::string name_of(std::uintptr_t address) const {
+            if (const Symbol * symbol = find(address)) return symbol->name;
+
+            std::lock_guard lock(m_mutex);
+            const auto it = m_outside_names.find(address);
+            if (it != m_outside_names.end()) return it->second;
+
+            std::string name;
+            Dl_info info;
+            if (::dladdr(reinterpret_cast<void *>(address), &info) != 0 && info.dli_sname) {
+                name = demangle(info.dli_sname);
+            } else if (::dladdr(reinterpret_cast<void *>(address), &info) != 0 && info.dli_fname) {
+                const std::string_view library = info.dli_fname;
+                name = "[" + std::string(library.substr(library.find_last_of('/') + 1)) + "]";
+            } else {
+                name = "[unknown]";
+            }
+
+            m_outside_names.emplace(address, name);
+            return name;
+        }
+    };
+}
+
+namespace {
+    /** A timer on the CPU time of the calling thread, that sends SIGPROF to it */
+    bool create_timer(timer_t & timer) {
+        if (!install_handler()) return false;
+
+        sigevent event {};
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SIGPROF;
+        event._sigev_un._tid = ::gettid();
+
+        return ::timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) == 0;
+    }
+}
+
+test::SamplingProfiler::SamplingProfiler(std::uintptr_t root)
+: m_buffer(std::make_unique<Buffer>()), m_root(root) {
+    m_buffer->has_timer = create_timer(m_buffer->timer);
+}
+
+test::SamplingProfiler::~SamplingProfiler() {
+    stop();
+    if (m_buffer->has_timer) ::timer_delete(m_buffer->timer);
+}
+
+bool test::SamplingProfiler::is_available() {
+    timer_t timer;
+    if (!create_timer(timer)) return false;
+
+    ::timer_delete(timer);
+    return true;
+}
+
+void test::SamplingProfiler::start() {
+    if (!m_buffer->has_timer) return;
+
+    current_buffer = m_buffer.get();
+
+    itimerspec period {};
+    period.it_interval.tv_nsec = sampling_period_ns;
+    period.it_value.tv_nsec = sampling_period_ns;
+    ::timer_settime(m_buffer->timer, 0, &period, nullptr);
+}
+
+void test::SamplingProfiler::stop() {
+    if (!m_buffer->has_timer) return;
+
+    const itimerspec disarmed {};
+    ::timer_settime(m_buffer->timer, 0, &disarmed, nullptr);
+
+    // A signal sent before the timer was disarmed may still be delivered
+    current_buffer = nullptr;
+}
+
+test::FoldedStacks test::SamplingProfiler::folded_stacks() const {
+    const Symbolizer & symbolizer = Symbolizer::instance();
+
+    FoldedStacks stacks;
+    std::string stack;
+
+    for (size_t i = 0; i != m_buffer->size; ++i) {
+        const Sample & sample = m_buffer->samples[i];
+        const size_t depth = static_cast<size_t>(sample.depth);
+        if (depth <= skipped_frames) continue;
+
+        // The first frame is where the thread was interrupted, the other
+        // ones are return addresses, that can be right after the function
+        const auto address_of = [&](size_t frame) {
+            const auto address = reinterpret_cast<std::uintptr_t>(sample.frames[frame]);
+            return frame == skipped_frames ? address : address - 1;
+        };
+
+        size_t outermost = depth - 1;
+        for (size_t frame = skipped_frames; frame != depth; ++frame) {
+            if (m_root != 0 && symbolizer.start_of(address_of(frame)) == m_root) {
+                outermost = frame;
+            }
+        }
+
+        stack.clear();
+        for (size_t frame = outermost + 1; frame-- != skipped_frames;) {
+            if (!stack.empty()) stack += ';';
+            stack += symbolizer.name_of(address_of(frame));
+        }
+
+        ++stacks[stack];
+    }
+
+    if (m_buffer->dropped != 0) {
+        stacks["[samples dropped, the buffer was full]"] += m_buffer->dropped;
+    }
+
+    return stacks;
+}
+
+std::uint64_t test::SamplingProfiler::dropped_samples() const {
+    return m_buffer->dropped;
+}
+
+#else
+
+test::SamplingProfiler::SamplingProfiler(std::uintptr_t root) : m_buffer(std::make_unique<Buffer>()), m_root(root) {}
+test::SamplingProfiler::~SamplingProfiler() = default;
+bool test::SamplingProfiler::is_available() { return false; }
+void test::SamplingProfiler::start() {}
+void test::SamplingProfiler::stop() {}
+test::FoldedStacks test::SamplingProfiler::folded_stacks() const { return {}; }
+std::uint64_t test::SamplingProfiler::dropped_samples() const { return 0; }
+
+#endif
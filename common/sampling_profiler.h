@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace test {
+    /** Folded stacks ("outer;inner;leaf") -> number of samples */
+    using FoldedStacks = std::map<std::string, std::uint64_t>;
+
+    /**
+     * Samples the call stack of the thread that created the profiler, every
+     * millisecond of CPU time it uses between `start` and `stop`.
+     *
+     * A timer on the CPU clock of the thread sends SIGPROF to it, and the
+     * handler stores the return addresses in a preallocated buffer. The
+     * addresses are symbolized afterwards with the symbol table of the
+     * executable. Only available on Linux. Threads started by the solver
+     * and inlined functions are not seen.
+     */
+    class SamplingProfiler {
+    public:
+        struct Buffer;
+
+    private:
+        std::unique_ptr<Buffer> m_buffer;
+        std::uintptr_t m_root;
+
+    public:
+        /**
+         * `root` is the address of the function whose calls are profiled. The
+         * frames above it, the ones of the harness, are removed from the stacks.
+         */
+        explicit SamplingProfiler(std::uintptr_t root);
+        ~SamplingProfiler();
+
+        SamplingProfiler(const SamplingProfiler &) = delete;
+        SamplingProfiler & operator=(const SamplingProfiler &) = delete;
+
+        /** False if the timer can not be created */
+        [[nodiscard]] static bool is_available();
+
+        void start();
+        void stop();
+
+        [[nodiscard]] FoldedStacks folded_stacks() const;
+        /** Samples that did not fit in the buffer */
+        [[nodiscard]] std::uint64_t dropped_samples() const;
+    };
+
+    /** Adds the samples of `stacks` to `total` */
+    void add_stacks(FoldedStacks & total, const FoldedStacks & stacks);
+
+    /** One "stack count" line per stack, as read by flamegraph.pl, inferno or speedscope */
+    void write_folded_stacks(std::ostream & stream, const FoldedStacks & stacks);
+}
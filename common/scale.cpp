@@ -0,0 +1,133 @@
+#include "scale.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <random>
+
+std::vector<std::string> test::tile_grid(std::span<const std::string_view> grid, unsigned int factor) {
+    unsigned int rows = 1;
+    for (unsigned int i = 1; i * i <= factor; ++i) {
+        if (factor % i == 0) rows = i;
+    }
+    const unsigned int columns = factor / rows;
+
+    std::vector<std::string> tiled;
+    tiled.reserve(grid.size() * rows);
+
+    for (unsigned int row = 0; row != rows; ++row) {
+        for (const std::string_view line : grid) {
+            std::string tiled_line;
+            tiled_line.reserve(line.size() * columns);
+            for (unsigned int column = 0; column != columns; ++column) {
+                tiled_line += line;
+            }
+            tiled.emplace_back(std::move(tiled_line));
+        }
+    }
+
+    return tiled;
+}
+
+namespace {
+    /** The numbers of a line, with their position */
+    struct NumberInLine {
+        size_t begin;
+        size_t end;
+        long long int value;
+    };
+
+    std::vector<NumberInLine> find_numbers(std::string_view line) {
+        std::vector<NumberInLine> numbers;
+
+        size_t i = 0;
+        while (i != line.size()) {
+            const bool negative = line[i] == '-' && i + 1 != line.size() && std::isdigit(static_cast<unsigned char>(line[i + 1]));
+            if (!negative && !std::isdigit(static_cast<unsigned char>(line[i]))) {
+                ++i;
+                continue;
+            }
+
+            const size_t begin = i;
+            if (negative) ++i;
+
+            long long int value = 0;
+            while (i != line.size() && std::isdigit(static_cast<unsigned char>(line[i]))) {
+                value = value * 10 + (line[i] - '0');
+                ++i;
+            }
+
+            numbers.push_back(NumberInLine{ begin, i, negative ? -value : value });
+        }
+
+        return numbers;
+    }
+}
+
+std::vector<std::string> test::lines_like(std::span<const std::string_view> input, unsigned int factor, std::uint64_t seed) {
+    std::vector<std::string> generated;
+    if (input.empty()) return generated;
+
+    // Range of the i-th number of the lines
+    std::vector<std::pair<long long int, long long int>> ranges;
+    for (const std::string_view line : input) {
+        const std::vector<NumberInLine> numbers = find_numbers(line);
+        for (size_t i = 0; i != numbers.size(); ++i) {
+            if (i == ranges.size()) {
+                ranges.emplace_back(numbers[i].value, numbers[i].value);
+            } else {
+                ranges[i].first  = std::min(ranges[i].first , numbers[i].value);
+                ranges[i].second = std::max(ranges[i].second, numbers[i].value);
+            }
+        }
+    }
+
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<size_t> pick_line(0, input.size() - 1);
+
+    generated.reserve(input.size() * factor);
+    for (size_t n = 0; n != input.size() * factor; ++n) {
+        const std::string_view model = input[pick_line(random)];
+
+        std::string line;
+        size_t copied_until = 0;
+
+        const std::vector<NumberInLine> numbers = find_numbers(model);
+        for (size_t i = 0; i != numbers.size(); ++i) {
+            std::uniform_int_distribution<long long int> pick_value(ranges[i].first, ranges[i].second);
+            line += model.substr(copied_until, numbers[i].begin - copied_until);
+            line += std::to_string(pick_value(random));
+            copied_until = numbers[i].end;
+        }
+
+        line += model.substr(copied_until);
+        generated.emplace_back(std::move(line));
+    }
+
+    return generated;
+}
+
+double test::fit_exponent(std::span<const std::pair<unsigned int, std::chrono::nanoseconds>> points) {
+    if (points.size() < 2) return std::numeric_limits<double>::quiet_NaN();
+
+    double mean_x = 0.;
+    double mean_y = 0.;
+    for (const auto & [factor, duration] : points) {
+        mean_x += std::log(static_cast<double>(factor));
+        mean_y += std::log(std::max(1.0, static_cast<double>(duration.count())));
+    }
+    mean_x /= static_cast<double>(points.size());
+    mean_y /= static_cast<double>(points.size());
+
+    double covariance = 0.;
+    double variance = 0.;
+    for (const auto & [factor, duration] : points) {
+        const double x = std::log(static_cast<double>(factor)) - mean_x;
+        const double y = std::log(std::max(1.0, static_cast<double>(duration.count()))) - mean_y;
+        covariance += x * y;
+        variance += x * x;
+    }
+
+    if (variance == 0.) return std::numeric_limits<double>::quiet_NaN();
+    return covariance / variance;
+}
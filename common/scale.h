@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Helpers to write the generators of larger inputs of `--scale`
+namespace test {
+    /** Repeats the grid into about `factor` tiles, arranged as square as possible */
+    std::vector<std::string> tile_grid(std::span<const std::string_view> grid, unsigned int factor);
+
+    /**
+     * Generates `factor` times more lines. Each line is a random line of the
+     * input whose numbers are replaced by random numbers, the i-th number
+     * being drawn between the min and the max of the i-th numbers of the input.
+     */
+    std::vector<std::string> lines_like(std::span<const std::string_view> input, unsigned int factor, std::uint64_t seed);
+
+    /**
+     * Least squares fit of duration = c * factor^k, returns k.
+     * 1 = linear, 2 = quadratic...
+     */
+    double fit_exponent(std::span<const std::pair<unsigned int, std::chrono::nanoseconds>> points);
+}
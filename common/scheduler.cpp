@@ -0,0 +1,100 @@
+#include "scheduler.h"
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace {
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<test::WorkStealingPool::Job> jobs;
+    };
+
+    std::optional<test::WorkStealingPool::Job> pop_own(WorkerQueue & queue) {
+        std::lock_guard lock(queue.mutex);
+        if (queue.jobs.empty()) return std::nullopt;
+        auto job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return job;
+    }
+
+    std::optional<test::WorkStealingPool::Job> steal(WorkerQueue & queue) {
+        std::lock_guard lock(queue.mutex);
+        if (queue.jobs.empty()) return std::nullopt;
+        auto job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        return job;
+    }
+}
+
+void test::WorkStealingPool::run(std::vector<Job> jobs) const {
+    const size_t nb_of_workers = std::min<size_t>(m_workers, jobs.size());
+    if (nb_of_workers == 0) return;
+
+    std::vector<WorkerQueue> queues(nb_of_workers);
+    for (size_t i = 0; i != jobs.size(); ++i) {
+        queues[i % nb_of_workers].jobs.emplace_back(std::move(jobs[i]));
+    }
+
+    // Jobs are never added after this point, so a worker that finds every
+    // deque empty can stop.
+    const auto worker = [&](size_t self) {
+        while (true) {
+            std::optional<Job> job = pop_own(queues[self]);
+
+            for (size_t offset = 1; !job && offset != nb_of_workers; ++offset) {
+                job = steal(queues[(self + offset) % nb_of_workers]);
+            }
+
+            if (!job) return;
+
+            (*job)();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nb_of_workers; ++i) {
+        threads.emplace_back(worker, i);
+    }
+
+    worker(0);
+
+    for (std::thread & thread : threads) {
+        thread.join();
+    }
+}
+
+test::RecordedTimings::RecordedTimings(std::string path) : m_path(std::move(path)) {
+    std::ifstream file(m_path);
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        int day;
+        std::string filename;
+        double seconds;
+        if (stream >> day >> filename >> seconds) {
+            m_seconds[std::pair(day, filename)] = seconds;
+        }
+    }
+}
+
+std::optional<double> test::RecordedTimings::get(int day, const std::string & filename) const {
+    const auto it = m_seconds.find(std::pair(day, filename));
+    if (it == m_seconds.end()) return std::nullopt;
+    return it->second;
+}
+
+void test::RecordedTimings::set(int day, const std::string & filename, double seconds) {
+    m_seconds[std::pair(day, filename)] = seconds;
+}
+
+void test::RecordedTimings::save() const {
+    std::ofstream file(m_path);
+
+    for (const auto & [key, seconds] : m_seconds) {
+        file << key.first << ' ' << key.second << ' ' << seconds << '\n';
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace test {
+    /**
+     * A pool of workers that each own a deque of jobs.
+     *
+     * A worker takes jobs from the front of its own deque, and steals from the
+     * back of the deques of the other workers once its own deque is empty.
+     */
+    class WorkStealingPool {
+    public:
+        using Job = std::function<void()>;
+
+    private:
+        unsigned int m_workers;
+
+    public:
+        explicit WorkStealingPool(unsigned int workers) : m_workers(workers == 0 ? 1 : workers) {}
+
+        /**
+         * Runs all the jobs and returns when they are all done.
+         *
+         * Jobs are dealt in the given order, so callers should put the
+         * longest jobs first.
+         */
+        void run(std::vector<Job> jobs) const;
+    };
+
+    /**
+     * Durations of the previous runs of each config, stored in a file so the
+     * scheduler can start the longest jobs first.
+     */
+    class RecordedTimings {
+        std::string m_path;
+        std::map<std::pair<int, std::string>, double> m_seconds;
+
+    public:
+        explicit RecordedTimings(std::string path);
+
+        [[nodiscard]] std::optional<double> get(int day, const std::string & filename) const;
+        void set(int day, const std::string & filename, double seconds);
+        void save() const;
+    };
+}
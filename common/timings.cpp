@@ -0,0 +1,77 @@
+#include "advent_of_code.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+test::TimingDistribution::TimingDistribution(std::vector<std::chrono::nanoseconds> samples)
+: m_samples(std::move(samples)) {}
+
+std::chrono::nanoseconds test::TimingDistribution::min() const {
+    if (m_samples.empty()) return std::chrono::nanoseconds(0);
+    return *std::min_element(m_samples.begin(), m_samples.end());
+}
+
+std::chrono::nanoseconds test::TimingDistribution::median() const {
+    return percentile(0.5);
+}
+
+std::chrono::nanoseconds test::TimingDistribution::p90() const {
+    return percentile(0.9);
+}
+
+std::chrono::nanoseconds test::TimingDistribution::percentile(double ratio) const {
+    if (m_samples.empty()) return std::chrono::nanoseconds(0);
+
+    std::vector<std::chrono::nanoseconds> sorted = m_samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    // Nearest rank
+    const size_t rank = static_cast<size_t>(std::ceil(ratio * sorted.size()));
+    return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+std::chrono::nanoseconds test::TimingDistribution::stddev() const {
+    if (m_samples.size() < 2) return std::chrono::nanoseconds(0);
+
+    double mean = 0.;
+    for (const auto sample : m_samples) mean += static_cast<double>(sample.count());
+    mean /= m_samples.size();
+
+    double variance = 0.;
+    for (const auto sample : m_samples) {
+        const double delta = static_cast<double>(sample.count()) - mean;
+        variance += delta * delta;
+    }
+    variance /= (m_samples.size() - 1);
+
+    return std::chrono::nanoseconds(static_cast<long long int>(std::sqrt(variance)));
+}
+
+test::TimingDistribution & test::TimingDistribution::operator+=(const TimingDistribution & other) {
+    if (m_samples.size() < other.m_samples.size()) {
+        m_samples.resize(other.m_samples.size(), std::chrono::nanoseconds(0));
+    }
+
+    for (size_t i = 0; i != other.m_samples.size(); ++i) {
+        m_samples[i] += other.m_samples[i];
+    }
+
+    return *this;
+}
+
+std::string test::format_duration(std::chrono::nanoseconds duration) {
+    const double ns = static_cast<double>(duration.count());
+
+    char buffer[64];
+    if (ns < 1e3) {
+        std::sprintf(buffer, "%.0f ns", ns);
+    } else if (ns < 1e6) {
+        std::sprintf(buffer, "%.1f us", ns / 1e3);
+    } else if (ns < 1e9) {
+        std::sprintf(buffer, "%.1f ms", ns / 1e6);
+    } else {
+        std::sprintf(buffer, "%.2f s", ns / 1e9);
+    }
+
+    return buffer;
+}
@@ -0,0 +1,26 @@
+#include "../common/advent_of_code.hpp"
+
+// Defined by the list of days of each year, compiled with AOC_MULTI_YEAR
+std::array<DayEntry, 25> aoc_days_2015();
+std::array<DayEntry, 25> aoc_days_2016();
+std::array<DayEntry, 25> aoc_days_2017();
+std::array<DayEntry, 25> aoc_days_2018();
+std::array<DayEntry, 25> aoc_days_2019();
+std::array<DayEntry, 25> aoc_days_2020();
+std::array<DayEntry, 25> aoc_days_2021();
+std::array<DayEntry, 25> aoc_days_2022();
+std::array<DayEntry, 25> aoc_days_2023();
+std::array<DayEntry, 25> aoc_days_2024();
+std::array<DayEntry, 25> aoc_days_2025();
+
+static constexpr std::array<AocYear, 11> years {{
+    { 2015, &aoc_days_2015 }, { 2016, &aoc_days_2016 }, { 2017, &aoc_days_2017 },
+    { 2018, &aoc_days_2018 }, { 2019, &aoc_days_2019 }, { 2020, &aoc_days_2020 },
+    { 2021, &aoc_days_2021 }, { 2022, &aoc_days_2022 }, { 2023, &aoc_days_2023 },
+    { 2024, &aoc_days_2024 }, { 2025, &aoc_days_2025 }
+}};
+
+int main(int argc, const char * argv[]) {
+    run_aoc(years, argc, argv);
+    return 0;
+}
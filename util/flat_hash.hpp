@@ -0,0 +1,525 @@
+#pragma once
+
+#include "position.hpp"
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace bj {
+    /**
+     * Specialize packed_key<T> with a `static std::uint64_t pack(const T &)`
+     * to use small aggregates, like the states of a search, as keys of
+     * FlatSet and FlatMap: they are hashed and compared through their packed
+     * value, so the packing must give a different value to different keys.
+     */
+    template<typename T> struct packed_key;
+
+    template<typename T>
+    concept PackableKey = requires(const T & value) {
+        { packed_key<T>::pack(value) } -> std::same_as<std::uint64_t>;
+    };
+
+    /** Finalizer of MurmurHash3: every bit of the result depends on every bit of the value */
+    [[nodiscard]] constexpr std::uint64_t mix_bits(std::uint64_t value) noexcept {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+    template<> struct packed_key<Position> {
+        [[nodiscard]] static constexpr std::uint64_t pack(const Position & position) noexcept {
+            return (std::uint64_t(std::uint32_t(position.x)) << 32) | std::uint32_t(position.y);
+        }
+    };
+
+    /**
+     * The default hash of FlatSet and FlatMap. std::hash of the integers is
+     * the identity, so the bits are mixed: the low bits choose the group to
+     * probe and the high bits are compared during the probe.
+     */
+    template<typename T>
+    struct flat_hash {
+        [[nodiscard]] std::size_t operator()(const T & value) const {
+            if constexpr (PackableKey<T>) {
+                return static_cast<std::size_t>(mix_bits(packed_key<T>::pack(value)));
+            } else {
+                return static_cast<std::size_t>(mix_bits(std::hash<T>{}(value)));
+            }
+        }
+    };
+
+    template<typename T>
+    struct flat_equal {
+        [[nodiscard]] bool operator()(const T & lhs, const T & rhs) const {
+            if constexpr (std::equality_comparable<T>) {
+                return lhs == rhs;
+            } else {
+                return packed_key<T>::pack(lhs) == packed_key<T>::pack(rhs);
+            }
+        }
+    };
+
+    namespace flat_hash_details {
+        /**
+         * One byte per slot: the 7 low bits of the hash of the element if
+         * the slot is full, a negative value if it is free.
+         */
+        using Control = std::int8_t;
+        inline constexpr Control empty_slot = -128;
+        inline constexpr Control deleted_slot = -2;
+
+        inline constexpr std::size_t group_size = 16;
+
+        /** The control bytes of 16 consecutive slots. The matches are bitmasks, bit i for the slot i */
+        class Group {
+#if defined(__SSE2__)
+            __m128i m_controls;
+
+        public:
+            explicit Group(const Control * controls) noexcept
+            : m_controls(_mm_loadu_si128(reinterpret_cast<const __m128i *>(controls))) {}
+
+            [[nodiscard]] std::uint32_t match(Control control) const noexcept {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(control), m_controls)));
+            }
+
+            /** Empty and deleted are the only controls with the sign bit */
+            [[nodiscard]] std::uint32_t match_free() const noexcept {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(m_controls));
+            }
+#else
+            const Control * m_controls;
+
+        public:
+            explicit Group(const Control * controls) noexcept : m_controls(controls) {}
+
+            [[nodiscard]] std::uint32_t match(Control control) const noexcept {
+                std::uint32_t matches = 0;
+                for (std::size_t i = 0; i != group_size; ++i) {
+                    if (m_controls[i] == control) matches |= std::uint32_t(1) << i;
+                }
+                return matches;
+            }
+
+            [[nodiscard]] std::uint32_t match_free() const noexcept {
+                std::uint32_t matches = 0;
+                for (std::size_t i = 0; i != group_size; ++i) {
+                    if (m_controls[i] < 0) matches |= std::uint32_t(1) << i;
+                }
+                return matches;
+            }
+#endif
+
+            [[nodiscard]] std::uint32_t match_empty() const noexcept { return match(empty_slot); }
+        };
+
+        struct Identity {
+            template<typename T>
+            [[nodiscard]] const T & operator()(const T & value) const noexcept { return value; }
+        };
+
+        struct First {
+            template<typename Pair>
+            [[nodiscard]] const auto & operator()(const Pair & pair) const noexcept { return pair.first; }
+        };
+
+        /**
+         * Open addressing hash table, with the elements stored in one array
+         * of slots. The slots are probed by groups of 16, whose control bytes
+         * are compared to the hash with one SIMD instruction. The groups are
+         * probed in triangular order, that visits every group as the number
+         * of groups is a power of 2.
+         *
+         * An erased slot is marked deleted, so the probes of the other
+         * elements do not stop on it, unless its group has an empty slot.
+         * The table is rehashed when the full and deleted slots exceed 7/8
+         * of the slots.
+         */
+        template<typename Key, typename Value, typename KeyOf, typename Hash, typename Equal, bool MutableValues>
+        class FlatTable {
+            static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+            std::vector<Control> m_controls;
+            Value * m_slots = nullptr;
+            std::size_t m_size = 0;
+            std::size_t m_deleted = 0;
+            [[no_unique_address]] Hash m_hash;
+            [[no_unique_address]] Equal m_equal;
+
+            template<bool Const>
+            class Iterator {
+                friend class FlatTable;
+                template<bool> friend class Iterator;
+                using Table = std::conditional_t<Const, const FlatTable, FlatTable>;
+
+                Table * m_table = nullptr;
+                std::size_t m_index = 0;
+
+                Iterator(Table * table, std::size_t index) noexcept : m_table(table), m_index(index) {}
+
+                void skip_free_slots() noexcept {
+                    while (m_index != m_table->capacity() && m_table->m_controls[m_index] < 0) ++m_index;
+                }
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Value;
+                using difference_type = std::ptrdiff_t;
+                using pointer = std::conditional_t<Const, const Value *, Value *>;
+                using reference = std::conditional_t<Const, const Value &, Value &>;
+
+                Iterator() = default;
+
+                operator Iterator<true>() const noexcept requires (!Const) {
+                    return Iterator<true>(m_table, m_index);
+                }
+
+                [[nodiscard]] reference operator*() const noexcept { return m_table->m_slots[m_index]; }
+                [[nodiscard]] pointer operator->() const noexcept { return m_table->m_slots + m_index; }
+
+                Iterator & operator++() noexcept {
+                    ++m_index;
+                    skip_free_slots();
+                    return *this;
+                }
+
+                Iterator operator++(int) noexcept {
+                    Iterator copy = *this;
+                    ++*this;
+                    return copy;
+                }
+
+                [[nodiscard]] bool operator==(const Iterator & other) const noexcept {
+                    return m_index == other.m_index;
+                }
+            };
+
+        public:
+            using key_type = Key;
+            using value_type = Value;
+            using size_type = std::size_t;
+            using const_iterator = Iterator<true>;
+            using iterator = std::conditional_t<MutableValues, Iterator<false>, Iterator<true>>;
+
+        private:
+            [[nodiscard]] static std::size_t max_load(std::size_t capacity) noexcept {
+                return capacity - capacity / 8;
+            }
+
+            [[nodiscard]] static Control control_of(std::size_t hash) noexcept {
+                return static_cast<Control>(hash & 0x7F);
+            }
+
+            /** Calls on_group(first_slot) on the groups of the probe of the hash, until it returns true */
+            template<typename OnGroup>
+            static void probe(std::size_t capacity, std::size_t hash, OnGroup on_group) {
+                const std::size_t group_mask = capacity / group_size - 1;
+                std::size_t group = (hash >> 7) & group_mask;
+                for (std::size_t step = 1; !on_group(group * group_size); ++step) {
+                    group = (group + step) & group_mask;
+                }
+            }
+
+            [[nodiscard]] static std::size_t find_free_slot(const std::vector<Control> & controls, std::size_t hash) {
+                std::size_t found = npos;
+                probe(controls.size(), hash, [&](std::size_t first) {
+                    const std::uint32_t free = Group(controls.data() + first).match_free();
+                    if (free == 0) return false;
+                    found = first + static_cast<std::size_t>(std::countr_zero(free));
+                    return true;
+                });
+                return found;
+            }
+
+            [[nodiscard]] std::size_t find_index(const Key & key, std::size_t hash) const {
+                if (m_size == 0) return npos;
+
+                std::size_t found = npos;
+                probe(capacity(), hash, [&](std::size_t first) {
+                    const Group group(m_controls.data() + first);
+                    for (std::uint32_t matches = group.match(control_of(hash)); matches != 0; matches &= matches - 1) {
+                        const std::size_t index = first + static_cast<std::size_t>(std::countr_zero(matches));
+                        if (m_equal(KeyOf{}(m_slots[index]), key)) {
+                            found = index;
+                            return true;
+                        }
+                    }
+                    return group.match_empty() != 0;
+                });
+                return found;
+            }
+
+            void rehash(std::size_t new_capacity) {
+                std::vector<Control> controls(new_capacity, empty_slot);
+                Value * const slots = std::allocator<Value>().allocate(new_capacity);
+
+                for (std::size_t i = 0; i != capacity(); ++i) {
+                    if (m_controls[i] < 0) continue;
+
+                    const std::size_t hash = m_hash(KeyOf{}(m_slots[i]));
+                    const std::size_t index = find_free_slot(controls, hash);
+                    std::construct_at(slots + index, std::move(m_slots[i]));
+                    std::destroy_at(m_slots + i);
+                    controls[index] = control_of(hash);
+                }
+
+                if (m_slots) std::allocator<Value>().deallocate(m_slots, capacity());
+                m_controls = std::move(controls);
+                m_slots = slots;
+                m_deleted = 0;
+            }
+
+            [[nodiscard]] static std::size_t capacity_for(std::size_t size) noexcept {
+                std::size_t capacity = group_size;
+                while (max_load(capacity) < size) capacity *= 2;
+                return capacity;
+            }
+
+        protected:
+            /** Constructs the value from the arguments if no element has the key */
+            template<typename... Args>
+            std::pair<iterator, bool> emplace_with_key(const Key & key, Args &&... args) {
+                const std::size_t hash = m_hash(key);
+                if (const std::size_t index = find_index(key, hash); index != npos) {
+                    return { iterator(this, index), false };
+                }
+
+                if (m_size + m_deleted + 1 > max_load(capacity())) {
+                    // Grow if the elements use half of the slots, else only remove the deleted slots
+                    rehash(std::max(capacity_for(m_size + 1), m_size * 2 >= max_load(capacity()) ? capacity() * 2 : capacity()));
+                }
+
+                const std::size_t index = find_free_slot(m_controls, hash);
+                std::construct_at(m_slots + index, std::forward<Args>(args)...);
+                if (m_controls[index] == deleted_slot) --m_deleted;
+                m_controls[index] = control_of(hash);
+                ++m_size;
+                return { iterator(this, index), true };
+            }
+
+            [[nodiscard]] Value * find_value(const Key & key) const {
+                const std::size_t index = find_index(key, m_hash(key));
+                return index == npos ? nullptr : m_slots + index;
+            }
+
+        public:
+            FlatTable() = default;
+
+            FlatTable(const FlatTable & other)
+            : m_controls(other.m_controls), m_size(other.m_size), m_deleted(other.m_deleted),
+              m_hash(other.m_hash), m_equal(other.m_equal) {
+                if (other.m_slots == nullptr) return;
+
+                m_slots = std::allocator<Value>().allocate(capacity());
+                for (std::size_t i = 0; i != capacity(); ++i) {
+                    if (m_controls[i] >= 0) std::construct_at(m_slots + i, other.m_slots[i]);
+                }
+            }
+
+            FlatTable(FlatTable && other) noexcept
+            : m_controls(std::move(other.m_controls)),
+              m_slots(std::exchange(other.m_slots, nullptr)),
+              m_size(std::exchange(other.m_size, 0)),
+              m_deleted(std::exchange(other.m_deleted, 0)),
+              m_hash(std::move(other.m_hash)), m_equal(std::move(other.m_equal)) {
+                other.m_controls.clear();
+            }
+
+            FlatTable & operator=(FlatTable other) noexcept {
+                std::swap(m_controls, other.m_controls);
+                std::swap(m_slots, other.m_slots);
+                std::swap(m_size, other.m_size);
+                std::swap(m_deleted, other.m_deleted);
+                std::swap(m_hash, other.m_hash);
+                std::swap(m_equal, other.m_equal);
+                return *this;
+            }
+
+            ~FlatTable() {
+                clear();
+                if (m_slots) std::allocator<Value>().deallocate(m_slots, capacity());
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+            [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+            [[nodiscard]] std::size_t capacity() const noexcept { return m_controls.size(); }
+
+            /** Destroys the elements, the slots are kept */
+            void clear() noexcept {
+                for (std::size_t i = 0; i != capacity(); ++i) {
+                    if (m_controls[i] >= 0) std::destroy_at(m_slots + i);
+                    m_controls[i] = empty_slot;
+                }
+                m_size = 0;
+                m_deleted = 0;
+            }
+
+            /** Makes room for `size` elements without rehashing */
+            void reserve(std::size_t size) {
+                if (max_load(capacity()) - m_deleted < size) rehash(capacity_for(size));
+            }
+
+            [[nodiscard]] iterator begin() noexcept {
+                iterator it(this, 0);
+                if (capacity() != 0) it.skip_free_slots();
+                return it;
+            }
+
+            [[nodiscard]] const_iterator begin() const noexcept {
+                const_iterator it(this, 0);
+                if (capacity() != 0) it.skip_free_slots();
+                return it;
+            }
+
+            [[nodiscard]] iterator end() noexcept { return iterator(this, capacity()); }
+            [[nodiscard]] const_iterator end() const noexcept { return const_iterator(this, capacity()); }
+
+            [[nodiscard]] iterator find(const Key & key) {
+                const std::size_t index = find_index(key, m_hash(key));
+                return index == npos ? end() : iterator(this, index);
+            }
+
+            [[nodiscard]] const_iterator find(const Key & key) const {
+                const std::size_t index = find_index(key, m_hash(key));
+                return index == npos ? end() : const_iterator(this, index);
+            }
+
+            [[nodiscard]] bool contains(const Key & key) const { return find_index(key, m_hash(key)) != npos; }
+            [[nodiscard]] std::size_t count(const Key & key) const { return contains(key) ? 1 : 0; }
+
+            std::size_t erase(const Key & key) {
+                const std::size_t index = find_index(key, m_hash(key));
+                if (index == npos) return 0;
+
+                std::destroy_at(m_slots + index);
+                --m_size;
+
+                const std::size_t first = index / group_size * group_size;
+                if (Group(m_controls.data() + first).match_empty() != 0) {
+                    m_controls[index] = empty_slot;
+                } else {
+                    m_controls[index] = deleted_slot;
+                    ++m_deleted;
+                }
+
+                return 1;
+            }
+        };
+    }
+
+    /**
+     * A hash set that stores its elements in one array, to replace the
+     * std::set and std::unordered_set of the hot loops.
+     *
+     * The order of iteration is unspecified, and the iterators and references
+     * are invalidated by the insertions.
+     */
+    template<typename Key, typename Hash = flat_hash<Key>, typename Equal = flat_equal<Key>>
+    class FlatSet : public flat_hash_details::FlatTable<Key, Key, flat_hash_details::Identity, Hash, Equal, false> {
+        using Base = flat_hash_details::FlatTable<Key, Key, flat_hash_details::Identity, Hash, Equal, false>;
+
+    public:
+        using typename Base::iterator;
+
+        FlatSet() = default;
+
+        FlatSet(std::initializer_list<Key> keys) {
+            this->reserve(keys.size());
+            for (const Key & key : keys) insert(key);
+        }
+
+        std::pair<iterator, bool> insert(const Key & key) { return this->emplace_with_key(key, key); }
+        std::pair<iterator, bool> insert(Key && key) { return this->emplace_with_key(key, std::move(key)); }
+
+        template<std::input_iterator It, std::sentinel_for<It> Sentinel>
+        void insert(It first, Sentinel last) {
+            for (; first != last; ++first) insert(*first);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args &&... args) {
+            return insert(Key(std::forward<Args>(args)...));
+        }
+    };
+
+    /**
+     * A hash map that stores its elements in one array, to replace the
+     * std::map and std::unordered_map of the hot loops.
+     *
+     * The order of iteration is unspecified, and the iterators and references
+     * are invalidated by the insertions.
+     */
+    template<typename Key, typename T, typename Hash = flat_hash<Key>, typename Equal = flat_equal<Key>>
+    class FlatMap : public flat_hash_details::FlatTable<Key, std::pair<const Key, T>, flat_hash_details::First, Hash, Equal, true> {
+        using Base = flat_hash_details::FlatTable<Key, std::pair<const Key, T>, flat_hash_details::First, Hash, Equal, true>;
+
+    public:
+        using mapped_type = T;
+        using typename Base::iterator;
+        using typename Base::value_type;
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key & key, Args &&... args) {
+            return this->emplace_with_key(key,
+                std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...)
+            );
+        }
+
+        /** Like std::map::emplace(key, value): does nothing if the key is already present */
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(const Key & key, Args &&... args) {
+            return try_emplace(key, std::forward<Args>(args)...);
+        }
+
+        std::pair<iterator, bool> insert(const value_type & value) {
+            return this->emplace_with_key(value.first, value);
+        }
+
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(const Key & key, M && value) {
+            auto result = try_emplace(key, std::forward<M>(value));
+            if (!result.second) result.first->second = std::forward<M>(value);
+            return result;
+        }
+
+        T & operator[](const Key & key) { return try_emplace(key).first->second; }
+
+        [[nodiscard]] T & at(const Key & key) {
+            value_type * const value = this->find_value(key);
+            if (!value) throw std::out_of_range("bj::FlatMap::at");
+            return value->second;
+        }
+
+        [[nodiscard]] const T & at(const Key & key) const {
+            const value_type * const value = this->find_value(key);
+            if (!value) throw std::out_of_range("bj::FlatMap::at");
+            return value->second;
+        }
+    };
+}
+
+namespace std {
+    template<> struct hash<bj::Position> {
+        [[nodiscard]] std::size_t operator()(const bj::Position & position) const noexcept {
+            return static_cast<std::size_t>(bj::mix_bits(bj::packed_key<bj::Position>::pack(position)));
+        }
+    };
+}
@@ -1,9 +1,19 @@
-
 #pragma once
 
 #include "position.hpp"
-#include <set>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
 #include <map>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <utility>
+#include <vector>
 
 namespace bj {
     inline void print_game_of_life(const std::set<bj::Position> & position, int xMin, int xMax, int yMin, int yMax) {
@@ -19,8 +29,356 @@ namespace bj {
         }
     }
 
+    /** The mask of `birth` / `survival` of the dense rules: bit c is set for each count c */
+    [[nodiscard]] constexpr std::uint64_t neighbour_counts(std::initializer_list<int> counts) {
+        std::uint64_t mask = 0;
+        for (const int count : counts) {
+            mask |= std::uint64_t(1) << count;
+        }
+        return mask;
+    }
+
+    /** The 3^N - 1 offsets of the cells that touch a cell in N dimensions, by an edge or a corner */
+    template<size_t N>
+    [[nodiscard]] constexpr auto moore_neighbourhood() {
+        constexpr size_t cube = [] {
+            size_t size = 1;
+            for (size_t i = 0; i != N; ++i) size *= 3;
+            return size;
+        }();
+
+        std::array<std::array<int, N>, cube - 1> neighbourhood {};
+        size_t i = 0;
+        for (size_t code = 0; code != cube; ++code) {
+            std::array<int, N> offset {};
+            bool is_origin = true;
+            size_t digits = code;
+            for (size_t dimension = 0; dimension != N; ++dimension) {
+                offset[dimension] = static_cast<int>(digits % 3) - 1;
+                digits /= 3;
+                is_origin = is_origin && offset[dimension] == 0;
+            }
+
+            if (!is_origin) neighbourhood[i++] = offset;
+        }
+
+        return neighbourhood;
+    }
+
+    namespace game_of_life_details {
+        /** The elements supported by the dense engine, with their coordinates. The first one is x */
+        template<typename Element> struct Coordinates;
+
+        template<> struct Coordinates<bj::Position> {
+            static constexpr size_t dimensions = 2;
+            static std::array<int, 2> of(const bj::Position & position) { return { position.x, position.y }; }
+            static bj::Position to(const std::array<int, 2> & point) { return bj::Position{ point[0], point[1] }; }
+        };
+
+        template<size_t N> struct Coordinates<std::array<int, N>> {
+            static constexpr size_t dimensions = N;
+            static const std::array<int, N> & of(const std::array<int, N> & point) { return point; }
+            static const std::array<int, N> & to(const std::array<int, N> & point) { return point; }
+        };
+    }
+
+    /**
+     * Rules of the life-like automatons, whose next state only depends on the
+     * number of alive cells in a neighbourhood that is the same everywhere.
+     * On top of `Element` and `is_valid`, they declare:
+     * - `static constexpr std::uint64_t birth`: the counts of alive
+     * neighbours for which a dead cell becomes alive, see neighbour_counts
+     * - `static constexpr std::uint64_t survival`: the same for the alive cells
+     * - `static constexpr std::array<std::array<int, N>, K> neighbourhood`:
+     * the offsets of the neighbours, in [-1, 1]. See moore_neighbourhood.
+     *
+     * They can also declare `bool is_always_on(const Element &) const` for
+     * the cells that are alive whatever their neighbours are.
+     *
+     * The elements are bj::Position or std::array<int, N>.
+     */
+    template<typename Rules>
+    concept DenseRules = requires(const Rules & rules, const typename Rules::Element & element) {
+        { Rules::birth } -> std::convertible_to<std::uint64_t>;
+        { Rules::survival } -> std::convertible_to<std::uint64_t>;
+        { Rules::neighbourhood.size() } -> std::convertible_to<size_t>;
+        { rules.is_valid(element) } -> std::convertible_to<bool>;
+        { game_of_life_details::Coordinates<typename Rules::Element>::dimensions } -> std::convertible_to<size_t>;
+    };
+
+    /**
+     * A game of life on a box of the space that contains the alive cells,
+     * with one bit per cell. The cells of a row along x are packed in
+     * 64-bit words, so the neighbours of 64 cells are counted at once in
+     * bit-sliced counters: the counter bit k of the 64 cells is in the k-th
+     * word.
+     *
+     * The box always keeps a layer of dead cells around the alive ones, so the
+     * neighbours that are outside of it are dead. It grows when an alive
+     * cell reaches its border.
+     */
+    template<DenseRules Rules>
+    class DenseGameOfLife {
+    public:
+        using Element = typename Rules::Element;
+
+    private:
+        using Coordinates = game_of_life_details::Coordinates<Element>;
+        static constexpr size_t dimensions = Coordinates::dimensions;
+        using Point = std::array<int, dimensions>;
+        using Bounds = std::pair<Point, Point>;
+
+        static_assert(std::same_as<std::remove_cvref_t<decltype(Rules::neighbourhood[0])>, Point>,
+            "The offsets of the neighbourhood must have the dimensions of the elements");
+        static_assert((Rules::birth & 1) == 0, "The cells with no alive neighbour can not be born");
+
+        static constexpr size_t neighbours = Rules::neighbourhood.size();
+        static constexpr size_t counter_bits = std::bit_width(neighbours);
+        using Counter = std::array<std::uint64_t, counter_bits>;
+
+        static constexpr bool has_always_on = requires(const Rules & rules, const Element & element) {
+            { rules.is_always_on(element) } -> std::convertible_to<bool>;
+        };
+
+        Rules m_rules;
+        /** Coordinates of the first cell of the box, and its size in every dimension */
+        Point m_origin {};
+        Point m_size {};
+        size_t m_words_per_row = 0;
+        size_t m_rows = 0;
+        /** Row of each neighbour of the neighbourhood, relative to the row of the cell */
+        std::array<std::ptrdiff_t, neighbours> m_row_offsets {};
+
+        std::vector<std::uint64_t> m_alive;
+        std::vector<std::uint64_t> m_next;
+        /** The cells of the box that are valid for the rules */
+        std::vector<std::uint64_t> m_valid;
+        std::vector<std::uint64_t> m_always_on;
+
+        [[nodiscard]] size_t row_of(const Point & point) const noexcept {
+            size_t row = 0;
+            for (size_t dimension = dimensions; dimension-- != 1;) {
+                row = row * static_cast<size_t>(m_size[dimension]) + static_cast<size_t>(point[dimension] - m_origin[dimension]);
+            }
+            return row;
+        }
+
+        void set_cell(std::vector<std::uint64_t> & cells, const Point & point) const noexcept {
+            const size_t x = static_cast<size_t>(point[0] - m_origin[0]);
+            cells[row_of(point) * m_words_per_row + x / 64] |= std::uint64_t(1) << (x % 64);
+        }
+
+        /** Calls consumer(row, point) for every row of the box, point being the coordinates of its first cell */
+        template<typename Consumer>
+        void for_each_row(Consumer consumer) const {
+            Point point = m_origin;
+            for (size_t row = 0; row != m_rows; ++row) {
+                consumer(row, point);
+
+                for (size_t dimension = 1; dimension != dimensions; ++dimension) {
+                    if (++point[dimension] != m_origin[dimension] + m_size[dimension]) break;
+                    point[dimension] = m_origin[dimension];
+                }
+            }
+        }
+
+        template<typename Consumer>
+        void for_each_alive_point(Consumer consumer) const {
+            for_each_row([&](size_t row, Point point) {
+                for (size_t word = 0; word != m_words_per_row; ++word) {
+                    for (std::uint64_t bits = m_alive[row * m_words_per_row + word]; bits != 0; bits &= bits - 1) {
+                        point[0] = m_origin[0] + static_cast<int>(word * 64) + std::countr_zero(bits);
+                        consumer(point);
+                    }
+                }
+            });
+        }
+
+        static void extend(std::optional<Bounds> & bounds, const Point & low, const Point & high) {
+            if (!bounds) {
+                bounds.emplace(low, high);
+                return;
+            }
+
+            for (size_t dimension = 0; dimension != dimensions; ++dimension) {
+                bounds->first[dimension] = std::min(bounds->first[dimension], low[dimension]);
+                bounds->second[dimension] = std::max(bounds->second[dimension], high[dimension]);
+            }
+        }
+
+        [[nodiscard]] std::optional<Bounds> alive_bounds() const {
+            std::optional<Bounds> bounds;
+            for_each_row([&](size_t row, const Point & point) {
+                for (size_t word = 0; word != m_words_per_row; ++word) {
+                    const std::uint64_t bits = m_alive[row * m_words_per_row + word];
+                    if (bits == 0) continue;
+
+                    Point low = point;
+                    Point high = point;
+                    low[0] = m_origin[0] + static_cast<int>(word * 64) + std::countr_zero(bits);
+                    high[0] = m_origin[0] + static_cast<int>(word * 64) + 63 - std::countl_zero(bits);
+                    extend(bounds, low, high);
+                }
+            });
+            return bounds;
+        }
+
+        [[nodiscard]] bool touches_border(const Bounds & bounds) const noexcept {
+            for (size_t dimension = 0; dimension != dimensions; ++dimension) {
+                if (bounds.first[dimension] <= m_origin[dimension]) return true;
+                if (bounds.second[dimension] >= m_origin[dimension] + m_size[dimension] - 1) return true;
+            }
+            return false;
+        }
+
+        /** Moves to a box around `bounds` with the alive cells `cells`, with room to grow in every direction */
+        void resize(const Bounds & bounds, const std::vector<Point> & cells) {
+            for (size_t dimension = 0; dimension != dimensions; ++dimension) {
+                const int extent = bounds.second[dimension] - bounds.first[dimension] + 1;
+                const int margin = 1 + extent / 2;
+                m_origin[dimension] = bounds.first[dimension] - margin;
+                m_size[dimension] = extent + 2 * margin;
+            }
+
+            m_words_per_row = (static_cast<size_t>(m_size[0]) + 63) / 64;
+            m_rows = 1;
+            for (size_t dimension = 1; dimension != dimensions; ++dimension) {
+                m_rows *= static_cast<size_t>(m_size[dimension]);
+            }
+
+            for (size_t i = 0; i != neighbours; ++i) {
+                std::ptrdiff_t offset = 0;
+                for (size_t dimension = dimensions; dimension-- != 1;) {
+                    offset = offset * m_size[dimension] + Rules::neighbourhood[i][dimension];
+                }
+                m_row_offsets[i] = offset;
+            }
+
+            const size_t words = m_rows * m_words_per_row;
+            m_alive.assign(words, 0);
+            m_next.assign(words, 0);
+            m_valid.assign(words, 0);
+            if constexpr (has_always_on) m_always_on.assign(words, 0);
+
+            for (const Point & cell : cells) {
+                set_cell(m_alive, cell);
+            }
+
+            for_each_row([&](size_t, Point point) {
+                for (int x = 0; x != m_size[0]; ++x) {
+                    point[0] = m_origin[0] + x;
+                    const Element element = Coordinates::to(point);
+                    if (!m_rules.is_valid(element)) continue;
+
+                    set_cell(m_valid, point);
+                    if constexpr (has_always_on) {
+                        if (m_rules.is_always_on(element)) set_cell(m_always_on, point);
+                    }
+                }
+            });
+        }
+
+        /** The alive cells at the neighbour i of the 64 cells of the word */
+        [[nodiscard]] std::uint64_t neighbours_of(size_t row, size_t word, size_t i) const noexcept {
+            const std::ptrdiff_t source = static_cast<std::ptrdiff_t>(row) + m_row_offsets[i];
+            // The neighbours of the cells of the border may be on the other
+            // side of the box, but they are dead like the cells outside
+            if (source < 0 || source >= static_cast<std::ptrdiff_t>(m_rows)) return 0;
+
+            const std::uint64_t * const words = m_alive.data() + static_cast<size_t>(source) * m_words_per_row;
+            switch (Rules::neighbourhood[i][0]) {
+                case -1: return (words[word] << 1) | (word != 0 ? words[word - 1] >> 63 : 0);
+                case 1:  return (words[word] >> 1) | (word + 1 != m_words_per_row ? words[word + 1] << 63 : 0);
+                default: return words[word];
+            }
+        }
+
+        static void add(Counter & counter, std::uint64_t bits) noexcept {
+            for (size_t k = 0; k != counter_bits && bits != 0; ++k) {
+                const std::uint64_t carry = counter[k] & bits;
+                counter[k] ^= bits;
+                bits = carry;
+            }
+        }
+
+        /** The cells whose counter is one of the counts */
+        [[nodiscard]] static std::uint64_t matching(const Counter & counter, std::uint64_t counts) noexcept {
+            std::uint64_t result = 0;
+            for (size_t count = 0; count <= neighbours && count != 64; ++count) {
+                if ((counts >> count & 1) == 0) continue;
+
+                std::uint64_t equal = ~std::uint64_t(0);
+                for (size_t k = 0; k != counter_bits; ++k) {
+                    equal &= (count >> k & 1) != 0 ? counter[k] : ~counter[k];
+                }
+                result |= equal;
+            }
+            return result;
+        }
+
+    public:
+        template<std::ranges::input_range Elements>
+        DenseGameOfLife(const Elements & elements, Rules rules) : m_rules(std::move(rules)) {
+            std::vector<Point> cells;
+            std::optional<Bounds> bounds;
+            for (const Element & element : elements) {
+                const Point & point = Coordinates::of(element);
+                cells.emplace_back(point);
+                extend(bounds, point, point);
+            }
+
+            if (bounds) resize(*bounds, cells);
+        }
+
+        void step() {
+            if (const auto bounds = alive_bounds(); bounds && touches_border(*bounds)) {
+                std::vector<Point> cells;
+                for_each_alive_point([&](const Point & point) { cells.emplace_back(point); });
+                resize(*bounds, cells);
+            }
+
+            for (size_t row = 0; row != m_rows; ++row) {
+                for (size_t word = 0; word != m_words_per_row; ++word) {
+                    Counter counter {};
+                    for (size_t i = 0; i != neighbours; ++i) {
+                        add(counter, neighbours_of(row, word, i));
+                    }
+
+                    const size_t index = row * m_words_per_row + word;
+                    const std::uint64_t alive = m_alive[index];
+                    std::uint64_t next = (alive & matching(counter, Rules::survival))
+                                       | (~alive & matching(counter, Rules::birth));
+                    next &= m_valid[index];
+                    if constexpr (has_always_on) next |= m_always_on[index];
+                    m_next[index] = next;
+                }
+            }
+
+            std::swap(m_alive, m_next);
+        }
+
+        [[nodiscard]] size_t count() const noexcept {
+            size_t total = 0;
+            for (const std::uint64_t word : m_alive) {
+                total += static_cast<size_t>(std::popcount(word));
+            }
+            return total;
+        }
+
+        [[nodiscard]] std::set<Element> elements() const {
+            std::set<Element> result;
+            for_each_alive_point([&](const Point & point) { result.emplace(Coordinates::to(point)); });
+            return result;
+        }
+    };
+
+    /**
+     * One step of the game of life on a std::set of the alive elements and a
+     * std::map of the counts of alive neighbours. See the example of rules
+     * at the end of the file.
+     */
     template <typename Rules>
-    void game_of_life(std::set<typename Rules::Element> & positions, Rules rules) {
+    void sparse_game_of_life(std::set<typename Rules::Element> & positions, Rules rules) {
         using Element = Rules::Element;
         std::set<Element> old = std::move(positions);
 
@@ -43,15 +401,36 @@ namespace bj {
         }
     }
 
+    /** One step of the game of life, run by the dense engine if the rules are DenseRules */
+    template <typename Rules>
+    void game_of_life(std::set<typename Rules::Element> & positions, Rules rules) {
+        if constexpr (DenseRules<Rules>) {
+            DenseGameOfLife<Rules> dense(positions, std::move(rules));
+            dense.step();
+            positions = dense.elements();
+        } else {
+            sparse_game_of_life(positions, std::move(rules));
+        }
+    }
+
     template <typename Rules>
     [[nodiscard]] auto game_of_life(size_t loops, std::set<typename Rules::Element> positions, Rules rules) {
-        for (size_t i = 0 ; i != loops; ++i) {
-            game_of_life(positions, rules);
+        if constexpr (DenseRules<Rules>) {
+            DenseGameOfLife<Rules> dense(positions, std::move(rules));
+            for (size_t i = 0 ; i != loops; ++i) {
+                dense.step();
+            }
+            return dense.elements();
+        } else {
+            for (size_t i = 0 ; i != loops; ++i) {
+                sparse_game_of_life(positions, rules);
+            }
+
+            return positions;
         }
-        
-        return positions;
     }
-    
+
+
 /*
     // Example of Rules implementation:
 
@@ -75,6 +454,11 @@ namespace bj {
                 return c == 3;
             }
         }
+
+        // Optional, to be run by the dense engine
+        static constexpr std::uint64_t birth = bj::neighbour_counts({ 3 });
+        static constexpr std::uint64_t survival = bj::neighbour_counts({ 2, 3 });
+        static constexpr auto neighbourhood = bj::moore_neighbourhood<2>();
     };
 
 
@@ -0,0 +1,421 @@
+#pragma once
+
+#include "position.hpp"
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Shortest paths between the states of a puzzle: BFS, 0-1 BFS, Dijkstra
+// and A*.
+//
+// The states are numbered by a state space, so the distances are stored in
+// a dense array instead of a std::map or a std::set of the visited states.
+// Dijkstra pops the states from a bucket queue (Dial) when the weights are
+// small integers, and A* from a radix heap.
+//
+// The neighbours of a state are given by a function
+//     neighbours(state, emit)
+// that calls emit(next) for BFS, and emit(next, weight) for the weighted
+// searches. It must only emit states of the space.
+
+namespace bj::graph {
+    /**
+     * A state space numbers the states: space.index(state) is in
+     * [0, space.size()), and two different states have different indexes.
+     */
+    template<typename Space>
+    concept StateSpace = requires(const Space & space, const typename Space::State & state) {
+        { space.size() } -> std::convertible_to<std::size_t>;
+        { space.index(state) } -> std::convertible_to<std::size_t>;
+    };
+
+    /** The positions of a width x height grid, whose top left cell is `origin` */
+    struct GridSpace {
+        using State = Position;
+
+        int width;
+        int height;
+        Position origin = Position{ 0, 0 };
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+        }
+
+        [[nodiscard]] bool contains(Position position) const noexcept {
+            return position.x >= origin.x && position.x < origin.x + width
+                && position.y >= origin.y && position.y < origin.y + height;
+        }
+
+        [[nodiscard]] std::size_t index(Position position) const noexcept {
+            return static_cast<std::size_t>(position.y - origin.y) * static_cast<std::size_t>(width)
+                 + static_cast<std::size_t>(position.x - origin.x);
+        }
+
+        /** The grid of the lines of the input */
+        template<typename Lines>
+        [[nodiscard]] static GridSpace of(const Lines & lines) {
+            return GridSpace{ static_cast<int>(lines[0].size()), static_cast<int>(lines.size()) };
+        }
+    };
+
+    /** The positions and the directions of the cells of a grid */
+    struct KittenSpace {
+        using State = Kitten;
+
+        GridSpace grid;
+
+        [[nodiscard]] std::size_t size() const noexcept { return grid.size() * 4; }
+
+        [[nodiscard]] std::size_t index(const Kitten & kitten) const noexcept {
+            return grid.index(kitten.position) * 4 + static_cast<std::size_t>(kitten.direction);
+        }
+    };
+
+    /** The distance from the sources of each state of a space */
+    template<StateSpace Space, typename Distance = int>
+    class Distances {
+    public:
+        using State = typename Space::State;
+
+        static constexpr Distance unreached = std::numeric_limits<Distance>::max();
+
+    private:
+        Space m_space;
+        std::vector<Distance> m_distances;
+
+    public:
+        explicit Distances(Space space)
+        : m_space(std::move(space)), m_distances(m_space.size(), unreached) {}
+
+        [[nodiscard]] const Space & space() const noexcept { return m_space; }
+
+        /** The distance of the state, `unreached` if it was not reached */
+        [[nodiscard]] Distance operator[](const State & state) const { return m_distances[m_space.index(state)]; }
+
+        [[nodiscard]] bool reached(const State & state) const { return (*this)[state] != unreached; }
+
+        [[nodiscard]] std::optional<Distance> get(const State & state) const {
+            const Distance distance = (*this)[state];
+            if (distance == unreached) return std::nullopt;
+            return distance;
+        }
+
+        /** Sets the distance of the state if it is shorter than the known one, and returns true if it was */
+        bool improve(const State & state, Distance distance) {
+            Distance & known = m_distances[m_space.index(state)];
+            if (known <= distance) return false;
+            known = distance;
+            return true;
+        }
+
+        [[nodiscard]] std::size_t count_reached() const noexcept {
+            return static_cast<std::size_t>(std::ranges::count_if(m_distances, [](Distance d) { return d != unreached; }));
+        }
+
+        /** The distances, in the order of the indexes of the space */
+        [[nodiscard]] std::span<const Distance> values() const noexcept { return m_distances; }
+    };
+
+    /** The distances from the sources, and the first target that was reached */
+    template<StateSpace Space, typename Distance = int>
+    struct SearchResult {
+        Distances<Space, Distance> distances;
+        std::optional<typename Space::State> target = std::nullopt;
+
+        [[nodiscard]] std::optional<Distance> target_distance() const {
+            if (!target) return std::nullopt;
+            return distances[*target];
+        }
+    };
+
+    template<typename Distance = int>
+    struct SearchOptions {
+        /** The states farther than this from the sources are reached, but not expanded */
+        Distance max_distance = std::numeric_limits<Distance>::max();
+        /** If not 0, the greatest weight: Dijkstra uses a bucket queue of max_weight + 1 buckets */
+        Distance max_weight = 0;
+    };
+
+    /** The target of the searches that compute the distance of every reachable state */
+    struct NoTarget {
+        template<typename State>
+        [[nodiscard]] constexpr bool operator()(const State &) const noexcept { return false; }
+    };
+
+    /**
+     * Dial's bucket queue: the keys of the elements are between the last
+     * popped key and this key + max_weight, so there is one bucket per key,
+     * used in a circular way.
+     */
+    template<typename T>
+    class BucketQueue {
+        std::vector<std::vector<T>> m_buckets;
+        std::uint64_t m_current = 0;
+        std::size_t m_size = 0;
+
+    public:
+        explicit BucketQueue(std::uint64_t max_weight) : m_buckets(max_weight + 1) {}
+
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+        void push(std::uint64_t key, T value) {
+            m_buckets[key % m_buckets.size()].push_back(std::move(value));
+            ++m_size;
+        }
+
+        /** An element with the smallest key */
+        T pop() {
+            while (m_buckets[m_current % m_buckets.size()].empty()) ++m_current;
+
+            std::vector<T> & bucket = m_buckets[m_current % m_buckets.size()];
+            T value = std::move(bucket.back());
+            bucket.pop_back();
+            --m_size;
+            return value;
+        }
+    };
+
+    /**
+     * A monotone priority queue: the pushed keys are greater or equal to the
+     * last popped one. The elements are in the bucket of the highest bit
+     * that differs from the last popped key, so each element moves to a lower
+     * bucket at most 64 times.
+     */
+    template<typename T>
+    class RadixHeap {
+        std::vector<std::pair<std::uint64_t, T>> m_buckets[65];
+        std::uint64_t m_last = 0;
+        std::size_t m_size = 0;
+
+        [[nodiscard]] std::size_t bucket_of(std::uint64_t key) const noexcept {
+            return key == m_last ? 0 : 64 - static_cast<std::size_t>(std::countl_zero(key ^ m_last));
+        }
+
+    public:
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+        void push(std::uint64_t key, T value) {
+            m_buckets[bucket_of(key)].emplace_back(key, std::move(value));
+            ++m_size;
+        }
+
+        /** An element with the smallest key */
+        T pop() {
+            if (m_buckets[0].empty()) {
+                std::size_t i = 1;
+                while (m_buckets[i].empty()) ++i;
+
+                // The smallest key of the first non empty bucket becomes the
+                // last key, and the bucket is spread in the lower buckets
+                m_last = m_buckets[i][0].first;
+                for (const auto & element : m_buckets[i]) m_last = std::min(m_last, element.first);
+
+                for (auto & element : m_buckets[i]) {
+                    m_buckets[bucket_of(element.first)].push_back(std::move(element));
+                }
+                m_buckets[i].clear();
+            }
+
+            T value = std::move(m_buckets[0].back().second);
+            m_buckets[0].pop_back();
+            --m_size;
+            return value;
+        }
+    };
+
+    namespace graph_search_details {
+        /** Calls f on the sources, that are a state or a range of states */
+        template<typename State, typename Sources, typename F>
+        void for_each_source(const Sources & sources, F f) {
+            if constexpr (std::convertible_to<const Sources &, const State &>) {
+                f(static_cast<const State &>(sources));
+            } else {
+                for (const State & source : sources) f(source);
+            }
+        }
+
+        template<typename State, typename Distance>
+        struct Entry {
+            Distance distance;
+            State state;
+        };
+
+        template<typename Frontier, typename Distance, typename Space, typename Sources,
+            typename Neighbours, typename Heuristic, typename IsTarget>
+        SearchResult<Space, Distance> best_first(
+            Frontier frontier, const Space & space, const Sources & sources,
+            Neighbours & neighbours, Heuristic & heuristic, IsTarget & is_target,
+            const SearchOptions<Distance> & options
+        ) {
+            using State = typename Space::State;
+            using Entry = graph_search_details::Entry<State, Distance>;
+
+            SearchResult<Space, Distance> result{ Distances<Space, Distance>(space) };
+            Distances<Space, Distance> & distances = result.distances;
+
+            for_each_source<State>(sources, [&](const State & source) {
+                if (distances.improve(source, 0)) {
+                    frontier.push(static_cast<std::uint64_t>(heuristic(source)), Entry{ 0, source });
+                }
+            });
+
+            while (!frontier.empty()) {
+                const Entry entry = frontier.pop();
+
+                // The state was reached by a shorter path after this entry was pushed
+                if (entry.distance != distances[entry.state]) continue;
+
+                if (is_target(entry.state)) {
+                    result.target = entry.state;
+                    return result;
+                }
+
+                if (entry.distance >= options.max_distance) continue;
+
+                neighbours(entry.state, [&](const State & next, Distance weight) {
+                    const Distance distance = entry.distance + weight;
+                    if (distances.improve(next, distance)) {
+                        frontier.push(static_cast<std::uint64_t>(distance + heuristic(next)), Entry{ distance, next });
+                    }
+                });
+            }
+
+            return result;
+        }
+    }
+
+    /**
+     * Breadth first search: the distance of a state is its number of edges
+     * from the closest source. Stops when a state for which is_target is
+     * true is popped, or when every reachable state was visited.
+     */
+    template<typename Distance = int, StateSpace Space, typename Sources, typename Neighbours, typename IsTarget = NoTarget>
+    SearchResult<Space, Distance> bfs(
+        const Space & space, const Sources & sources, Neighbours neighbours,
+        IsTarget is_target = {}, SearchOptions<Distance> options = {}
+    ) {
+        using State = typename Space::State;
+
+        SearchResult<Space, Distance> result{ Distances<Space, Distance>(space) };
+        Distances<Space, Distance> & distances = result.distances;
+
+        std::vector<State> queue;
+        graph_search_details::for_each_source<State>(sources, [&](const State & source) {
+            if (distances.improve(source, 0)) queue.push_back(source);
+        });
+
+        for (std::size_t head = 0; head != queue.size(); ++head) {
+            const State state = queue[head];
+            const Distance distance = distances[state];
+
+            if (is_target(state)) {
+                result.target = state;
+                return result;
+            }
+
+            if (distance >= options.max_distance) continue;
+
+            neighbours(state, [&](const State & next) {
+                if (distances.improve(next, distance + 1)) queue.push_back(next);
+            });
+        }
+
+        return result;
+    }
+
+    /** Shortest paths when the weights are 0 or 1: a deque replaces the priority queue */
+    template<typename Distance = int, StateSpace Space, typename Sources, typename Neighbours, typename IsTarget = NoTarget>
+    SearchResult<Space, Distance> zero_one_bfs(
+        const Space & space, const Sources & sources, Neighbours neighbours,
+        IsTarget is_target = {}, SearchOptions<Distance> options = {}
+    ) {
+        using State = typename Space::State;
+        using Entry = graph_search_details::Entry<State, Distance>;
+
+        SearchResult<Space, Distance> result{ Distances<Space, Distance>(space) };
+        Distances<Space, Distance> & distances = result.distances;
+
+        std::deque<Entry> deque;
+        graph_search_details::for_each_source<State>(sources, [&](const State & source) {
+            if (distances.improve(source, 0)) deque.push_back(Entry{ 0, source });
+        });
+
+        while (!deque.empty()) {
+            const Entry entry = deque.front();
+            deque.pop_front();
+
+            if (entry.distance != distances[entry.state]) continue;
+
+            if (is_target(entry.state)) {
+                result.target = entry.state;
+                return result;
+            }
+
+            if (entry.distance >= options.max_distance) continue;
+
+            neighbours(entry.state, [&](const State & next, Distance weight) {
+                const Distance distance = entry.distance + weight;
+                if (!distances.improve(next, distance)) return;
+
+                if (weight == 0) {
+                    deque.push_front(Entry{ distance, next });
+                } else {
+                    deque.push_back(Entry{ distance, next });
+                }
+            });
+        }
+
+        return result;
+    }
+
+    /**
+     * Shortest paths with non negative integer weights. With
+     * options.max_weight, the frontier is a bucket queue, else a radix heap.
+     */
+    template<typename Distance = int, StateSpace Space, typename Sources, typename Neighbours, typename IsTarget = NoTarget>
+    SearchResult<Space, Distance> dijkstra(
+        const Space & space, const Sources & sources, Neighbours neighbours,
+        IsTarget is_target = {}, SearchOptions<Distance> options = {}
+    ) {
+        using Entry = graph_search_details::Entry<typename Space::State, Distance>;
+        auto no_heuristic = [](const auto &) { return Distance(0); };
+
+        if (options.max_weight != 0) {
+            return graph_search_details::best_first(
+                BucketQueue<Entry>(static_cast<std::uint64_t>(options.max_weight)),
+                space, sources, neighbours, no_heuristic, is_target, options
+            );
+        } else {
+            return graph_search_details::best_first(
+                RadixHeap<Entry>(), space, sources, neighbours, no_heuristic, is_target, options
+            );
+        }
+    }
+
+    /**
+     * Dijkstra that pops first the states closer to the target according to
+     * the heuristic. The heuristic must be consistent: it never decreases by
+     * more than the weight of an edge, and it is 0 on the targets.
+     */
+    template<typename Distance = int, StateSpace Space, typename Sources, typename Neighbours, typename Heuristic, typename IsTarget>
+    SearchResult<Space, Distance> a_star(
+        const Space & space, const Sources & sources, Neighbours neighbours,
+        Heuristic heuristic, IsTarget is_target, SearchOptions<Distance> options = {}
+    ) {
+        using Entry = graph_search_details::Entry<typename Space::State, Distance>;
+
+        return graph_search_details::best_first(
+            RadixHeap<Entry>(), space, sources, neighbours, heuristic, is_target, options
+        );
+    }
+}
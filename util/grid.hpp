@@ -0,0 +1,287 @@
+#pragma once
+
+#include "position.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace bj {
+    inline constexpr std::array<Direction, 4> all_directions {
+        Direction::Left, Direction::Right, Direction::Top, Direction::Down
+    };
+
+    /**
+     * A grid of width x height cells, stored row by row in one vector.
+     *
+     * The grid can be surrounded by a border of `padding` cells: the cells of
+     * the border can be read and written with operator[] like the other
+     * ones, so the neighbours of every cell of the grid can be read without
+     * checking the bounds. The border is not part of the grid for contains,
+     * find, count, rows and columns.
+     */
+    template<typename T>
+    class Grid {
+        static_assert(!std::same_as<T, bool>, "std::vector<bool> is not contiguous, use a Grid<char>");
+
+        int m_width = 0;
+        int m_height = 0;
+        int m_padding = 0;
+        /** Width of the rows in m_cells, border included */
+        int m_stride = 0;
+        std::vector<T> m_cells;
+
+        [[nodiscard]] size_t index_of(Position position) const noexcept {
+            return static_cast<size_t>(position.y + m_padding) * static_cast<size_t>(m_stride)
+                 + static_cast<size_t>(position.x + m_padding);
+        }
+
+        [[nodiscard]] bool is_addressable(Position position) const noexcept {
+            return position.x >= -m_padding && position.x < m_width + m_padding
+                && position.y >= -m_padding && position.y < m_height + m_padding;
+        }
+
+    public:
+        Grid() = default;
+
+        Grid(int width, int height, const T & value = T{}, int padding = 0, const T & border = T{})
+        : m_width(width), m_height(height), m_padding(padding), m_stride(width + 2 * padding),
+          m_cells(static_cast<size_t>(width + 2 * padding) * static_cast<size_t>(height + 2 * padding), border) {
+            fill(value);
+        }
+
+        /**
+         * A grid with the characters of the lines, converted by `convert`.
+         * The missing characters of the lines shorter than the first one are
+         * given the value of the border.
+         */
+        template<std::ranges::random_access_range Lines, typename Converter>
+        requires std::convertible_to<std::invoke_result_t<Converter, char>, T>
+        static Grid from_lines(const Lines & lines, Converter convert, int padding = 0, const T & border = T{}) {
+            const int height = static_cast<int>(std::ranges::size(lines));
+            const int width = height == 0 ? 0 : static_cast<int>(std::ranges::size(lines[0]));
+
+            Grid grid(width, height, border, padding, border);
+            for (int y = 0; y != height; ++y) {
+                const auto & line = lines[y];
+                const int line_width = std::min(width, static_cast<int>(std::ranges::size(line)));
+                for (int x = 0; x != line_width; ++x) {
+                    grid[Position{ x, y }] = convert(line[x]);
+                }
+            }
+
+            return grid;
+        }
+
+        template<std::ranges::random_access_range Lines>
+        requires std::same_as<T, char>
+        static Grid from_lines(const Lines & lines, int padding = 0, char border = ' ') {
+            return from_lines(lines, [](char c) { return c; }, padding, border);
+        }
+
+        [[nodiscard]] int width() const noexcept { return m_width; }
+        [[nodiscard]] int height() const noexcept { return m_height; }
+        [[nodiscard]] int padding() const noexcept { return m_padding; }
+
+        /** True if the position is a cell of the grid, false for the border and outside */
+        [[nodiscard]] bool contains(Position position) const noexcept {
+            return position.x >= 0 && position.x < m_width && position.y >= 0 && position.y < m_height;
+        }
+
+        /** The cell at the position, that must be in the grid or in its border */
+        [[nodiscard]] T & operator[](Position position) noexcept { return m_cells[index_of(position)]; }
+        [[nodiscard]] const T & operator[](Position position) const noexcept { return m_cells[index_of(position)]; }
+
+        [[nodiscard]] T & at(Position position) {
+            if (!is_addressable(position)) throw std::out_of_range("bj::Grid::at");
+            return (*this)[position];
+        }
+
+        [[nodiscard]] const T & at(Position position) const {
+            if (!is_addressable(position)) throw std::out_of_range("bj::Grid::at");
+            return (*this)[position];
+        }
+
+        /** The cell at the position, nullopt if it is not in the grid */
+        [[nodiscard]] std::optional<T> get(Position position) const {
+            if (!contains(position)) return std::nullopt;
+            return (*this)[position];
+        }
+
+        [[nodiscard]] std::span<T> row(int y) noexcept {
+            return std::span<T>(m_cells).subspan(index_of(Position{ 0, y }), static_cast<size_t>(m_width));
+        }
+
+        [[nodiscard]] std::span<const T> row(int y) const noexcept {
+            return std::span<const T>(m_cells).subspan(index_of(Position{ 0, y }), static_cast<size_t>(m_width));
+        }
+
+        [[nodiscard]] auto column(int x) noexcept {
+            return std::views::iota(0, m_height)
+                | std::views::transform([this, x](int y) -> T & { return (*this)[Position{ x, y }]; });
+        }
+
+        [[nodiscard]] auto column(int x) const noexcept {
+            return std::views::iota(0, m_height)
+                | std::views::transform([this, x](int y) -> const T & { return (*this)[Position{ x, y }]; });
+        }
+
+        /** The positions of the cells of the grid, row by row */
+        [[nodiscard]] auto positions() const noexcept {
+            return std::views::iota(0, m_width * m_height)
+                | std::views::transform([width = m_width](int i) { return Position{ i % width, i / width }; });
+        }
+
+        /** The 4 neighbours of the position, indexed by Direction */
+        [[nodiscard]] static std::array<Position, 4> neighbours(Position position) noexcept {
+            std::array<Position, 4> result;
+            for (const Direction direction : all_directions) {
+                Position neighbour = position;
+                neighbour.move(direction);
+                result[static_cast<size_t>(direction)] = neighbour;
+            }
+            return result;
+        }
+
+        /** Calls consumer(direction, position) for the neighbours of the position that are in the grid */
+        template<std::invocable<Direction, Position> Consumer>
+        void for_each_neighbour(Position position, Consumer consumer) const {
+            for (const Direction direction : all_directions) {
+                Position neighbour = position;
+                neighbour.move(direction);
+                if (contains(neighbour)) consumer(direction, neighbour);
+            }
+        }
+
+        /** The first position, row by row, whose cell is equal to the value */
+        [[nodiscard]] std::optional<Position> find(const T & value) const {
+            for (int y = 0; y != m_height; ++y) {
+                const auto cells = row(y);
+                const auto it = std::find(cells.begin(), cells.end(), value);
+                if (it != cells.end()) return Position{ static_cast<int>(it - cells.begin()), y };
+            }
+            return std::nullopt;
+        }
+
+        [[nodiscard]] size_t count(const T & value) const {
+            size_t total = 0;
+            for (int y = 0; y != m_height; ++y) {
+                const auto cells = row(y);
+                total += static_cast<size_t>(std::count(cells.begin(), cells.end(), value));
+            }
+            return total;
+        }
+
+        /** Sets every cell of the grid, the border is not modified */
+        void fill(const T & value) {
+            for (int y = 0; y != m_height; ++y) {
+                const auto cells = row(y);
+                std::fill(cells.begin(), cells.end(), value);
+            }
+        }
+
+        [[nodiscard]] bool operator==(const Grid & other) const = default;
+
+        [[nodiscard]] std::vector<std::string> to_lines() const requires std::same_as<T, char> {
+            std::vector<std::string> lines;
+            for (int y = 0; y != m_height; ++y) {
+                const auto cells = row(y);
+                lines.emplace_back(cells.begin(), cells.end());
+            }
+            return lines;
+        }
+    };
+
+    /**
+     * A grid over the infinite plane, to replace the std::set<Position> and
+     * std::map<Position, T> of the simulations whose area is not known.
+     *
+     * The cells that were never written have the default value. They are
+     * stored in a dense rectangle that grows, at least doubling its size,
+     * when a cell outside of it is written.
+     */
+    template<typename T>
+    class InfiniteGrid {
+        Grid<T> m_grid;
+        /** Position in the plane of the cell 0, 0 of m_grid */
+        Position m_origin;
+        T m_default;
+
+        void grow_to_contain(Position position) {
+            if (m_grid.width() == 0) {
+                constexpr int initial_size = 16;
+                m_grid = Grid<T>(initial_size, initial_size, m_default);
+                m_origin = Position{ position.x - initial_size / 2, position.y - initial_size / 2 };
+                return;
+            }
+
+            int left   = m_origin.x;
+            int top    = m_origin.y;
+            int right  = m_origin.x + m_grid.width();
+            int bottom = m_origin.y + m_grid.height();
+
+            if (position.x < left)    left   = std::min(position.x, left - m_grid.width());
+            if (position.x >= right)  right  = std::max(position.x + 1, right + m_grid.width());
+            if (position.y < top)     top    = std::min(position.y, top - m_grid.height());
+            if (position.y >= bottom) bottom = std::max(position.y + 1, bottom + m_grid.height());
+
+            Grid<T> grown(right - left, bottom - top, m_default);
+            const Position offset = m_origin - Position{ left, top };
+            for (int y = 0; y != m_grid.height(); ++y) {
+                const auto from = m_grid.row(y);
+                std::copy(from.begin(), from.end(), grown.row(y + offset.y).begin() + offset.x);
+            }
+
+            m_grid = std::move(grown);
+            m_origin = Position{ left, top };
+        }
+
+    public:
+        explicit InfiniteGrid(T default_value = T{}) : m_default(std::move(default_value)) {}
+
+        /** The value of the cell, the default value if it was never written */
+        [[nodiscard]] const T & get(Position position) const noexcept {
+            const Position in_grid = position - m_origin;
+            return m_grid.contains(in_grid) ? m_grid[in_grid] : m_default;
+        }
+
+        /** The cell, after growing the grid if it is outside */
+        [[nodiscard]] T & operator[](Position position) {
+            if (!m_grid.contains(position - m_origin)) grow_to_contain(position);
+            return m_grid[position - m_origin];
+        }
+
+        /** Number of cells equal to a value that is not the default value */
+        [[nodiscard]] size_t count(const T & value) const { return m_grid.count(value); }
+
+        /** Calls consumer(position, value) for the cells that are not equal to the default value */
+        template<std::invocable<Position, const T &> Consumer>
+        void for_each(Consumer consumer) const {
+            for (const Position position : m_grid.positions()) {
+                if (!(m_grid[position] == m_default)) consumer(position + m_origin, m_grid[position]);
+            }
+        }
+
+        /** The smallest rectangle that contains the cells that are not equal to the default value */
+        [[nodiscard]] std::optional<Rectangle> bounds() const {
+            std::optional<Rectangle> rectangle;
+            for_each([&](Position position, const T &) {
+                if (!rectangle) {
+                    rectangle.emplace(position.x, position.y, position.x, position.y);
+                } else {
+                    rectangle->left   = std::min(rectangle->left  , position.x);
+                    rectangle->right  = std::max(rectangle->right , position.x);
+                    rectangle->top    = std::min(rectangle->top   , position.y);
+                    rectangle->bottom = std::max(rectangle->bottom, position.y);
+                }
+            });
+            return rectangle;
+        }
+    };
+}
@@ -1,65 +1,54 @@
-#include <regex>
+#pragma once
+
+#include "pattern.hpp"
+#include <functional>
+#include <iostream>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <span>
+#include <tuple>
 #include <variant>
+#include <vector>
 
 namespace bj {
     /**
-     * A class that can take pairs of regex - builder of objets of type T
+     * A class that can take pairs of pattern - builder of objets of type T
      * and then build Ts from strings.
      *
      * This is used to code the logic of reading a file with instructions lines
      * by lines, and only having to use the `add_handler` function to write
-     * the correct regex and the associated constructor.
+     * the correct pattern (see pattern.hpp) and the associated constructor.
      *
      * Example of usage can be found on day 2016-08
      */
     template<typename T>
     class InstructionReader {
     public:
-        /** Type of functions that can convert a regex decoded string into a T */
-        using Handler = T(const std::vector<std::string> &);
+        /** Type of functions that build a T from a line, if the line is for them */
+        using Handler = std::function<std::optional<T>(std::string_view)>;
 
     private:
-        /** Individual handler, with the regex and the handler */
-        class RegexConverterElement {
-        private:
-            std::regex m_regex;
-            Handler * m_handler;
-
-        public:
-            RegexConverterElement(const char * regex, Handler * handler)
-                : m_regex(regex), m_handler(handler) {}
-
-            std::optional<T> operator()(const std::string & str) const {
-                std::smatch smatch;
-                const bool r = std::regex_search(str, smatch, m_regex);
-
-                if (!r) return std::nullopt;
-
-                std::vector<std::string> values;
-
-                for (int i = 1 ; i != smatch.length() ; ++i) {
-                    values.emplace_back(smatch[i].str());
-                }
-
-                return m_handler(values);
-            }
-        };
-
-    private:
-        std::vector<RegexConverterElement> m_handlers;
+        std::vector<Handler> m_handlers;
 
     public:
-        /** Adds a handler for a regex, with the given constructor */
-        void add_handler(const char * regex, Handler * handler) {
-            m_handlers.emplace_back(regex, handler);
+        /**
+         * Adds a handler for the lines that match the pattern. The builder is
+         * called with the typed captures of the pattern.
+         */
+        template<FixedString Text, typename Builder>
+        void add_handler(Builder builder) {
+            m_handlers.emplace_back([builder](std::string_view line) -> std::optional<T> {
+                typename Pattern<Text>::Captures captures;
+                if (!Pattern<Text>::match_into(line, captures)) return std::nullopt;
+                return T(std::apply(builder, captures));
+            });
         }
 
         /** If a T can be built from the string, build it and return it */
-        std::optional<T> operator()(const std::string & str) const {
+        std::optional<T> operator()(std::string_view str) const {
             for (const auto & h : m_handlers) {
-                const auto e = h(str);
+                auto e = h(str);
                 if (e) return e;
             }
 
@@ -72,9 +61,10 @@ namespace bj {
          */
         std::optional<std::vector<T>> operator()(std::span<const std::string> lines) const {
             std::vector<T> elements;
+            elements.reserve(lines.size());
 
             for (const std::string & line : lines) {
-                const auto opt_e = this->operator()(line);
+                auto opt_e = this->operator()(line);
                 if (!opt_e) {
                     std::cerr << "Bad input\n" << line << "\n";
                     return std::nullopt;
@@ -93,10 +83,9 @@ namespace bj {
 
             using Type = std::variant_alternative_t<I, Variant>;
 
-            reader.add_handler(
-                Type::Regex_Pattern,
-                [](const std::vector<std::string> & values) -> Variant {
-                    return Type(values);
+            reader.template add_handler<Type::Line_Pattern>(
+                [](auto... values) -> Variant {
+                    return Type(values...);
                 }
             );
 
@@ -106,6 +95,10 @@ namespace bj {
         }
     }
 
+    /**
+     * A reader of the alternatives of the variant, built from the captures of
+     * their Line_Pattern
+     */
     template<typename Variant>
     InstructionReader<Variant> make_instruction_reader_from_variant() {
         InstructionReader<Variant> reader;
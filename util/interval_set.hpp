@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Sets of integers stored as intervals, for the days whose ranges are too
+// large to be enumerated.
+//
+// An IntervalSet is a sorted vector of disjoint, non adjacent and non empty
+// half-open intervals, so the union, the intersection and the difference of
+// two sets are merges of two sorted sequences. The loops of the merges write
+// their output unconditionally and advance with the result of a comparison,
+// so they stay fast on sets of tens of millions of intervals.
+
+namespace bj {
+    /** The integers of [min, max) */
+    template<std::integral T>
+    struct Interval {
+        T min;
+        T max;
+
+        /** The interval of the integers from first to last, both included */
+        [[nodiscard]] static constexpr Interval closed(T first, T last) noexcept { return Interval{ first, last + 1 }; }
+
+        [[nodiscard]] constexpr bool empty() const noexcept { return max <= min; }
+        [[nodiscard]] constexpr T size() const noexcept { return empty() ? T(0) : max - min; }
+
+        [[nodiscard]] constexpr bool contains(T value) const noexcept { return min <= value && value < max; }
+
+        [[nodiscard]] constexpr bool contains(const Interval & other) const noexcept {
+            return other.empty() || (min <= other.min && other.max <= max);
+        }
+
+        [[nodiscard]] constexpr bool overlaps(const Interval & other) const noexcept {
+            return std::max(min, other.min) < std::min(max, other.max);
+        }
+
+        /** The part below `value`, and the part from `value`. One of them may be empty */
+        [[nodiscard]] constexpr std::pair<Interval, Interval> split_at(T value) const noexcept {
+            const T middle = std::clamp(value, min, std::max(min, max));
+            return { Interval{ min, middle }, Interval{ middle, max } };
+        }
+
+        [[nodiscard]] constexpr Interval shifted(T offset) const noexcept { return Interval{ min + offset, max + offset }; }
+
+        [[nodiscard]] friend constexpr bool operator==(const Interval &, const Interval &) noexcept = default;
+    };
+
+    template<std::integral T>
+    class IntervalSet {
+        std::vector<Interval<T>> m_intervals;
+
+        struct Normalized {};
+
+        IntervalSet(Normalized, std::vector<Interval<T>> intervals) : m_intervals(std::move(intervals)) {}
+
+        /** Merges the overlapping and adjacent intervals of non empty intervals sorted by min */
+        static void coalesce_sorted(std::vector<Interval<T>> & intervals) {
+            if (intervals.empty()) return;
+
+            std::size_t out = 0;
+            Interval<T> current = intervals[0];
+
+            for (std::size_t i = 1; i != intervals.size(); ++i) {
+                const Interval<T> next = intervals[i];
+                const bool disjoint = next.min > current.max;
+
+                // out <= i - 1, so the slot was already read
+                intervals[out] = current;
+                out += disjoint ? 1 : 0;
+                current.min = disjoint ? next.min : current.min;
+                current.max = disjoint ? next.max : std::max(current.max, next.max);
+            }
+
+            intervals[out] = current;
+            intervals.resize(out + 1);
+        }
+
+    public:
+        IntervalSet() = default;
+
+        /** The union of the intervals, that may be in any order, overlap or be empty */
+        explicit IntervalSet(std::vector<Interval<T>> intervals) {
+            std::erase_if(intervals, [](const Interval<T> & interval) { return interval.empty(); });
+            std::ranges::sort(intervals, {}, &Interval<T>::min);
+            coalesce_sorted(intervals);
+            m_intervals = std::move(intervals);
+        }
+
+        IntervalSet(std::initializer_list<Interval<T>> intervals)
+        : IntervalSet(std::vector<Interval<T>>(intervals)) {}
+
+        /** The intervals, sorted, disjoint and not adjacent */
+        [[nodiscard]] std::span<const Interval<T>> intervals() const noexcept { return m_intervals; }
+        [[nodiscard]] auto begin() const noexcept { return m_intervals.begin(); }
+        [[nodiscard]] auto end() const noexcept { return m_intervals.end(); }
+
+        [[nodiscard]] bool empty() const noexcept { return m_intervals.empty(); }
+
+        /** The number of integers in the set */
+        [[nodiscard]] T size() const noexcept {
+            T total = 0;
+            for (const Interval<T> & interval : m_intervals) total += interval.max - interval.min;
+            return total;
+        }
+
+        /** The smallest integer of the set */
+        [[nodiscard]] std::optional<T> min() const noexcept {
+            if (m_intervals.empty()) return std::nullopt;
+            return m_intervals.front().min;
+        }
+
+        [[nodiscard]] bool contains(T value) const noexcept {
+            const auto after = std::ranges::upper_bound(m_intervals, value, {}, &Interval<T>::min);
+            return after != m_intervals.begin() && value < std::prev(after)->max;
+        }
+
+        friend IntervalSet operator|(const IntervalSet & lhs, const IntervalSet & rhs) {
+            std::vector<Interval<T>> merged(lhs.m_intervals.size() + rhs.m_intervals.size());
+            std::ranges::merge(lhs.m_intervals, rhs.m_intervals, merged.begin(), {}, &Interval<T>::min, &Interval<T>::min);
+            coalesce_sorted(merged);
+            return IntervalSet(Normalized{}, std::move(merged));
+        }
+
+        friend IntervalSet operator&(const IntervalSet & lhs, const IntervalSet & rhs) {
+            const std::vector<Interval<T>> & a = lhs.m_intervals;
+            const std::vector<Interval<T>> & b = rhs.m_intervals;
+
+            // Each step writes the intersection of the two current intervals,
+            // kept if it is not empty, and leaves the one that ends first
+            std::vector<Interval<T>> result(a.size() + b.size());
+            std::size_t out = 0;
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < a.size() && j < b.size()) {
+                const Interval<T> common { std::max(a[i].min, b[j].min), std::min(a[i].max, b[j].max) };
+                result[out] = common;
+                out += common.min < common.max ? 1 : 0;
+
+                const bool a_ends_first = a[i].max < b[j].max;
+                i += a_ends_first ? 1 : 0;
+                j += a_ends_first ? 0 : 1;
+            }
+
+            result.resize(out);
+            return IntervalSet(Normalized{}, std::move(result));
+        }
+
+        friend IntervalSet operator-(const IntervalSet & lhs, const IntervalSet & rhs) {
+            const std::vector<Interval<T>> & b = rhs.m_intervals;
+
+            std::vector<Interval<T>> result;
+            result.reserve(lhs.m_intervals.size() + b.size());
+
+            std::size_t j = 0;
+            for (const Interval<T> & interval : lhs.m_intervals) {
+                T start = interval.min;
+                while (j < b.size() && b[j].max <= start) ++j;
+
+                // The last removed interval may also cut the next interval
+                for (std::size_t k = j; k < b.size() && b[k].min < interval.max; ++k) {
+                    if (start < b[k].min) result.push_back(Interval<T>{ start, b[k].min });
+                    start = std::max(start, b[k].max);
+                }
+
+                if (start < interval.max) result.push_back(Interval<T>{ start, interval.max });
+            }
+
+            return IntervalSet(Normalized{}, std::move(result));
+        }
+
+        IntervalSet & operator|=(const IntervalSet & other) { return *this = *this | other; }
+        IntervalSet & operator&=(const IntervalSet & other) { return *this = *this & other; }
+        IntervalSet & operator-=(const IntervalSet & other) { return *this = *this - other; }
+
+        [[nodiscard]] friend bool operator==(const IntervalSet &, const IntervalSet &) = default;
+    };
+
+    /**
+     * A function that adds an offset to the integers of some disjoint
+     * intervals, and leaves the other integers unchanged, like the maps of
+     * 2023/05. It maps single values and whole interval sets.
+     */
+    template<std::integral T>
+    class PiecewiseShift {
+    public:
+        struct Piece {
+            Interval<T> source;
+            T offset;
+        };
+
+    private:
+        std::vector<Piece> m_pieces;
+
+    public:
+        PiecewiseShift() = default;
+
+        /** The pieces may be in any order, but their sources must be disjoint */
+        explicit PiecewiseShift(std::vector<Piece> pieces) : m_pieces(std::move(pieces)) {
+            std::erase_if(m_pieces, [](const Piece & piece) { return piece.source.empty(); });
+            std::ranges::sort(m_pieces, {}, [](const Piece & piece) { return piece.source.min; });
+        }
+
+        [[nodiscard]] std::span<const Piece> pieces() const noexcept { return m_pieces; }
+
+        [[nodiscard]] T operator()(T value) const noexcept {
+            const auto after = std::ranges::upper_bound(m_pieces, value, {}, [](const Piece & piece) { return piece.source.min; });
+            if (after == m_pieces.begin()) return value;
+
+            const Piece & piece = *std::prev(after);
+            return piece.source.contains(value) ? value + piece.offset : value;
+        }
+
+        /** The image of the set: the values are mapped one by one */
+        [[nodiscard]] IntervalSet<T> operator()(const IntervalSet<T> & set) const {
+            std::vector<Interval<T>> image;
+            image.reserve(set.intervals().size() + m_pieces.size());
+
+            std::size_t first_piece = 0;
+            for (const Interval<T> & interval : set) {
+                T start = interval.min;
+                while (first_piece < m_pieces.size() && m_pieces[first_piece].source.max <= start) ++first_piece;
+
+                for (std::size_t k = first_piece; start < interval.max; ++k) {
+                    if (k == m_pieces.size() || m_pieces[k].source.min >= interval.max) {
+                        image.push_back(Interval<T>{ start, interval.max });
+                        break;
+                    }
+
+                    const Piece & piece = m_pieces[k];
+                    if (start < piece.source.min) {
+                        image.push_back(Interval<T>{ start, piece.source.min });
+                        start = piece.source.min;
+                    }
+
+                    const T end = std::min(piece.source.max, interval.max);
+                    image.push_back(Interval<T>{ start, end }.shifted(piece.offset));
+                    start = end;
+                }
+            }
+
+            return IntervalSet<T>(std::move(image));
+        }
+    };
+}
@@ -0,0 +1,309 @@
+#include "md5_batch.hpp"
+#include "md5.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BJ_MD5_X86 1
+#endif
+
+namespace bj::md5 {
+    namespace {
+        // Vectors of 4, 8 and 16 lanes. The operators of the vector
+        // extensions are applied lane by lane, and a scalar operand is
+        // broadcast to every lane, so the same kernel is written once for the
+        // scalar and the vector types.
+        typedef std::uint32_t Vec4  __attribute__((vector_size(16)));
+        typedef std::uint32_t Vec8  __attribute__((vector_size(32)));
+        typedef std::uint32_t Vec16 __attribute__((vector_size(64)));
+
+        constexpr std::uint32_t sines[64] = {
+            0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+            0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+            0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+            0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+            0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+            0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+            0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+            0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+        };
+
+        constexpr int shifts[4][4] = {
+            { 7, 12, 17, 22 }, { 5, 9, 14, 20 }, { 4, 11, 16, 23 }, { 6, 10, 15, 21 }
+        };
+
+        constexpr std::uint32_t initial_state[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+
+        /** Step `I` of the 64 steps of the compression function */
+        template<std::size_t I, typename V>
+        [[gnu::always_inline]] inline void step(V & a, V & b, V & c, V & d, const V * words) {
+            constexpr std::size_t round = I / 16;
+            constexpr std::size_t word = round == 0 ? I
+                                       : round == 1 ? (5 * I + 1) % 16
+                                       : round == 2 ? (3 * I + 5) % 16
+                                       :              (7 * I) % 16;
+            constexpr int shift = shifts[round][I % 4];
+
+            V f;
+            if constexpr (round == 0) {
+                f = d ^ (b & (c ^ d));
+            } else if constexpr (round == 1) {
+                f = c ^ (d & (b ^ c));
+            } else if constexpr (round == 2) {
+                f = b ^ c ^ d;
+            } else {
+                f = c ^ (b | ~d);
+            }
+
+            f = f + a + sines[I] + words[word];
+            a = d;
+            d = c;
+            c = b;
+            b = b + ((f << shift) | (f >> (32 - shift)));
+        }
+
+        template<typename V, std::size_t... I>
+        [[gnu::always_inline]] inline void steps(V & a, V & b, V & c, V & d, const V * words, std::index_sequence<I...>) {
+            (step<I>(a, b, c, d, words), ...);
+        }
+
+        /** Replaces the state with the compression of the block `words` */
+        template<typename V>
+        [[gnu::always_inline]] inline void compress(V (&state)[4], const V * words) {
+            V a = V{} + initial_state[0];
+            V b = V{} + initial_state[1];
+            V c = V{} + initial_state[2];
+            V d = V{} + initial_state[3];
+
+            steps(a, b, c, d, words, std::make_index_sequence<64>());
+
+            state[0] = a + initial_state[0];
+            state[1] = b + initial_state[1];
+            state[2] = c + initial_state[2];
+            state[3] = d + initial_state[3];
+        }
+
+        /** The 4 hex characters of the low (or high) 2 bytes of each lane */
+        template<typename V>
+        [[gnu::always_inline]] inline void hex_of_half(const V & bytes, V & hex) {
+            // Spread the 4 nibbles in 4 bytes, high nibble of each byte first
+            const V nibbles = ((bytes & 0x00F0) >> 4)
+                            | ((bytes & 0x000F) << 8)
+                            | ((bytes & 0xF000) << 4)
+                            | ((bytes & 0x0F00) << 16);
+
+            // '0' + n, plus 'a' - '0' - 10 for the nibbles above 9. n + 6
+            // does not overflow a byte, so the bytes are computed together.
+            const V above_nine = ((nibbles + 0x06060606) >> 4) & 0x01010101;
+            hex = nibbles + 0x30303030 + above_nine * 39;
+        }
+
+        /** The block of the 32 hex characters of the state */
+        template<typename V>
+        [[gnu::always_inline]] inline void hex_block(const V (&state)[4], V * words) {
+            for (std::size_t i = 0; i != 4; ++i) {
+                hex_of_half<V>(state[i] & 0xFFFF, words[i * 2]);
+                hex_of_half<V>(state[i] >> 16, words[i * 2 + 1]);
+            }
+
+            words[8] = V{} + 0x80;
+            for (std::size_t i = 9; i != 16; ++i) words[i] = V{};
+            words[14] = V{} + 32 * 8;
+        }
+
+        /**
+         * Hashes `count` messages (count <= Lanes) of at most
+         * max_single_block_size bytes, then hashes `stretches` times the hex
+         * of the digests. Lanes is 1 for the scalar type.
+         */
+        template<typename V, std::size_t Lanes>
+        [[gnu::always_inline]] inline void hash_single_blocks(
+            const std::string_view * messages, std::size_t count, std::size_t stretches, Digest * digests
+        ) {
+            // Pad each message in its own block, then transpose the blocks
+            // so that each word of the blocks is a vector of the lanes
+            alignas(64) std::uint8_t blocks[Lanes][64] = {};
+            for (std::size_t lane = 0; lane != count; ++lane) {
+                const std::string_view message = messages[lane];
+                std::memcpy(blocks[lane], message.data(), message.size());
+                blocks[lane][message.size()] = 0x80;
+                const std::uint32_t bits = static_cast<std::uint32_t>(message.size() * 8);
+                std::memcpy(blocks[lane] + 56, &bits, sizeof(bits));
+            }
+
+            alignas(64) std::uint32_t transposed[16][Lanes];
+            for (std::size_t word = 0; word != 16; ++word) {
+                for (std::size_t lane = 0; lane != Lanes; ++lane) {
+                    std::memcpy(&transposed[word][lane], blocks[lane] + word * 4, 4);
+                }
+            }
+
+            V words[16];
+            std::memcpy(words, transposed, sizeof(words));
+
+            V state[4];
+            compress(state, words);
+
+            // The chain stays in the registers
+            for (std::size_t i = 0; i != stretches; ++i) {
+                hex_block(state, words);
+                compress(state, words);
+            }
+
+            alignas(64) std::uint32_t lanes_state[4][Lanes];
+            std::memcpy(lanes_state, state, sizeof(state));
+
+            // MD5 is little endian, like the targets of this repository
+            for (std::size_t lane = 0; lane != count; ++lane) {
+                for (std::size_t i = 0; i != 4; ++i) {
+                    std::memcpy(digests[lane].data() + i * 4, &lanes_state[i][lane], 4);
+                }
+            }
+        }
+
+        /** Hashes `stretches` times the hex of the digest */
+        void stretch_scalar(Digest & digest, std::size_t stretches) {
+            std::uint32_t state[4];
+            std::memcpy(state, digest.data(), sizeof(state));
+
+            std::uint32_t words[16];
+            for (std::size_t i = 0; i != stretches; ++i) {
+                hex_block(state, words);
+                compress(state, words);
+            }
+
+            std::memcpy(digest.data(), state, sizeof(state));
+        }
+
+        using KernelFunction = void (*)(const std::string_view *, std::size_t, std::size_t, Digest *);
+
+        void hash_scalar(const std::string_view * messages, std::size_t count, std::size_t stretches, Digest * digests) {
+            hash_single_blocks<std::uint32_t, 1>(messages, count, stretches, digests);
+        }
+
+        void hash_4(const std::string_view * messages, std::size_t count, std::size_t stretches, Digest * digests) {
+            hash_single_blocks<Vec4, 4>(messages, count, stretches, digests);
+        }
+
+#ifdef BJ_MD5_X86
+        __attribute__((target("avx2")))
+        void hash_8(const std::string_view * messages, std::size_t count, std::size_t stretches, Digest * digests) {
+            hash_single_blocks<Vec8, 8>(messages, count, stretches, digests);
+        }
+
+        __attribute__((target("avx512f")))
+        void hash_16(const std::string_view * messages, std::size_t count, std::size_t stretches, Digest * digests) {
+            hash_single_blocks<Vec16, 16>(messages, count, stretches, digests);
+        }
+#endif
+
+        KernelFunction kernel_function(Kernel kernel) {
+            switch (kernel) {
+                case Kernel::Lanes4:  return &hash_4;
+#ifdef BJ_MD5_X86
+                case Kernel::Lanes8:  return &hash_8;
+                case Kernel::Lanes16: return &hash_16;
+#endif
+                default:              return &hash_scalar;
+            }
+        }
+    }
+
+    bool is_supported(Kernel kernel) {
+        switch (kernel) {
+            case Kernel::Scalar:
+            case Kernel::Lanes4:
+                return true;
+#ifdef BJ_MD5_X86
+            case Kernel::Lanes8:
+                return __builtin_cpu_supports("avx2");
+            case Kernel::Lanes16:
+                return __builtin_cpu_supports("avx512f");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    Kernel best_kernel() {
+        static const Kernel best = [] {
+            for (const Kernel kernel : { Kernel::Lanes16, Kernel::Lanes8, Kernel::Lanes4 }) {
+                if (is_supported(kernel)) return kernel;
+            }
+            return Kernel::Scalar;
+        }();
+        return best;
+    }
+
+    std::size_t lanes(Kernel kernel) {
+        switch (kernel) {
+            case Kernel::Lanes4:  return 4;
+            case Kernel::Lanes8:  return 8;
+            case Kernel::Lanes16: return 16;
+            default:              return 1;
+        }
+    }
+
+    const char * kernel_name(Kernel kernel) {
+        switch (kernel) {
+            case Kernel::Lanes4:  return "sse2";
+            case Kernel::Lanes8:  return "avx2";
+            case Kernel::Lanes16: return "avx512";
+            default:              return "scalar";
+        }
+    }
+
+    Digest digest(std::string_view message) {
+        MD5 md5;
+        md5.add(message.data(), message.size());
+
+        Digest result;
+        md5.getHash(result.data());
+        return result;
+    }
+
+    void digest_batch(std::span<const std::string_view> messages, Digest * digests, Kernel kernel) {
+        stretched_digest_batch(messages, 0, digests, kernel);
+    }
+
+    void stretched_digest_batch(
+        std::span<const std::string_view> messages, std::size_t stretches, Digest * digests, Kernel kernel
+    ) {
+        if (!is_supported(kernel)) kernel = best_kernel();
+
+        const KernelFunction function = kernel_function(kernel);
+        const std::size_t width = lanes(kernel);
+
+        // The short messages are gathered by groups of `width`, the long
+        // ones are hashed as they come
+        std::string_view group[max_lanes];
+        std::size_t positions[max_lanes];
+        Digest group_digests[max_lanes];
+        std::size_t in_group = 0;
+
+        const auto flush = [&]() {
+            function(group, in_group, stretches, group_digests);
+            for (std::size_t i = 0; i != in_group; ++i) {
+                digests[positions[i]] = group_digests[i];
+            }
+            in_group = 0;
+        };
+
+        for (std::size_t i = 0; i != messages.size(); ++i) {
+            if (messages[i].size() > max_single_block_size) {
+                digests[i] = digest(messages[i]);
+                stretch_scalar(digests[i], stretches);
+                continue;
+            }
+
+            group[in_group] = messages[i];
+            positions[in_group] = i;
+            ++in_group;
+
+            if (in_group == width) flush();
+        }
+
+        if (in_group != 0) flush();
+    }
+}
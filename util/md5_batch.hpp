@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+// MD5 of several independent messages at once, one message per lane of the
+// SIMD registers. The days that mine hashes (2015/04, 2016/05, 2016/14)
+// only look at a few nibbles of millions of digests, so the digests are
+// returned raw instead of as hex strings.
+//
+// The scalar MD5 of md5.h stays the reference implementation.
+
+namespace bj::md5 {
+    /** A raw MD5 digest: the first byte holds the first two hex characters */
+    using Digest = std::array<std::uint8_t, 16>;
+
+    /** Messages of at most this size fit in one block with their padding */
+    inline constexpr std::size_t max_single_block_size = 55;
+
+    /** The most lanes a kernel has: digest_batch callers can size their buffers with it */
+    inline constexpr std::size_t max_lanes = 16;
+
+    enum class Kernel {
+        Scalar,   // One message at a time, with the MD5 class
+        Lanes4,   // SSE2 (or the generic vector extensions of the compiler)
+        Lanes8,   // AVX2
+        Lanes16   // AVX-512F
+    };
+
+    /** The widest kernel supported by the CPU, detected at the first call */
+    [[nodiscard]] Kernel best_kernel();
+    [[nodiscard]] bool is_supported(Kernel kernel);
+    [[nodiscard]] std::size_t lanes(Kernel kernel);
+    [[nodiscard]] const char * kernel_name(Kernel kernel);
+
+    /** The number of lanes of the best kernel */
+    [[nodiscard]] inline std::size_t lanes() { return lanes(best_kernel()); }
+
+    /** The digest of one message, with the scalar implementation */
+    [[nodiscard]] Digest digest(std::string_view message);
+
+    /**
+     * Writes the digest of messages[i] in digests[i]. The messages are hashed
+     * by groups of lanes(kernel). The messages longer than
+     * max_single_block_size are hashed with the scalar implementation.
+     */
+    void digest_batch(
+        std::span<const std::string_view> messages,
+        Digest * digests,
+        Kernel kernel = best_kernel()
+    );
+
+    /**
+     * Key stretching: writes in digests[i] the digest of messages[i] hashed
+     * 1 + stretches times, each hash after the first one being the hash of
+     * the 32 lower case hex characters of the previous one. The chains are
+     * hashed in the SIMD registers, without writing the hex characters.
+     */
+    void stretched_digest_batch(
+        std::span<const std::string_view> messages,
+        std::size_t stretches,
+        Digest * digests,
+        Kernel kernel = best_kernel()
+    );
+
+    /** True if the hex representation of the digest starts with `nibbles` '0' */
+    [[nodiscard]] constexpr bool has_leading_zero_nibbles(const Digest & digest, std::size_t nibbles) noexcept {
+        std::size_t i = 0;
+        for (; i * 2 + 2 <= nibbles; ++i) {
+            if (digest[i] != 0) return false;
+        }
+
+        return nibbles % 2 == 0 || (digest[i] >> 4) == 0;
+    }
+
+    /** The value of the i-th hex character of the digest */
+    [[nodiscard]] constexpr std::uint8_t nibble(const Digest & digest, std::size_t i) noexcept {
+        const std::uint8_t byte = digest[i / 2];
+        return i % 2 == 0 ? byte >> 4 : byte & 0x0F;
+    }
+
+    /** Writes the 32 hex characters of the digest in `out` */
+    constexpr void to_hex(const Digest & digest, char * out) noexcept {
+        constexpr const char * hex = "0123456789abcdef";
+        for (std::size_t i = 0; i != digest.size(); ++i) {
+            out[i * 2]     = hex[digest[i] >> 4];
+            out[i * 2 + 1] = hex[digest[i] & 0x0F];
+        }
+    }
+
+    [[nodiscard]] inline std::string to_hex(const Digest & digest) {
+        std::string s(32, '0');
+        to_hex(digest, s.data());
+        return s;
+    }
+}
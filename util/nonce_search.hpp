@@ -0,0 +1,233 @@
+#pragma once
+
+#include "md5_batch.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Search of the nonces for which the MD5 of prefix + nonce (in decimal)
+// looks like something (2015/04, 2016/05).
+//
+// The nonces are split in chunks that are hashed by a pool of threads, and
+// the hits are given back in the order of the nonces, so the results do not
+// depend on the number of threads. The number of threads is given by the
+// harness, so the configs that run in parallel do not share the cores with
+// the threads of each other.
+
+namespace bj {
+    /** The decimal representation of a number, incremented in place */
+    class DecimalCounter {
+        std::array<char, 20> m_digits;
+        std::size_t m_size;
+
+    public:
+        explicit DecimalCounter(std::uint64_t value) {
+            const auto result = std::to_chars(m_digits.data(), m_digits.data() + m_digits.size(), value);
+            m_size = result.ptr - m_digits.data();
+        }
+
+        [[nodiscard]] const char * data() const noexcept { return m_digits.data(); }
+        [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+        void increment() noexcept {
+            for (std::size_t i = m_size; i != 0; --i) {
+                if (m_digits[i - 1] != '9') {
+                    ++m_digits[i - 1];
+                    return;
+                }
+                m_digits[i - 1] = '0';
+            }
+
+            // 99...9 + 1 = 100...0
+            m_digits[0] = '1';
+            m_digits[m_size] = '0';
+            ++m_size;
+        }
+    };
+
+    struct NonceSearchOptions {
+        std::uint64_t first_nonce = 0;
+        /** Number of nonces hashed by a thread before it looks for more work */
+        std::uint64_t chunk_size = 1 << 14;
+        /** Threads that hash, 1 to hash on the calling thread. The days give DayExtraInfo::threads */
+        unsigned int threads = 1;
+        /** The search stops when it is requested, like the timeout of the harness */
+        std::stop_token stop_token = {};
+    };
+
+    namespace nonce_search_details {
+        struct Hit {
+            std::uint64_t nonce;
+            md5::Digest digest;
+        };
+
+        /** The buffers of a thread: one message per lane, whose prefix is written once */
+        class ChunkHasher {
+            std::size_t m_prefix_size;
+            std::size_t m_lanes;
+            std::size_t m_stride;
+            std::vector<char> m_messages;
+            std::vector<std::string_view> m_views;
+            std::vector<md5::Digest> m_digests;
+
+        public:
+            explicit ChunkHasher(std::string_view prefix)
+            : m_prefix_size(prefix.size()), m_lanes(md5::lanes()), m_stride(prefix.size() + 20),
+              m_messages(m_lanes * m_stride), m_views(m_lanes), m_digests(m_lanes) {
+                for (std::size_t lane = 0; lane != m_lanes; ++lane) {
+                    std::memcpy(m_messages.data() + lane * m_stride, prefix.data(), prefix.size());
+                }
+            }
+
+            template<typename IsHit>
+            void hash(std::uint64_t first, std::uint64_t size, const IsHit & is_hit, std::vector<Hit> & hits) {
+                DecimalCounter counter(first);
+
+                for (std::uint64_t done = 0; done < size; done += m_lanes) {
+                    const std::size_t in_batch = static_cast<std::size_t>(std::min<std::uint64_t>(m_lanes, size - done));
+
+                    for (std::size_t lane = 0; lane != in_batch; ++lane) {
+                        char * message = m_messages.data() + lane * m_stride;
+                        std::memcpy(message + m_prefix_size, counter.data(), counter.size());
+                        m_views[lane] = std::string_view(message, m_prefix_size + counter.size());
+                        counter.increment();
+                    }
+
+                    md5::digest_batch(std::span(m_views.data(), in_batch), m_digests.data());
+
+                    for (std::size_t lane = 0; lane != in_batch; ++lane) {
+                        if (is_hit(m_digests[lane])) {
+                            hits.push_back(Hit{ first + done + lane, m_digests[lane] });
+                        }
+                    }
+                }
+            }
+        };
+    }
+
+    /**
+     * Hashes prefix + nonce for every nonce from options.first_nonce, and
+     * calls on_hit(nonce, digest) for the digests for which is_hit(digest) is
+     * true, in the order of the nonces, until on_hit returns false.
+     *
+     * is_hit is called by the threads of the pool, on_hit by the calling
+     * thread. Returns false if the search was stopped by the stop token.
+     */
+    template<typename IsHit, typename OnHit>
+    bool search_nonces(std::string_view prefix, IsHit is_hit, OnHit on_hit, NonceSearchOptions options = {}) {
+        using nonce_search_details::Hit;
+
+        // On the calling thread, so it is seen by the counters and the
+        // allocation tracker of the harness
+        if (options.threads <= 1) {
+            nonce_search_details::ChunkHasher hasher(prefix);
+            std::vector<Hit> hits;
+
+            for (std::uint64_t chunk = 0; ; ++chunk) {
+                if (options.stop_token.stop_requested()) return false;
+
+                hits.clear();
+                hasher.hash(options.first_nonce + chunk * options.chunk_size, options.chunk_size, is_hit, hits);
+
+                for (const Hit & hit : hits) {
+                    if (!on_hit(hit.nonce, hit.digest)) return true;
+                }
+            }
+        }
+
+        const unsigned int threads = options.threads;
+        // The threads do not run too far ahead of the chunk that is given back
+        const std::uint64_t window = threads * 4;
+
+        std::mutex mutex;
+        std::condition_variable_any changed;
+        std::map<std::uint64_t, std::vector<Hit>> finished_chunks;
+        std::uint64_t next_chunk = 0;
+        std::uint64_t delivered_chunks = 0;
+        bool stop = false;
+
+        const auto work = [&]() {
+            nonce_search_details::ChunkHasher hasher(prefix);
+            std::unique_lock lock(mutex);
+
+            while (true) {
+                changed.wait(lock, [&]() { return stop || next_chunk < delivered_chunks + window; });
+                if (stop) return;
+
+                const std::uint64_t chunk = next_chunk++;
+                lock.unlock();
+
+                std::vector<Hit> hits;
+                hasher.hash(options.first_nonce + chunk * options.chunk_size, options.chunk_size, is_hit, hits);
+
+                lock.lock();
+                finished_chunks.emplace(chunk, std::move(hits));
+                changed.notify_all();
+            }
+        };
+
+        const auto stop_workers = [&]() {
+            {
+                std::lock_guard lock(mutex);
+                stop = true;
+            }
+            changed.notify_all();
+        };
+
+        // Declared last to be joined before the state they use is destroyed
+        std::vector<std::jthread> workers;
+        for (unsigned int i = 0; i != threads; ++i) {
+            workers.emplace_back(work);
+        }
+
+        bool completed = true;
+
+        try {
+            bool searching = true;
+            while (searching) {
+                std::vector<Hit> hits;
+
+                {
+                    std::unique_lock lock(mutex);
+                    const bool has_chunk = changed.wait(lock, options.stop_token, [&]() {
+                        return finished_chunks.contains(delivered_chunks);
+                    });
+
+                    if (!has_chunk) {
+                        completed = false;
+                        break;
+                    }
+
+                    const auto it = finished_chunks.find(delivered_chunks);
+                    hits = std::move(it->second);
+                    finished_chunks.erase(it);
+                    ++delivered_chunks;
+                }
+
+                changed.notify_all();
+
+                for (const Hit & hit : hits) {
+                    if (!on_hit(hit.nonce, hit.digest)) {
+                        searching = false;
+                        break;
+                    }
+                }
+            }
+        } catch (...) {
+            stop_workers();
+            throw;
+        }
+
+        stop_workers();
+        return completed;
+    }
+}
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Line patterns checked at compile time, that replace the std::regex of the
+// input parsing, like
+//
+//     bj::Pattern<"{turn on|turn off|toggle} {int},{int} through {int},{int}">::match(line)
+//
+// that returns a std::optional<std::tuple<int, int, int, int, int>>.
+//
+// The pattern is made of literal text and of captures:
+// - {int}: a decimal int, with an optional sign. {i64} for a std::int64_t.
+// - {digits}: a decimal int written without a sign, like the [0-9]+ of a
+//   regex.
+// - {char}: any character.
+// - {word}: a non empty run of letters, digits and _, as a std::string_view.
+// - {str}: the shortest text after which the rest of the line matches, as a
+//   std::string_view. It has to be followed by literal text or by the end.
+// - {a|b|c}: one of the alternatives, as the int index of the first one that
+//   matches.
+// {{ and }} are the { and } of the line.
+//
+// The whole line has to match. No capture allocates: the strings are views
+// of the line.
+
+namespace bj {
+    /** A string literal that can be used as a template parameter */
+    template<std::size_t N>
+    struct FixedString {
+        char chars[N] {};
+
+        constexpr FixedString(const char (&str)[N]) {
+            std::copy_n(str, N, chars);
+        }
+
+        [[nodiscard]] constexpr std::string_view view() const noexcept {
+            return std::string_view(chars, N - 1);
+        }
+    };
+
+    namespace pattern_details {
+        enum class Kind { Int, Int64, Digits, Char, Word, String, Choice, End };
+
+        /** The literal text before a capture, and the capture */
+        struct Token {
+            std::size_t literal_begin = 0;
+            std::size_t literal_size = 0;
+            Kind kind = Kind::End;
+            std::string_view choices;
+        };
+
+        [[nodiscard]] constexpr Kind kind_of(std::string_view capture) {
+            if (capture == "int")  return Kind::Int;
+            if (capture == "i64")  return Kind::Int64;
+            if (capture == "digits") return Kind::Digits;
+            if (capture == "char") return Kind::Char;
+            if (capture == "word") return Kind::Word;
+            if (capture == "str")  return Kind::String;
+            if (capture.find('|') != std::string_view::npos) return Kind::Choice;
+            throw std::invalid_argument("Unknown capture in the pattern");
+        }
+
+        [[nodiscard]] constexpr std::size_t count_captures(std::string_view pattern) {
+            std::size_t captures = 0;
+            for (std::size_t i = 0; i != pattern.size(); ++i) {
+                if (pattern[i] != '{') continue;
+
+                if (i + 1 != pattern.size() && pattern[i + 1] == '{') {
+                    ++i;
+                } else {
+                    ++captures;
+                }
+            }
+            return captures;
+        }
+
+        /**
+         * The tokens of the pattern, the last one being the End with the
+         * literal text at the end. The literal texts are stored in `text`,
+         * where the {{ and }} are written { and }.
+         */
+        template<std::size_t Size, std::size_t Captures>
+        struct Parsed {
+            std::array<char, Size> text {};
+            std::array<Token, Captures + 1> tokens {};
+        };
+
+        template<std::size_t Size, std::size_t Captures>
+        [[nodiscard]] constexpr Parsed<Size, Captures> tokenize(std::string_view pattern) {
+            Parsed<Size, Captures> parsed;
+            std::size_t text_size = 0;
+            std::size_t token = 0;
+            parsed.tokens[0].literal_begin = 0;
+
+            std::size_t i = 0;
+            while (i != pattern.size()) {
+                const char c = pattern[i];
+                const bool doubled = i + 1 != pattern.size() && pattern[i + 1] == c;
+
+                if ((c == '{' || c == '}') && doubled) {
+                    parsed.text[text_size++] = c;
+                    i += 2;
+                } else if (c == '}') {
+                    throw std::invalid_argument("} out of a capture in the pattern, write }} for a }");
+                } else if (c == '{') {
+                    const std::size_t close = pattern.find('}', i);
+                    if (close == std::string_view::npos) throw std::invalid_argument("Unclosed capture in the pattern");
+
+                    const std::string_view capture = pattern.substr(i + 1, close - i - 1);
+                    Token & current = parsed.tokens[token];
+                    current.literal_size = text_size - current.literal_begin;
+                    current.kind = kind_of(capture);
+                    if (current.kind == Kind::Choice) current.choices = capture;
+
+                    ++token;
+                    parsed.tokens[token].literal_begin = text_size;
+                    i = close + 1;
+                } else {
+                    parsed.text[text_size++] = c;
+                    ++i;
+                }
+            }
+
+            parsed.tokens[Captures].literal_size = text_size - parsed.tokens[Captures].literal_begin;
+            parsed.tokens[Captures].kind = Kind::End;
+
+            for (std::size_t t = 0; t != Captures; ++t) {
+                if (parsed.tokens[t].kind == Kind::String
+                    && parsed.tokens[t + 1].kind != Kind::End
+                    && parsed.tokens[t + 1].literal_size == 0) {
+                    throw std::invalid_argument("{str} has to be followed by literal text");
+                }
+            }
+
+            return parsed;
+        }
+
+        template<Kind kind> struct capture_type;
+        template<> struct capture_type<Kind::Int>    { using type = int; };
+        template<> struct capture_type<Kind::Int64>  { using type = std::int64_t; };
+        template<> struct capture_type<Kind::Digits> { using type = int; };
+        template<> struct capture_type<Kind::Char>   { using type = char; };
+        template<> struct capture_type<Kind::Word>   { using type = std::string_view; };
+        template<> struct capture_type<Kind::String> { using type = std::string_view; };
+        template<> struct capture_type<Kind::Choice> { using type = int; };
+
+        [[nodiscard]] constexpr bool is_word_character(char c) noexcept {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        }
+
+        template<bool allow_sign, typename Integer>
+        [[nodiscard]] constexpr bool read_integer(std::string_view line, std::size_t & position, Integer & value) noexcept {
+            bool negative = false;
+            if (allow_sign && position != line.size() && (line[position] == '-' || line[position] == '+')) {
+                negative = line[position] == '-';
+                ++position;
+            }
+
+            using Unsigned = std::make_unsigned_t<Integer>;
+            Unsigned absolute = 0;
+            const std::size_t first_digit = position;
+            while (position != line.size() && line[position] >= '0' && line[position] <= '9') {
+                absolute = absolute * 10 + static_cast<Unsigned>(line[position] - '0');
+                ++position;
+            }
+
+            value = static_cast<Integer>(negative ? Unsigned(0) - absolute : absolute);
+            return position != first_digit;
+        }
+
+        /** The alternatives of a {a|b|c} capture */
+        template<std::size_t Count>
+        [[nodiscard]] constexpr std::array<std::string_view, Count> split_choices(std::string_view choices) {
+            std::array<std::string_view, Count> result;
+            for (std::size_t i = 0; i != Count; ++i) {
+                const std::size_t bar = std::min(choices.find('|'), choices.size());
+                result[i] = choices.substr(0, bar);
+                choices.remove_prefix(std::min(bar + 1, choices.size()));
+            }
+            return result;
+        }
+    }
+
+    template<FixedString Text>
+    class Pattern {
+        using Kind = pattern_details::Kind;
+
+        static constexpr std::size_t captures = pattern_details::count_captures(Text.view());
+        static constexpr auto parsed = pattern_details::tokenize<Text.view().size() + 1, captures>(Text.view());
+        static constexpr auto & tokens = parsed.tokens;
+
+        /** The literal text before the capture I */
+        template<std::size_t I>
+        static constexpr std::string_view literal = std::string_view(
+            parsed.text.data() + tokens[I].literal_begin, tokens[I].literal_size
+        );
+
+        template<std::size_t I>
+        using capture_t = typename pattern_details::capture_type<tokens[I].kind>::type;
+
+        template<std::size_t... I>
+        static auto make_captures(std::index_sequence<I...>) -> std::tuple<capture_t<I>...>;
+
+    public:
+        /** The tuple of the typed captures */
+        using Captures = decltype(make_captures(std::make_index_sequence<captures>()));
+
+        /** Writes the captures if the line matches the pattern */
+        [[nodiscard]] static constexpr bool match_into(std::string_view line, Captures & values) noexcept {
+            std::size_t position = 0;
+            return match_from<0>(line, position, values);
+        }
+
+        [[nodiscard]] static constexpr std::optional<Captures> match(std::string_view line) noexcept {
+            Captures values {};
+            if (!match_into(line, values)) return std::nullopt;
+            return values;
+        }
+
+        /** Builds a T from the captures of the line, with T(captures...) */
+        template<typename T>
+        [[nodiscard]] static std::optional<T> parse(std::string_view line) {
+            Captures values {};
+            if (!match_into(line, values)) return std::nullopt;
+            return std::make_from_tuple<T>(std::move(values));
+        }
+
+    private:
+        template<std::size_t I>
+        static constexpr bool match_from(std::string_view line, std::size_t & position, Captures & values) noexcept {
+            constexpr pattern_details::Token token = tokens[I];
+
+            if (line.substr(position, literal<I>.size()) != literal<I>) return false;
+            position += literal<I>.size();
+
+            if constexpr (token.kind == Kind::End) {
+                return position == line.size();
+            } else if constexpr (token.kind == Kind::String) {
+                // The shortest text after which the rest of the line matches
+                constexpr std::string_view next = literal<I + 1>;
+                std::size_t end = position;
+
+                while (true) {
+                    end = next.empty() ? line.size() : line.find(next, end);
+                    if (end == std::string_view::npos) return false;
+
+                    std::get<I>(values) = line.substr(position, end - position);
+                    std::size_t rest = end;
+                    if (match_from<I + 1>(line, rest, values)) {
+                        position = rest;
+                        return true;
+                    }
+
+                    if (next.empty()) return false;
+                    ++end;
+                }
+            } else {
+                if (!read_capture<I>(line, position, std::get<I>(values))) return false;
+                return match_from<I + 1>(line, position, values);
+            }
+        }
+
+        template<std::size_t I>
+        static constexpr bool read_capture(std::string_view line, std::size_t & position, capture_t<I> & value) noexcept {
+            constexpr pattern_details::Token token = tokens[I];
+
+            if constexpr (token.kind == Kind::Int || token.kind == Kind::Int64) {
+                return pattern_details::read_integer<true>(line, position, value);
+            } else if constexpr (token.kind == Kind::Digits) {
+                return pattern_details::read_integer<false>(line, position, value);
+            } else if constexpr (token.kind == Kind::Char) {
+                if (position == line.size()) return false;
+                value = line[position++];
+                return true;
+            } else if constexpr (token.kind == Kind::Word) {
+                const std::size_t first = position;
+                while (position != line.size() && pattern_details::is_word_character(line[position])) ++position;
+                value = line.substr(first, position - first);
+                return position != first;
+            } else {
+                constexpr std::size_t count = static_cast<std::size_t>(std::count(token.choices.begin(), token.choices.end(), '|')) + 1;
+                constexpr auto choices = pattern_details::split_choices<count>(token.choices);
+
+                for (std::size_t i = 0; i != count; ++i) {
+                    if (line.substr(position, choices[i].size()) == choices[i]) {
+                        position += choices[i].size();
+                        value = static_cast<int>(i);
+                        return true;
+                    }
+                }
+                return false;
+            }
+        }
+    };
+
+    /**
+     * Builds a T from each line with T::Line_Pattern, a bj::FixedString.
+     * Throws std::invalid_argument on the first line that does not match.
+     */
+    template<typename T>
+    std::vector<T> lines_to_class(std::span<const std::string> lines) {
+        std::vector<T> result;
+        result.reserve(lines.size());
+
+        for (const std::string & line : lines) {
+            std::optional<T> element = Pattern<T::Line_Pattern>::template parse<T>(line);
+            if (!element) throw std::invalid_argument("Bad input: " + line);
+            result.emplace_back(std::move(*element));
+        }
+
+        return result;
+    }
+}